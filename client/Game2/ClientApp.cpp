@@ -34,11 +34,13 @@
 #include "../../engine/Player/LocalPlayer.h"
 #include "../../engine/Player/LocalProfile.h"
 #include "../../engine/Player/ProfileGallery.h"
+#include "../../engine/Script/HandlerStats.h"
 #include "../../engine/Util/Config.h"
 #include "../../engine/Util/Loader.h"
 #include "../../engine/Util/Locale.h"
 #include "../../engine/Util/Profiler.h"
 #include "../../engine/Util/Str.h"
+#include "../../engine/Util/Tracer.h"
 #include "../../engine/VideoServices/VideoBuffer.h"
 
 #include "HoverScript/ClientScriptCore.h"
@@ -143,7 +145,9 @@ ClientApp::ClientApp() :
 	rootProfiler(std::make_shared<Profiler>("ROOT")),
 	advanceProfiler(rootProfiler->AddSub("advance")),
 	prepareProfiler(rootProfiler->AddSub("prepare")),
-	renderProfiler(rootProfiler->AddSub("render"))
+	renderProfiler(rootProfiler->AddSub("render")),
+	presentProfiler(rootProfiler->AddSub("present")),
+	lapFrameCount(0), dynamicRes()
 {
 	auto cfg = Config::GetInstance();
 
@@ -293,6 +297,7 @@ void ClientApp::IncFrameCount()
 	if (lastTimestamp == 0) lastTimestamp = OS::Time();
 
 	++frameCount;
+	++lapFrameCount;
 	OS::timestamp_t curTimestamp = OS::Time();
 	OS::timestamp_t diff = OS::TimeDiff(curTimestamp, lastTimestamp);
 
@@ -308,9 +313,21 @@ void ClientApp::IncFrameCount()
 	}
 }
 
+/**
+ * Wait for the background work of all scenes.
+ * @see Scene::Sync()
+ */
+void ClientApp::SyncScenes()
+{
+	for (const auto &scene : sceneStack) {
+		scene->Sync();
+	}
+}
+
 void ClientApp::AdvanceScenes(Util::OS::timestamp_t tick)
 {
 	Profiler::Sampler sampler(*advanceProfiler);
+	HR_TRACE_ZONE("advance");
 
 	auto iter = sceneStack.begin();
 	while (iter != sceneStack.end()) {
@@ -338,6 +355,7 @@ void ClientApp::AdvanceScenes(Util::OS::timestamp_t tick)
 void ClientApp::PrepareScenes()
 {
 	Profiler::Sampler sampler(*prepareProfiler);
+	HR_TRACE_ZONE("prepare");
 
 	for (const auto &scene : sceneStack) {
 		scene->PrepareScene();
@@ -350,6 +368,7 @@ void ClientApp::PrepareScenes()
 void ClientApp::RenderScenes()
 {
 	Profiler::Sampler sampler(*renderProfiler);
+	HR_TRACE_ZONE("render");
 
 	for (const auto &scene : sceneStack) {
 		Scene::Phase phase = scene->GetPhase();
@@ -377,9 +396,26 @@ void ClientApp::RenderFrame()
 		RenderScenes();
 	}
 
+	Profiler::Sampler sampler(*presentProfiler);
+	HR_TRACE_ZONE("flip");
 	display->Flip();
 }
 
+/**
+ * Pick the render scale of the legacy display from the last render lap.
+ * Must be called right after the profilers have been lapped (if dynamic
+ * resolution is disabled, this just resets the scale).
+ */
+void ClientApp::UpdateRenderScale()
+{
+	if (lapFrameCount > 0) {
+		double scale = dynamicRes.Update(
+			renderProfiler->GetLastLap().time / lapFrameCount);
+		display->GetLegacyDisplay().SetRenderScale(scale);
+	}
+	lapFrameCount = 0;
+}
+
 ClientApp::ExitMode ClientApp::MainLoop()
 {
 	bool quit = false;
@@ -390,6 +426,7 @@ ClientApp::ExitMode ClientApp::MainLoop()
 	debugScene.reset(new DebugScene(*display, *this));
 
 	const auto &runtimeCfg = Config::GetInstance()->runtime;
+	const auto &vidCfg = Config::GetInstance()->video;
 	needsDevWarning =
 		!runtimeCfg.skipStartupWarning &&
 		runtimeCfg.initScripts.empty();
@@ -399,11 +436,27 @@ ClientApp::ExitMode ClientApp::MainLoop()
 	// Fire all on_init handlers.
 	gamePeer->OnInit();
 
+	Tracer::SetThreadName("main");
+
 	while (!quit) {
+		// The previous frame is complete, including the root profiler.
+		if (showDebug) debugScene->SampleFrame();
+
+		Tracer::SetEnabled(runtimeCfg.tracing);
+		AllocTracker::SetEnabled(runtimeCfg.allocTracking);
+		Script::HandlerStats::SetEnabled(runtimeCfg.handlerProfiling);
+		Script::HandlerStats::CountFrame();
+
 		Profiler::Sampler sampler(*rootProfiler);
+		HR_TRACE_ZONE("frame");
 
 		OS::timestamp_t tick = OS::Time();
 
+		{
+			HR_TRACE_ZONE("sync");
+			SyncScenes();
+		}
+
 		while (SDL_PollEvent(&evt) && !quit) {
 			if (evt.type >= SDL_KEYDOWN && evt.type <= SDL_MULTIGESTURE) {
 				// Input events are routed to the InputEventController.
@@ -464,13 +517,35 @@ ClientApp::ExitMode ClientApp::MainLoop()
 		AdvanceScenes(tick);
 		RenderFrame();
 
+		if (frameCount == 0) {
+			// Laps are only needed for the logs and the dynamic resolution;
+			// otherwise, let the profilers accumulate for the whole run.
+			if (runtimeCfg.profiling || vidCfg.dynamicRes) {
+				// Lap the workers first, while the frame time is still there
+				// to compare against.
+				for (const auto &worker : workerProfilers) {
+					worker->Lap(rootProfiler.get());
+				}
+				rootProfiler->Lap();
+			}
+			UpdateRenderScale();
+		}
 		if (runtimeCfg.profiling && frameCount == 0) {
-			rootProfiler->Lap();
 			HR_LOG(info) << rootProfiler->GetName() << "  " << rootProfiler->GetLastLap();
 			HR_LOG(info) << "  " << advanceProfiler->GetName() << "  " << advanceProfiler->GetLastLap();
+			for (const auto &sub : advanceSubProfilers) {
+				HR_LOG(info) << "    " << sub->GetName() << "  " << sub->GetLastLap();
+			}
 			HR_LOG(info) << "  " << prepareProfiler->GetName() << "  " << prepareProfiler->GetLastLap();
 			HR_LOG(info) << "  " << renderProfiler->GetName() << "  " << renderProfiler->GetLastLap();
+			for (const auto &sub : renderSubProfilers) {
+				HR_LOG(info) << "    " << sub->GetName() << "  " << sub->GetLastLap();
+			}
+			HR_LOG(info) << "  " << presentProfiler->GetName() << "  " << presentProfiler->GetLastLap();
 			HR_LOG(info) << "  other  " << rootProfiler->GetOtherTime();
+			for (const auto &worker : workerProfilers) {
+				HR_LOG(info) << "worker " << worker->GetName() << "  " << worker->GetLastLap();
+			}
 		}
 	}
 
@@ -482,8 +557,18 @@ ClientApp::ExitMode ClientApp::MainLoop()
 	if (runtimeCfg.profiling) {
 		HR_LOG(info) << "" << *rootProfiler;
 		HR_LOG(info) << "  " << *advanceProfiler;
+		for (const auto &sub : advanceSubProfilers) {
+			HR_LOG(info) << "    " << *sub;
+		}
 		HR_LOG(info) << "  " << *prepareProfiler;
 		HR_LOG(info) << "  " << *renderProfiler;
+		for (const auto &sub : renderSubProfilers) {
+			HR_LOG(info) << "    " << *sub;
+		}
+		HR_LOG(info) << "  " << *presentProfiler;
+		for (const auto &worker : workerProfilers) {
+			HR_LOG(info) << "worker " << *worker;
+		}
 	}
 
 	return retv;
@@ -811,5 +896,38 @@ std::shared_ptr<Player::Player> ClientApp::ShareUiPilot() const
 	return party->ShareFirst();
 }
 
+std::shared_ptr<Util::Profiler> ClientApp::ShareRenderProfiler(
+	const std::string &name)
+{
+	for (const auto &sub : renderSubProfilers) {
+		if (sub->GetName() == name) return sub;
+	}
+
+	renderSubProfilers.emplace_back(renderProfiler->AddSub(name));
+	return renderSubProfilers.back();
+}
+
+std::shared_ptr<Util::Profiler> ClientApp::ShareAdvanceProfiler(
+	const std::string &name)
+{
+	for (const auto &sub : advanceSubProfilers) {
+		if (sub->GetName() == name) return sub;
+	}
+
+	advanceSubProfilers.emplace_back(advanceProfiler->AddSub(name));
+	return advanceSubProfilers.back();
+}
+
+std::shared_ptr<Util::Profiler> ClientApp::ShareWorkerProfiler(
+	const std::string &name)
+{
+	for (const auto &worker : workerProfilers) {
+		if (worker->GetName() == name) return worker;
+	}
+
+	workerProfilers.emplace_back(std::make_shared<Profiler>(name));
+	return workerProfilers.back();
+}
+
 }  // namespace HoverScript
 }  // namespace Client
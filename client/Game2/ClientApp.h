@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../../engine/Util/OS.h"
+#include "../../engine/VideoServices/DynamicResolution.h"
 
 #include "Observer.h"
 
@@ -88,10 +89,12 @@ private:
 	std::string GetWindowTitle();
 	void OnWindowResize(int w, int h);
 	void IncFrameCount();
+	void SyncScenes();
 	void AdvanceScenes(Util::OS::timestamp_t tick);
 	void PrepareScenes();
 	void RenderScenes();
 	void RenderFrame();
+	void UpdateRenderScale();
 
 public:
 	enum class ExitMode
@@ -137,6 +140,13 @@ public:
 	std::shared_ptr<Player::AvatarGallery> ShareAvatarGallery() const override { return avatarGallery; }
 	Roster *GetParty() const override { return party.get(); }
 	std::shared_ptr<Player::Player> ShareUiPilot() const override;
+	std::shared_ptr<Util::Profiler> ShareRenderProfiler(
+		const std::string &name) override;
+	std::shared_ptr<Util::Profiler> ShareAdvanceProfiler(
+		const std::string &name) override;
+	std::shared_ptr<Util::Profiler> ShareWorkerProfiler(
+		const std::string &name) override;
+	std::shared_ptr<Util::Profiler> ShareRootProfiler() override { return rootProfiler; }
 	sessionChangedSignal_t &GetSessionChangedSignal() override { return sessionChangedSignal; }
 
 private:
@@ -183,6 +193,12 @@ private:
 	std::shared_ptr<Util::Profiler> advanceProfiler;
 	std::shared_ptr<Util::Profiler> prepareProfiler;
 	std::shared_ptr<Util::Profiler> renderProfiler;
+	std::shared_ptr<Util::Profiler> presentProfiler;
+	std::vector<std::shared_ptr<Util::Profiler>> advanceSubProfilers;
+	std::vector<std::shared_ptr<Util::Profiler>> renderSubProfilers;
+	std::vector<std::shared_ptr<Util::Profiler>> workerProfilers;
+	unsigned int lapFrameCount;  ///< Frames rendered since the last lap.
+	VideoServices::DynamicResolution dynamicRes;
 };
 
 }  // namespace HoverScript
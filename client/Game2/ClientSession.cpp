@@ -22,6 +22,7 @@
 
 #include <boost/thread/locks.hpp>
 
+#include "../../engine/Exception.h"
 #include "../../engine/MainCharacter/MainCharacter.h"
 #include "../../engine/Model/Level.h"
 #include "../../engine/Model/Track.h"
@@ -29,12 +30,14 @@
 #include "../../engine/Player/Player.h"
 #include "../../engine/VideoServices/VideoBuffer.h"
 #include "../../engine/Util/Clock.h"
+#include "../../engine/Util/Config.h"
 #include "../../engine/Util/Duration.h"
 #include "../../engine/Util/Log.h"
 
 #include "HoverScript/MetaSession.h"
 #include "HoverScript/TrackPeer.h"
 #include "Rules.h"
+#include "SessionTelemetry.h"
 
 #include "ClientSession.h"
 
@@ -71,7 +74,7 @@ MainCharacter::MainCharacter *GetMainChar(Player::Player *player)
 }  // namespace
 
 ClientSession::ClientSession(std::shared_ptr<Rules> rules) :
-	phase(Phase::INIT),
+	phase(Phase::INIT), deferEvents(false),
 	mSession(true),
 	mBackImage(nullptr),
 	clock(std::make_shared<Util::Clock>()),
@@ -81,6 +84,10 @@ ClientSession::ClientSession(std::shared_ptr<Rules> rules) :
 
 ClientSession::~ClientSession()
 {
+	if (telemetry) {
+		telemetry->Summarize();
+	}
+
 	for (auto &player : players) {
 		if (player) {
 			player->DetachMainCharacter();
@@ -119,15 +126,12 @@ bool ClientSession::AdvancePhase(Phase nextPhase)
 			}
 
 			phase = NextPhase(phase);
-			switch (phase) {
-				case Phase::PREGAME: meta->OnPregame(); break;
-				case Phase::PLAYING: meta->OnPlaying(); break;
-				case Phase::POSTGAME: meta->OnPostgame(); break;
-				case Phase::DONE: meta->OnDone(); break;
-				default:
-					HR_LOG(warning) <<
-						"No MetaSession event for phase:" <<
-							static_cast<int>(phase);
+			if (deferEvents) {
+				const Phase newPhase = phase;
+				deferredEvents.emplace_back([=]{ FirePhaseEvent(newPhase); });
+			}
+			else {
+				FirePhaseEvent(phase);
 			}
 		} while (phase < nextPhase);
 		return true;
@@ -138,6 +142,24 @@ bool ClientSession::AdvancePhase(Phase nextPhase)
 	return false;
 }
 
+/**
+ * Notify the MetaSession that a phase has started.
+ * @param phase The new phase.
+ */
+void ClientSession::FirePhaseEvent(Phase phase)
+{
+	switch (phase) {
+		case Phase::PREGAME: meta->OnPregame(); break;
+		case Phase::PLAYING: meta->OnPlaying(); break;
+		case Phase::POSTGAME: meta->OnPostgame(); break;
+		case Phase::DONE: meta->OnDone(); break;
+		default:
+			HR_LOG(warning) <<
+				"No MetaSession event for phase:" <<
+					static_cast<int>(phase);
+	}
+}
+
 void ClientSession::SetMeta(std::shared_ptr<HoverScript::MetaSession> meta)
 {
 	this->meta = std::move(meta);
@@ -161,7 +183,69 @@ void ClientSession::Process()
 	}
 
 	UpdateCharacterSimulationTimes();
+
+	const auto &vidCfg = Config::GetInstance()->video;
+	mSession.SetFixedSlice(vidCfg.motionInterpolation ?
+		vidCfg.simulationSlice : 0);
 	mSession.Simulate();
+
+	if (telemetry) {
+		SessionTelemetry::Frame frame;
+		frame.slices = mSession.GetSliceCount();
+		frame.lateElements = mSession.GetLateElementCount();
+		frame.netQueueDepth = GetNetQueueDepth();
+		telemetry->AddFrame(frame);
+	}
+}
+
+/**
+ * Queue the phase and player events instead of firing them.
+ *
+ * The event handlers call into scripts and the HUD, which may only be used
+ * from the main thread, so this must be enabled while Process() runs on
+ * another thread.  The queued events are fired by FireDeferredEvents().
+ *
+ * @param defer @c true to queue events, @c false to fire them immediately.
+ */
+void ClientSession::SetDeferEvents(bool defer)
+{
+	deferEvents = defer;
+	for (auto &player : players) {
+		if (!player) continue;
+		if (auto mchar = player->GetMainCharacter()) {
+			mchar->SetSignalQueue(defer ? &deferredEvents : nullptr);
+		}
+	}
+}
+
+/**
+ * Fire the events that were queued while events were deferred,
+ * in the order they happened.
+ * @see SetDeferEvents()
+ */
+void ClientSession::FireDeferredEvents()
+{
+	auto events = std::move(deferredEvents);
+	deferredEvents.clear();
+	for (auto &fn : events) {
+		fn();
+	}
+}
+
+/**
+ * Save the state of the elements to be drawn for this frame
+ * (see GetRenderSnapshot()).
+ * This must not be called while Process() is running.
+ * @param interpolate Draw the elements where they are at the current time,
+ *                    between the last two simulated slices, instead of
+ *                    where the last slice left them.
+ */
+void ClientSession::SaveRenderState(bool interpolate)
+{
+	if (const Model::Level *level = mSession.GetCurrentLevel()) {
+		renderSnapshot.Capture(*level,
+			interpolate ? mSession.GetInterpolationAlpha() : 1.0);
+	}
 }
 
 void ClientSession::ReadLevelAttrib(Parcel::RecordFile *pRecordFile,
@@ -203,6 +287,15 @@ bool ClientSession::LoadNew(const char *pTitle, Script::Core &scripting,
 	if (retv) {
 		ReadLevelAttrib(track->GetRecordFile(), pVideo);
 		trackPeer = std::make_shared<HoverScript::TrackPeer>(scripting, track);
+
+		if (Config::GetInstance()->misc.sessionTelemetry) {
+			try {
+				telemetry.reset(new SessionTelemetry(pTitle));
+			}
+			catch (Exception &ex) {
+				HR_LOG(error) << "Session telemetry disabled: " << ex.what();
+			}
+		}
 	}
 
 	return retv;
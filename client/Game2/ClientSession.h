@@ -23,6 +23,7 @@
 #pragma once
 
 #include "../../engine/Model/GameSession.h"
+#include "../../engine/Model/RenderSnapshot.h"
 #include "../../engine/VideoServices/Sprite.h"
 #include "../../engine/Util/OS.h"
 
@@ -33,6 +34,7 @@ namespace HoverRace {
 			class TrackPeer;
 		}
 		class Rules;
+		class SessionTelemetry;
 	}
 	namespace MainCharacter {
 		class MainCharacter;
@@ -92,6 +94,10 @@ public:
 
 	// Simulation control
 	virtual void Process();
+	void SetDeferEvents(bool defer);
+	void FireDeferredEvents();
+	void SaveRenderState(bool interpolate);
+	const Model::RenderSnapshot &GetRenderSnapshot() const { return renderSnapshot; }
 
 	virtual bool LoadNew(const char *pTitle, Script::Core &scripting,
 		std::shared_ptr<Model::Track> track,
@@ -132,18 +138,30 @@ public:
 	void AddMessage(const char *pMessage);
 
 	const Model::Level *GetCurrentLevel() const;
+
+	/**
+	 * Retrieve the number of outgoing network messages waiting to be sent.
+	 * @return The queue depth (always @c 0 for local sessions).
+	 */
+	virtual int GetNetQueueDepth() const { return 0; }
 	std::shared_ptr<HoverScript::TrackPeer> GetTrackPeer() const { return trackPeer; }
 
 	std::shared_ptr<Rules> GetRules() { return rules; }
 
+private:
+	void FirePhaseEvent(Phase phase);
+
 private:
 	Phase phase;
+	bool deferEvents;
+	std::vector<std::function<void()>> deferredEvents;
 
 	mutable boost::mutex chatMutex;
 	static const int CHAT_MESSAGE_STACK = 8;
 	ChatMessage mMessageStack[CHAT_MESSAGE_STACK];
 
 	Model::GameSession mSession;
+	Model::RenderSnapshot renderSnapshot;  ///< Released before the level.
 	static const int MAX_PLAYERS = 4;
 	std::array<std::shared_ptr<Player::Player>, MAX_PLAYERS> players;
 
@@ -157,6 +175,8 @@ private:
 	boost::signals2::scoped_connection countdownConn;
 	std::shared_ptr<Rules> rules;
 
+	std::unique_ptr<SessionTelemetry> telemetry;
+
 	void ReadLevelAttrib(Parcel::RecordFile *pFile,
 		VideoServices::VideoBuffer *pVideo);
 };
@@ -25,6 +25,9 @@
 #include "../../engine/Display/FillBox.h"
 #include "../../engine/Display/Display.h"
 
+#include "FrameGraph.h"
+#include "GameDirector.h"
+
 #include "DebugScene.h"
 
 using namespace HoverRace::Util;
@@ -35,7 +38,7 @@ namespace Client {
 DebugScene::DebugScene(Display::Display &display,
 	GameDirector &director) :
 	SUPER("Debug Overlay"),
-	director(director), prevUpdateTick(0)
+	display(display), director(director), prevUpdateTick(0)
 {
 	using namespace Display;
 
@@ -48,12 +51,28 @@ DebugScene::DebugScene(Display::Display &display,
 	debugLbl.reset(new ActiveText("", s.bodyFont, COLOR_WHITE));
 	debugLbl->AttachView(display);
 	debugLbl->SetPos(10, 40);
+
+	frameGraph.reset(new FrameGraph(display, director.ShareRootProfiler(),
+		director.ShareWorkerProfiler("simulate")));
+	frameGraph->AttachView(display);
+	frameGraph->SetAlignment(UiViewModel::Alignment::SE);
+	frameGraph->SetPos(1270, 710);
 }
 
 DebugScene::~DebugScene()
 {
 }
 
+/**
+ * Record the times of the frame that just ended.
+ * This must be called between frames, so that every profiler holds the
+ * times of the same frame.
+ */
+void DebugScene::SampleFrame()
+{
+	frameGraph->Sample();
+}
+
 void DebugScene::Advance(Util::OS::timestamp_t tick)
 {
 	// Update the debug text no more than roughly 60 Hz.
@@ -68,6 +87,9 @@ void DebugScene::Advance(Util::OS::timestamp_t tick)
 			std::ostringstream oss;
 			oss << "Scene: " << scene->GetName() << "\n\n";
 			scene->OutputDebugText(oss);
+			oss << '\n';
+			display.OutputDebugText(oss);
+			frameGraph->OutputDebugText(oss);
 			auto s = oss.str();
 			boost::trim_right(s);
 			debugLbl->SetText(s);
@@ -86,6 +108,7 @@ void DebugScene::PrepareRender()
 
 	debugBox->PrepareRender();
 	debugLbl->PrepareRender();
+	frameGraph->PrepareRender();
 }
 
 void DebugScene::Render()
@@ -94,6 +117,7 @@ void DebugScene::Render()
 
 	debugBox->Render();
 	debugLbl->Render();
+	frameGraph->Render();
 }
 
 }  // namespace HoverScript
@@ -27,6 +27,7 @@
 
 namespace HoverRace {
 	namespace Client {
+		class FrameGraph;
 		class Scene;
 	}
 	namespace Display {
@@ -54,16 +55,21 @@ public:
 public:
 	bool IsMouseCursorEnabled() const override { return true; }
 
+public:
+	void SampleFrame();
+
 public:
 	void Advance(Util::OS::timestamp_t tick) override;
 	void PrepareRender() override;
 	void Render() override;
 
 private:
+	Display::Display &display;
 	GameDirector &director;
 	Util::OS::timestamp_t prevUpdateTick;
 	std::unique_ptr<Display::ActiveText> debugLbl;
 	std::unique_ptr<Display::FillBox> debugBox;
+	std::unique_ptr<FrameGraph> frameGraph;
 };
 
 }  // namespace HoverScript
@@ -0,0 +1,316 @@
+// FrameGraph.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "../../engine/Display/BarGraph.h"
+#include "../../engine/Display/FillBox.h"
+#include "../../engine/Display/Label.h"
+
+#include "FrameGraph.h"
+
+using namespace HoverRace::Util;
+
+namespace HoverRace {
+namespace Client {
+
+namespace {
+
+const size_t HISTORY = 120;  ///< Number of frames shown.
+const double BAR_WIDTH = 3;
+const double GRAPH_HEIGHT = 150;
+const double GRAPH_MS = 50;  ///< Frame time at the top of the graph.
+const double GRAPH_TOP = 72;  ///< Space for the labels above the graph.
+const double GRAPH_WIDTH = BAR_WIDTH * HISTORY;
+
+const unsigned int STATS_INTERVAL = 15;  ///< Frames between label updates.
+
+const Display::Color PART_COLORS[] = {
+	0xff3fbf3f,  // SIMULATE
+	0xffdfdf3f,  // PREPARE
+	0xff3f7fff,  // VIEW_3D
+	0xffdf3fdf,  // UI
+	0xffff7f3f,  // PRESENT
+	0xff7f7f7f,  // OTHER
+};
+
+const char *PART_NAMES[] = {
+	"sim",
+	"prepare",
+	"3D",
+	"UI",
+	"present",
+	"other",
+};
+
+double ToMs(Profiler::dur_t dur)
+{
+	return std::chrono::duration<double, std::milli>(dur).count();
+}
+
+double MsToHeight(double ms)
+{
+	return ms * (GRAPH_HEIGHT / GRAPH_MS);
+}
+
+}  // namespace
+
+/**
+ * Constructor.
+ * @param display The display child elements will be attached to.
+ * @param rootProfiler The profiler for the whole frame.
+ * @param simWorkerProfiler The profiler for the simulation thread.
+ * @param layoutFlags Optional layout flags.
+ */
+FrameGraph::FrameGraph(Display::Display &display,
+	std::shared_ptr<Profiler> rootProfiler,
+	std::shared_ptr<Profiler> simWorkerProfiler,
+	Display::uiLayoutFlags_t layoutFlags) :
+	SUPER(display, Vec2(GRAPH_WIDTH, GRAPH_TOP + GRAPH_HEIGHT), false,
+		layoutFlags),
+	rootProfiler(std::move(rootProfiler)), lastRootSamples(0),
+	root({ }),
+	advance({ "advance" }), simulate({ "advance", "simulate" }),
+	prepare({ "prepare" }),
+	render({ "render" }), view3D({ "render", "view3D" }),
+	present({ "present" }), simWorker(std::move(simWorkerProfiler)),
+	frameTimes(HISTORY, 0.0),
+	cursor(0), filled(0), samplesSinceStats(0),
+	simWorkerSum(0), simWorkerMax(0)
+{
+	using namespace Display;
+
+	const auto &s = display.styles;
+
+	NewChild<FillBox>(GRAPH_WIDTH, GRAPH_TOP + GRAPH_HEIGHT, 0x3f000000);
+
+	// Guides at 60 and 30 FPS.
+	for (double ms : { 1000.0 / 60.0, 1000.0 / 30.0 }) {
+		NewChild<FillBox>(GRAPH_WIDTH, 1, 0x7fffffff)->SetPos(
+			0, GRAPH_TOP + GRAPH_HEIGHT - MsToHeight(ms));
+	}
+
+	bars = NewChild<BarGraph>(Vec2(GRAPH_WIDTH, GRAPH_HEIGHT), HISTORY,
+		std::vector<Color>(std::begin(PART_COLORS), std::end(PART_COLORS)));
+	bars->SetPos(0, GRAPH_TOP);
+
+	cursorBox = NewChild<FillBox>(1, GRAPH_HEIGHT, 0xbfffffff);
+	cursorBox->SetPos(0, GRAPH_TOP);
+
+	statsLbl = NewChild<Label>("", s.bodyAsideFont, COLOR_WHITE);
+	statsLbl->SetPos(5, 0);
+
+	simWorkerLbl = NewChild<Label>("", s.bodyAsideFont, COLOR_WHITE);
+	simWorkerLbl->SetPos(5, 22);
+
+	double x = 5;
+	for (size_t i = 0; i < NUM_PARTS; i++) {
+		auto lbl = NewChild<Label>(PART_NAMES[i], s.bodyAsideFont,
+			PART_COLORS[i]);
+		lbl->SetPos(x, 44);
+		x += GRAPH_WIDTH / NUM_PARTS;
+	}
+}
+
+FrameGraph::~FrameGraph()
+{
+}
+
+/**
+ * Retrieve the time a profiler has sampled since the last call.
+ * @param src The profiler source.
+ * @return The time (in ms), or zero if the profiler doesn't exist (yet).
+ */
+double FrameGraph::Delta(Source &src)
+{
+	if (!src.profiler) {
+		// Subsets may be added later (e.g. when a game starts).
+		auto profiler = rootProfiler;
+		for (const auto &name : src.path) {
+			profiler = profiler->FindSub(name);
+			if (!profiler) return 0;
+		}
+		src.profiler = profiler;
+		src.last = profiler->GetTotalDuration();
+		src.lastAllocs = profiler->GetAllocStats();
+		return 0;
+	}
+
+	const auto &allocs = src.profiler->GetAllocStats();
+	src.allocs.count = allocs.count - src.lastAllocs.count;
+	src.allocs.bytes = allocs.bytes - src.lastAllocs.bytes;
+	src.lastAllocs = allocs;
+
+	auto total = src.profiler->GetTotalDuration();
+	double retv = ToMs(total - src.last);
+	src.last = total;
+	return retv;
+}
+
+void FrameGraph::AddAllocs(Part part, const AllocTracker::Stats &stats)
+{
+	allocSums[part].count += stats.count;
+	allocSums[part].bytes += stats.bytes;
+}
+
+/**
+ * Record the times of the last completed frame.
+ */
+void FrameGraph::Sample()
+{
+	// The root profiler is sampled once per frame, so we know how many
+	// frames passed since the last time we were called.
+	auto rootSamples = rootProfiler->GetSampleCount();
+	bool skipped = rootSamples != lastRootSamples + 1;
+	lastRootSamples = rootSamples;
+
+	double frameMs = Delta(root);
+	double simWorkerMs = Delta(simWorker);
+	double advanceMs = Delta(advance);
+	double renderMs = Delta(render);
+
+	parts_t parts;
+	parts[SIMULATE] = Delta(simulate);
+	parts[PREPARE] = Delta(prepare);
+	parts[VIEW_3D] = Delta(view3D);
+	parts[UI] = std::max(0.0, renderMs - parts[VIEW_3D]);
+	parts[PRESENT] = Delta(present);
+
+	// Allocations on this thread are counted by the profilers; anything else
+	// was allocated by the background threads.
+	auto threadAllocs = AllocTracker::GetThreadStats();
+	auto totalAllocs = AllocTracker::GetTotalStats();
+	MR_UInt64 bgCount = (totalAllocs.count - lastTotalAllocs.count) -
+		(threadAllocs.count - lastThreadAllocs.count);
+	MR_UInt64 bgBytes = (totalAllocs.bytes - lastTotalAllocs.bytes) -
+		(threadAllocs.bytes - lastThreadAllocs.bytes);
+	lastThreadAllocs = threadAllocs;
+	lastTotalAllocs = totalAllocs;
+
+	// If the graph wasn't sampled every frame (e.g. it was hidden), then the
+	// times cover more than one frame.
+	if (skipped) return;
+
+	AddAllocs(SIMULATE, simulate.allocs);
+	AddAllocs(PREPARE, prepare.allocs);
+	AddAllocs(VIEW_3D, view3D.allocs);
+	AddAllocs(UI, render.allocs);
+	AddAllocs(PRESENT, present.allocs);
+	AddAllocs(OTHER, root.allocs);
+	AddAllocs(OTHER, advance.allocs);
+	bgAllocSum.count += bgCount;
+	bgAllocSum.bytes += bgBytes;
+
+	// The simulation thread runs alongside the frame, so it only shows up
+	// in the stats.
+	simWorkerSum += simWorkerMs;
+	simWorkerMax = std::max(simWorkerMax, simWorkerMs);
+
+	// Everything else, including the rest of the advance phase.
+	double known = advanceMs + parts[PREPARE] + renderMs + parts[PRESENT];
+	parts[OTHER] = std::max(0.0, frameMs - known) +
+		std::max(0.0, advanceMs - parts[SIMULATE]);
+
+	frameTimes[cursor] = frameMs;
+	for (auto &part : parts) {
+		part = MsToHeight(part);
+	}
+	bars->SetBar(cursor, parts.data());
+
+	cursor = (cursor + 1) % HISTORY;
+	if (filled < HISTORY) filled++;
+	cursorBox->SetPos(BAR_WIDTH * cursor, GRAPH_TOP);
+
+	if (++samplesSinceStats >= STATS_INTERVAL) {
+		UpdateStats();
+		samplesSinceStats = 0;
+	}
+}
+
+/**
+ * Output the average allocations per frame for each part of the frame.
+ * Nothing is output unless the AllocTracker is enabled.
+ * @param [in,out] oss The output stream to write to.
+ * @return The same output stream as was passed in.
+ */
+std::ostream &FrameGraph::OutputDebugText(std::ostream &oss) const
+{
+	if (!AllocTracker::IsEnabled()) return oss;
+
+	static boost::format fmt("  %s %d (%0.1f KB)");
+	auto output = [&](const char *name, const AllocTracker::Stats &avg) {
+		oss << fmt % name % avg.count %
+			(static_cast<double>(avg.bytes) / 1024.0);
+	};
+
+	oss << "Allocations per frame:\n";
+	for (size_t i = 0; i < NUM_PARTS; i++) {
+		output(PART_NAMES[i], allocAvgs[i]);
+		if (i % 3 == 2) oss << '\n';
+	}
+	output("threads", bgAllocAvg);
+	oss << '\n';
+
+	return oss;
+}
+
+/**
+ * Update the frame time percentiles.
+ */
+void FrameGraph::UpdateStats()
+{
+	if (samplesSinceStats > 0) {
+		for (size_t i = 0; i < NUM_PARTS; i++) {
+			allocAvgs[i].count = allocSums[i].count / samplesSinceStats;
+			allocAvgs[i].bytes = allocSums[i].bytes / samplesSinceStats;
+			allocSums[i] = AllocTracker::Stats();
+		}
+		bgAllocAvg.count = bgAllocSum.count / samplesSinceStats;
+		bgAllocAvg.bytes = bgAllocSum.bytes / samplesSinceStats;
+		bgAllocSum = AllocTracker::Stats();
+
+		if (simWorkerMax > 0) {
+			static boost::format simFmt("Sim thread: avg %0.1f  max %0.1f ms");
+			simWorkerLbl->SetText(boost::str(simFmt %
+				(simWorkerSum / samplesSinceStats) % simWorkerMax));
+		}
+		else {
+			simWorkerLbl->SetText("Sim thread: idle");
+		}
+		simWorkerSum = 0;
+		simWorkerMax = 0;
+	}
+
+	if (filled == 0) return;
+
+	std::vector<double> sorted(frameTimes.begin(),
+		frameTimes.begin() + filled);
+	std::sort(sorted.begin(), sorted.end());
+
+	auto pct = [&](double p) {
+		return sorted[static_cast<size_t>(p * (sorted.size() - 1) + 0.5)];
+	};
+
+	static boost::format fmt("Frame: p50 %0.1f  p95 %0.1f  p99 %0.1f  "
+		"max %0.1f ms");
+	statsLbl->SetText(boost::str(fmt %
+		pct(0.50) % pct(0.95) % pct(0.99) % sorted.back()));
+}
+
+}  // namespace Client
+}  // namespace HoverRace
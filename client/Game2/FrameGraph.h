@@ -0,0 +1,132 @@
+// FrameGraph.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include "../../engine/Display/Container.h"
+#include "../../engine/Util/Profiler.h"
+
+namespace HoverRace {
+	namespace Display {
+		class BarGraph;
+		class Display;
+		class FillBox;
+		class Label;
+	}
+}
+
+namespace HoverRace {
+namespace Client {
+
+/**
+ * Graph of the recent frame times, broken down by the part of the frame.
+ *
+ * The times are taken from the frame profilers, so the graph needs to be
+ * sampled exactly once per frame, between frames.  Work done on the simulation thread
+ * overlaps the frame, so it is reported separately instead of being
+ * stacked into the bars.
+ * @author Michael Imamura
+ */
+class FrameGraph : public Display::Container
+{
+	using SUPER = Display::Container;
+
+public:
+	FrameGraph(Display::Display &display,
+		std::shared_ptr<Util::Profiler> rootProfiler,
+		std::shared_ptr<Util::Profiler> simWorkerProfiler,
+		Display::uiLayoutFlags_t layoutFlags = 0);
+	virtual ~FrameGraph();
+
+public:
+	void Sample();
+
+	std::ostream &OutputDebugText(std::ostream &oss) const;
+
+private:
+	/// The parts of the frame, from the bottom of each bar to the top.
+	enum Part
+	{
+		SIMULATE,
+		PREPARE,
+		VIEW_3D,
+		UI,
+		PRESENT,
+		OTHER,
+		NUM_PARTS
+	};
+
+	/// A profiler and its total time as of the last sample.
+	struct Source
+	{
+		Source(std::initializer_list<const char*> path) :
+			path(path.begin(), path.end()),
+			last(Util::Profiler::dur_t::zero()) { }
+		Source(std::shared_ptr<Util::Profiler> profiler) :
+			profiler(std::move(profiler)),
+			last(this->profiler->GetTotalDuration()),
+			lastAllocs(this->profiler->GetAllocStats()) { }
+
+		std::vector<std::string> path;  ///< Names of the subsets from the root.
+		std::shared_ptr<Util::Profiler> profiler;
+		Util::Profiler::dur_t last;
+		Util::AllocTracker::Stats lastAllocs;
+		Util::AllocTracker::Stats allocs;  ///< Allocations since the last sample.
+	};
+
+	double Delta(Source &src);
+	void AddAllocs(Part part, const Util::AllocTracker::Stats &stats);
+	void UpdateStats();
+
+private:
+	std::shared_ptr<Util::Profiler> rootProfiler;
+	MR_UInt64 lastRootSamples;
+	Source root;
+	Source advance;
+	Source simulate;
+	Source prepare;
+	Source render;
+	Source view3D;
+	Source present;
+	Source simWorker;
+
+	using parts_t = std::array<double, NUM_PARTS>;
+	std::vector<double> frameTimes;  ///< Ring buffer of frame times (in ms).
+	size_t cursor;
+	size_t filled;
+	unsigned int samplesSinceStats;
+	double simWorkerSum;  ///< Simulation thread time since the last stats (in ms).
+	double simWorkerMax;
+
+	Util::AllocTracker::Stats lastThreadAllocs;
+	Util::AllocTracker::Stats lastTotalAllocs;
+	std::array<Util::AllocTracker::Stats, NUM_PARTS> allocSums;
+	Util::AllocTracker::Stats bgAllocSum;  ///< Allocations on other threads.
+	std::array<Util::AllocTracker::Stats, NUM_PARTS> allocAvgs;
+	Util::AllocTracker::Stats bgAllocAvg;
+
+	std::shared_ptr<Display::BarGraph> bars;
+	std::shared_ptr<Display::FillBox> cursorBox;
+	std::shared_ptr<Display::Label> statsLbl;
+	std::shared_ptr<Display::Label> simWorkerLbl;
+};
+
+}  // namespace Client
+}  // namespace HoverRace
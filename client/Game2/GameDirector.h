@@ -42,6 +42,9 @@ namespace HoverRace {
 		class AvatarGallery;
 		class Player;
 	}
+	namespace Util {
+		class Profiler;
+	}
 	namespace VideoServices {
 		class VideoBuffer;
 	}
@@ -161,6 +164,54 @@ public:
 	 */
 	virtual std::shared_ptr<Player::Player> ShareUiPilot() const = 0;
 
+	/**
+	 * Retrieve a profiler for a part of the frame rendering.
+	 *
+	 * The profiler is a subset of the "render" profiler, so it is reported
+	 * along with it when profiling is enabled.
+	 *
+	 * @param name The name of the subset.
+	 * @return The profiler (never @c nullptr); the same one is returned for
+	 *         every request with the same name.
+	 */
+	virtual std::shared_ptr<Util::Profiler> ShareRenderProfiler(
+		const std::string &name) = 0;
+
+	/**
+	 * Retrieve a profiler for a part of the frame simulation.
+	 *
+	 * The profiler is a subset of the "advance" profiler, so it is reported
+	 * along with it when profiling is enabled.
+	 *
+	 * @param name The name of the subset.
+	 * @return The profiler (never @c nullptr); the same one is returned for
+	 *         every request with the same name.
+	 */
+	virtual std::shared_ptr<Util::Profiler> ShareAdvanceProfiler(
+		const std::string &name) = 0;
+
+	/**
+	 * Retrieve a profiler for work done on a background thread.
+	 *
+	 * The work overlaps the frame instead of being a part of it, so these
+	 * profilers are kept apart from the frame profilers; they are reported
+	 * relative to the whole frame when profiling is enabled.
+	 *
+	 * @param name The name of the profiler.
+	 * @return The profiler (never @c nullptr); the same one is returned for
+	 *         every request with the same name.
+	 */
+	virtual std::shared_ptr<Util::Profiler> ShareWorkerProfiler(
+		const std::string &name) = 0;
+
+	/**
+	 * Retrieve the profiler for the whole frame.
+	 * Each part of the frame is a subset ("advance", "prepare", "render",
+	 * "present").
+	 * @return The profiler (never @c nullptr).
+	 */
+	virtual std::shared_ptr<Util::Profiler> ShareRootProfiler() = 0;
+
 	using sessionChangedSignal_t =
 		boost::signals2::signal<void(std::shared_ptr<HoverScript::MetaSession>)>;
 
@@ -26,6 +26,7 @@
 #include "../../engine/Player/Player.h"
 #include "../../engine/Util/Duration.h"
 #include "../../engine/Util/Loader.h"
+#include "../../engine/Util/Tracer.h"
 #include "../../engine/VideoServices/SoundServer.h"
 #include "../../engine/VideoServices/VideoBuffer.h"
 
@@ -69,7 +70,11 @@ GameScene::GameScene(const std::string &name,
 	std::shared_ptr<Loader> loader) :
 	SUPER(name),
 	display(display), director(director), scripting(scripting), rules(rules),
-	finishedLoading(false), muted(false),
+	finishedLoading(false), muted(false), simAdvanced(false),
+	simWorkerDur(Util::Profiler::dur_t::zero()),
+	simProfiler(director.ShareAdvanceProfiler("simulate")),
+	simWorkerProfiler(director.ShareWorkerProfiler("simulate")),
+	viewProfiler(director.ShareRenderProfiler("view3D")),
 	session(nullptr)
 {
 	finishedLoadingConn =
@@ -93,22 +98,39 @@ std::ostream &GameScene::OutputDebugText(std::ostream &oss) const
 	for (auto &viewport : viewports) {
 		auto &player = viewport.player;
 		auto mainChar = player->GetMainCharacter();
+		const auto &stats = viewport.observer->GetRenderStats();
 
 		oss << "View " << viewportIdx << ": " << player->GetName() << "\n" <<
 			"Position: " << mainChar->mPosition <<
 				"  Orientation: " << mainChar->GetCabinOrientation() << "\n"
 			"Speed: abs=" << mainChar->GetAbsoluteSpeed() << ", "
-				"dir=" << mainChar->GetDirectionalSpeed() <<
+				"dir=" << mainChar->GetDirectionalSpeed() << "\n"
+			"Rooms: " << stats.visibleRooms << '/' << stats.pvsRooms <<
+				"  Surfaces: " << stats.surfaces << '/' <<
+				stats.pvsSurfaces << "\n"
+			"Wall columns hidden: " << stats.hiddenWallColumns << '/' <<
+				stats.wallColumns << "\n"
+			"Elements culled: " << stats.culledElements << '/' <<
+				stats.elements <<
+				"  Patches culled: " << stats.culledPatches << '/' <<
+				stats.patches <<
 			"\n\n";
 
 		viewportIdx++;
 	}
 
+	const auto &legacyDisplay = display.GetLegacyDisplay();
+	oss << "Render scale: " << legacyDisplay.GetRenderScale() << " (" <<
+		legacyDisplay.GetRenderWidth() << 'x' <<
+		legacyDisplay.GetRenderHeight() << ")\n\n";
+
 	return SUPER::OutputDebugText(oss);
 }
 
 void GameScene::Cleanup()
 {
+	Sync();
+
 	director.GetSessionChangedSignal()(nullptr);
 	if (metaSession) {
 		metaSession->GetSession()->OnSessionEnd();
@@ -155,6 +177,7 @@ void GameScene::ScheduleLoad(std::shared_ptr<Loader> loader)
 
 		// Split-screen with multiple viewports.
 		// The bounds of each viewport will be set in LayoutViewports().
+		auto clearZProfiler = director.ShareRenderProfiler("clearZ");
 		for (auto &player : localHumans) {
 			viewports.emplace_back(
 				display,
@@ -163,6 +186,7 @@ void GameScene::ScheduleLoad(std::shared_ptr<Loader> loader)
 				new Display::Hud(display,
 					player, track,
 					Display::UiLayoutFlags::FLOATING));
+			viewports.back().observer->SetClearZProfiler(clearZProfiler);
 		}
 	});
 
@@ -220,13 +244,49 @@ void GameScene::SetMuted(bool muted)
 	this->muted = muted;
 }
 
+/**
+ * Wait for the simulation that was started by the previous frame, if any,
+ * then fire the session events that it queued.
+ */
+void GameScene::Sync()
+{
+	if (!simWorker || !simWorker->IsBusy()) return;
+
+	try {
+		simWorker->Wait();
+	}
+	catch (...) {
+		session->SetDeferEvents(false);
+		throw;
+	}
+	session->SetDeferEvents(false);
+
+	// The phase and finish handlers call into scripts and the HUD, so they
+	// are held until the simulation is done and fired here instead.
+	session->FireDeferredEvents();
+}
+
 void GameScene::Advance(Util::OS::timestamp_t tick)
 {
 	SUPER::Advance(tick);
 
 	if (!finishedLoading) return;
 
-	session->Process();
+	Sync();
+	if (simAdvanced) {
+		// Already simulated while the previous frame was being drawn.
+		// That time overlapped the previous frame, so it goes to the worker
+		// profiler instead of this frame's.  The profiler isn't thread-safe,
+		// so the time is added now that the worker is done.
+		simAdvanced = false;
+		simWorkerProfiler->AddSample(simWorkerDur);
+		simWorkerProfiler->AddAllocs(simWorkerAllocs);
+	}
+	else {
+		Util::Profiler::Sampler sampler(*simProfiler);
+		HR_TRACE_ZONE("simulate");
+		session->Process();
+	}
 
 	//TODO: Check finished state?  Wait for signal from SessionPeer?
 
@@ -260,14 +320,62 @@ void GameScene::Render()
 	auto cfg = Config::GetInstance();
 	MR_SimulationTime simTime = session->GetSimulationTime();
 
+	// Trigger sounds.
+	if (!muted) {
+		int i = 0;
+		for (auto &viewport : viewports) {
+			viewport.observer->PlaySounds(session->GetCurrentLevel(),
+				session->GetPlayer(i++)->GetMainCharacter());
+		}
+		VideoServices::SoundServer::ApplyContinuousPlay();
+	}
+
+	// Save what the views will draw: the elements (where they are now, not
+	// where the last simulation slice left them, if interpolating) and each
+	// viewport's camera.  From here on, the views only draw from this
+	// snapshot.
+	session->SaveRenderState(cfg->video.motionInterpolation);
+	{
+		int i = 0;
+		for (auto &viewport : viewports) {
+			viewport.observer->SaveRenderState(
+				session->GetPlayer(i++)->GetMainCharacter(), simTime);
+		}
+	}
+
+	if (cfg->runtime.pipelineSim) {
+		// Simulate the next tick while the frame is drawn and presented.
+		// Nothing drawn after this point may read the world: the 3D views
+		// draw from the snapshot above, the HUD draws from the snapshot
+		// taken by Hud::Advance(), and the other scenes only draw their own
+		// state.  The world isn't touched again on this thread until Sync().
+		//
+		// The worker may not call into scripts or the HUD either, so the
+		// session queues its events until Sync().
+		if (!simWorker) {
+			simWorker.reset(new Util::Worker());
+		}
+		simAdvanced = true;
+		session->SetDeferEvents(true);
+		simWorker->Start([&]{
+			HR_TRACE_ZONE("simulate");
+			auto start = Util::Profiler::clock_t::now();
+			auto startAllocs = Util::AllocTracker::GetThreadStats();
+			session->Process();
+			simWorkerDur = Util::Profiler::clock_t::now() - start;
+			auto endAllocs = Util::AllocTracker::GetThreadStats();
+			simWorkerAllocs.count = endAllocs.count - startAllocs.count;
+			simWorkerAllocs.bytes = endAllocs.bytes - startAllocs.bytes;
+		});
+	}
+
 	{
+		Util::Profiler::Sampler sampler(*viewProfiler);
 		VideoServices::VideoBuffer *videoBuf = &display.GetLegacyDisplay();
 		VideoServices::VideoBuffer::Lock lock(*videoBuf);
 
-		int i = 0;
 		for (auto &viewport : viewports) {
 			viewport.observer->RenderNormalDisplay(videoBuf, session,
-				session->GetPlayer(i++)->GetMainCharacter(),
 				simTime, session->GetBackImage());
 		}
 	}
@@ -279,16 +387,6 @@ void GameScene::Render()
 			}
 		}
 	}
-
-	// Trigger sounds.
-	if (!muted) {
-		int i = 0;
-		for (auto &viewport : viewports) {
-			viewport.observer->PlaySounds(session->GetCurrentLevel(),
-				session->GetPlayer(i++)->GetMainCharacter());
-		}
-		VideoServices::SoundServer::ApplyContinuousPlay();
-	}
 }
 
 /**
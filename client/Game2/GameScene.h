@@ -23,6 +23,8 @@
 
 #include "../../engine/Display/HudCell.h"
 #include "../../engine/Util/Config.h"
+#include "../../engine/Util/Profiler.h"
+#include "../../engine/Util/Worker.h"
 
 #include "Observer.h"
 #include "GameDirector.h"
@@ -115,6 +117,7 @@ protected:
 	void SetMuted(bool muted);
 
 public:
+	void Sync() override;
 	void Advance(Util::OS::timestamp_t tick) override;
 	void Layout() override;
 	void PrepareRender() override;
@@ -136,6 +139,14 @@ private:
 	bool finishedLoading;
 	bool muted;
 
+	std::unique_ptr<Util::Worker> simWorker;
+	bool simAdvanced;  ///< The next tick was simulated while rendering.
+	Util::Profiler::dur_t simWorkerDur;  ///< Time taken by the background tick.
+	Util::AllocTracker::Stats simWorkerAllocs;  ///< Allocations by the background tick.
+	std::shared_ptr<Util::Profiler> simProfiler;
+	std::shared_ptr<Util::Profiler> simWorkerProfiler;
+	std::shared_ptr<Util::Profiler> viewProfiler;
+
 protected:
 	std::vector<Viewport> viewports;
 	ClientSession *session;
@@ -19,10 +19,15 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <boost/filesystem/fstream.hpp>
+
+#include "../../../engine/Exception.h"
 #include "../../../engine/Script/Core.h"
+#include "../../../engine/Script/HandlerStats.h"
 #include "../../../engine/Util/Log.h"
 #include "../../../engine/Util/OS.h"
 #include "../../../engine/Util/Str.h"
+#include "../../../engine/Util/Tracer.h"
 #include "../GameDirector.h"
 #include "../PaletteScene.h"
 #include "../TestLabScene.h"
@@ -30,6 +35,7 @@
 #include "DebugPeer.h"
 
 using namespace HoverRace::Util;
+namespace fs = boost::filesystem;
 
 namespace HoverRace {
 namespace Client {
@@ -52,16 +58,63 @@ void DebugPeer::Register(Script::Core &scripting)
 
 	module(L) [
 		class_<DebugPeer, SUPER, std::shared_ptr<DebugPeer>>("Debug")
+			.def("dump_trace", &DebugPeer::LDumpTrace)
+			.def("dump_trace", &DebugPeer::LDumpTrace_S)
+			.def("handler_stats", &DebugPeer::LHandlerStats)
 			.def("open_link", &DebugPeer::LOpenLink)
 			.def("open_path", &DebugPeer::LOpenPath)
+			.def("reset_handler_stats", &DebugPeer::LResetHandlerStats)
 			.def("show_palette", &DebugPeer::LShowPalette)
 			.def("start_test_lab", &DebugPeer::LStartTestLab)
 			.def("start_test_lab", &DebugPeer::LStartTestLab_N)
+			.def("toggle", &DebugPeer::LToggle)
 			.def("toggle_debug_overlay", &DebugPeer::LToggleDebugOverlay)
+			.def("toggle_pipelined_sim", &DebugPeer::LTogglePipelinedSim)
+			.def("toggle_alloc_tracking", &DebugPeer::LToggleAllocTracking)
+			.def("toggle_handler_profiling", &DebugPeer::LToggleHandlerProfiling)
+			.def("toggle_tracing", &DebugPeer::LToggleTracing)
 			.def("test", &DebugPeer::LTest)
 	];
 }
 
+std::string DebugPeer::LDumpTrace()
+{
+	return LDumpTrace_S(10);
+}
+
+std::string DebugPeer::LDumpTrace_S(double seconds)
+{
+	// Traces are saved alongside the screenshots.
+	OS::path_t path;
+	try {
+		path = Config::GetInstance()->GenerateScreenshotPath(".trace.json");
+	}
+	catch (Exception &ex) {
+		luaL_error(GetScripting().GetState(), "%s", ex.what());
+		return std::string();
+	}
+
+	fs::ofstream os(path, std::ios::out | std::ios::trunc);
+	if (!os.is_open()) {
+		luaL_error(GetScripting().GetState(), "Unable to write trace: %s",
+			(const char*)Str::PU(path));
+		return std::string();
+	}
+	size_t count = Tracer::Dump(os, seconds);
+	os.close();
+
+	HR_LOG(info) << "Wrote " << count << " trace events to: " << path;
+
+	return (const char*)Str::PU(path);
+}
+
+std::string DebugPeer::LHandlerStats()
+{
+	std::ostringstream oss;
+	Script::HandlerStats::Output(oss, GetScripting().GetState());
+	return oss.str();
+}
+
 void DebugPeer::LOpenLink(const std::string &url)
 {
 	OS::OpenLink(url);
@@ -72,6 +125,11 @@ void DebugPeer::LOpenPath(const std::string &path)
 	OS::OpenPath(Str::UP(path));
 }
 
+void DebugPeer::LResetHandlerStats()
+{
+	Script::HandlerStats::Reset();
+}
+
 void DebugPeer::LShowPalette()
 {
 	gameDirector.RequestPushScene(std::make_shared<PaletteScene>(gameDirector));
@@ -89,12 +147,59 @@ void DebugPeer::LStartTestLab_N(const std::string &startingModuleName)
 			*gameDirector.GetDisplay(), gameDirector, startingModuleName));
 }
 
+bool DebugPeer::LToggle(const std::string &name)
+{
+	bool *enabled = Config::GetInstance()->FindRuntimeFlag(name);
+	if (!enabled) {
+		std::ostringstream oss;
+		for (const auto &flag : Config::GetRuntimeFlags()) {
+			oss << ' ' << flag.name;
+		}
+		luaL_error(GetScripting().GetState(),
+			"Unknown flag: %s (available:%s)", name.c_str(), oss.str().c_str());
+		return false;
+	}
+
+	return (*enabled = !*enabled);
+}
+
 bool DebugPeer::LToggleDebugOverlay()
 {
 	auto &enabled = Config::GetInstance()->runtime.enableDebugOverlay;
 	return (enabled = !enabled);
 }
 
+bool DebugPeer::LTogglePipelinedSim()
+{
+	auto &enabled = Config::GetInstance()->runtime.pipelineSim;
+	return (enabled = !enabled);
+}
+
+bool DebugPeer::LToggleAllocTracking()
+{
+	if (!AllocTracker::IsAvailable()) {
+		luaL_error(GetScripting().GetState(),
+			"Allocation tracking is not available in this build "
+			"(configure with HR_ALLOC_TRACKING=TRUE).");
+		return false;
+	}
+
+	auto &enabled = Config::GetInstance()->runtime.allocTracking;
+	return (enabled = !enabled);
+}
+
+bool DebugPeer::LToggleHandlerProfiling()
+{
+	auto &enabled = Config::GetInstance()->runtime.handlerProfiling;
+	return (enabled = !enabled);
+}
+
+bool DebugPeer::LToggleTracing()
+{
+	auto &enabled = Config::GetInstance()->runtime.tracing;
+	return (enabled = !enabled);
+}
+
 void DebugPeer::LTest()
 {
 	// This is just a dummy method for arbitrary test code :)
@@ -59,12 +59,21 @@ public:
 	static void Register(Script::Core &scripting);
 
 public:
+	std::string LHandlerStats();
 	void LOpenLink(const std::string &url);
 	void LOpenPath(const std::string &path);
+	void LResetHandlerStats();
 	void LShowPalette();
 	void LStartTestLab();
 	void LStartTestLab_N(const std::string &startingModuleName);
+	bool LToggle(const std::string &name);
 	bool LToggleDebugOverlay();
+	bool LTogglePipelinedSim();
+	bool LToggleTracing();
+	bool LToggleAllocTracking();
+	bool LToggleHandlerProfiling();
+	std::string LDumpTrace();
+	std::string LDumpTrace_S(double seconds);
 
 	void LTest();
 
@@ -53,8 +53,10 @@ GamePeer::GamePeer(Script::Core &scripting, GameDirector &director,
 	SUPER(scripting, "Game"),
 	director(director), rulebookLibrary(rulebookLibrary), display(nullptr),
 	initialized(false),
-	onInit(scripting), onShutdown(scripting),
-	onSessionStart(scripting), onSessionEnd(scripting)
+	onInit(scripting, "game.on_init"),
+	onShutdown(scripting, "game.on_shutdown"),
+	onSessionStart(scripting, "game.on_session_begin"),
+	onSessionEnd(scripting, "game.on_session_end")
 {
 }
 
@@ -207,6 +207,21 @@ const char *NetworkInterface::GetPlayerName(int pIndex) const
 	return lReturnValue;
 }
 
+/**
+ * Returns the total number of bytes waiting in the output queues of all
+ * connected clients.
+ */
+int NetworkInterface::GetOutQueueLen() const
+{
+	int lReturnValue = 0;
+
+	for(int lCounter = 0; lCounter < eMaxClient; lCounter++) {
+		if(mClient[lCounter].IsConnected())
+			lReturnValue += mClient[lCounter].GetOutQueueLen();
+	}
+	return lReturnValue;
+}
+
 /**
  * Check if we are connected to the client with the specified index (pIndex).
  *
@@ -2056,6 +2071,14 @@ BOOL NetworkPort::IsConnected() const
 	return (mSocket != INVALID_SOCKET);
 }
 
+/**
+ * Returns the number of bytes waiting in the output queue.
+ */
+int NetworkPort::GetOutQueueLen() const
+{
+	return mOutQueueLen;
+}
+
 /**
  * Returns the TCP socket used for communication with the client.
  */
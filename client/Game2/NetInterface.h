@@ -104,6 +104,7 @@ class NetworkPort
 		void SetRemoteUDPPort(unsigned int pPort);
 		void Disconnect();
 		BOOL IsConnected() const;
+		int GetOutQueueLen() const;
 
 		SOCKET GetSocket() const;
 		SOCKET GetUDPSocket() const;
@@ -201,6 +202,7 @@ class NetworkInterface
 
 		int GetClientCount() const;
 		int GetId() const;
+		int GetOutQueueLen() const;
 
 		int GetLagFromServer() const;
 		int GetAvgLag(int pClient) const;
@@ -360,6 +360,11 @@ int NetworkSession::GetRank(const MainCharacter::MainCharacter * /*pPlayer */ )
 	return lReturnValue;
 }
 
+int NetworkSession::GetNetQueueDepth() const
+{
+	return mNetInterface.GetOutQueueLen();
+}
+
 /**
  * The main game loop.  Read, process, write, read.  I wonder why we read twice.
  */
@@ -119,6 +119,7 @@ class NetworkSession : public ClientSession
 
 		// Simulation control
 		void Process();
+		int GetNetQueueDepth() const override;
 
 		BOOL LoadNew(const char *pTitle, HoverRace::Parcel::RecordFilePtr pMazeFile, int pNbLap, char pGameOpts, VideoServices::VideoBuffer * pVideo);
 
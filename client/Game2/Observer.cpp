@@ -24,7 +24,10 @@
 #include "Observer.h"
 #include "../../engine/Model/Level.h"
 #include "../../engine/Model/MazeElement.h"
+#include "../../engine/Model/RenderSnapshot.h"
 #include "../../engine/Util/Config.h"
+#include "../../engine/Util/Profiler.h"
+#include "../../engine/Util/Tracer.h"
 
 #include <math.h>
 
@@ -98,7 +101,8 @@ struct GlobalFmts
 
 Observer::Observer() :
 	hudVisible(true), demoMode(false),
-	splitMode(Display::HudCell::FILL)
+	splitMode(Display::HudCell::FILL),
+	renderStats()
 {
 	globalFmts.Init();
 
@@ -144,6 +148,15 @@ void Observer::SetCockpitView(BOOL pOn)
 	mCockpitView = pOn;
 }
 
+/**
+ * Set the profiler that measures the Z buffer clears of the 3D view.
+ * @param profiler The profiler (may be @c nullptr to stop measuring).
+ */
+void Observer::SetClearZProfiler(std::shared_ptr<Util::Profiler> profiler)
+{
+	clearZProfiler = std::move(profiler);
+}
+
 const std::string &Observer::GetCraftName(int id)
 {
 	static const std::string names[4] = {
@@ -425,28 +438,42 @@ void Observer::DrawWFSection(const Model::Level * pLevel, const Model::SectionId
 
 }
 
-void Observer::Render3DView(const ClientSession *pSession, const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime, const MR_UInt8 * pBackImage)
+/**
+ * Save the view of a character for the next RenderNormalDisplay().
+ *
+ * The camera follows the state saved by the character's SaveRenderState(),
+ * so the session's render state must be saved first.  The character isn't
+ * read again until the next call, so the display can be drawn while the
+ * simulation moves on.
+ *
+ * @param pViewingCharacter The character to follow.
+ * @param pTime The current simulation time.
+ */
+void Observer::SaveRenderState(const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime)
 {
-	using HoverRace::VideoServices::Sprite;
+	viewState.room = pViewingCharacter->GetRenderRoom();
+	viewState.weaponSprite.reset();
+	viewState.weaponSpriteIndex = 0;
 
-	const bool drawHud = hudVisible && Config::GetInstance()->runtime.enableHud;
+	if(viewState.room == -1) {
+		return;
+	}
 
-	const Model::Level *lLevel = pSession->GetCurrentLevel();
+	const MR_3DCoordinate &lPosition = pViewingCharacter->GetRenderPosition();
 
 	MR_3DCoordinate lCameraPos;
-	MR_Angle lOrientation = pViewingCharacter->mOrientation;
-	int lRoom = pViewingCharacter->mRoom;
+	MR_Angle lOrientation;
 
 	if(mCockpitView) {
-		lOrientation = pViewingCharacter->GetCabinOrientation();
-		lCameraPos.mX = pViewingCharacter->mPosition.mX - 256 * MR_Cos[lOrientation] / MR_TRIGO_FRACT;
-		lCameraPos.mY = pViewingCharacter->mPosition.mY - 256 * MR_Sin[lOrientation] / MR_TRIGO_FRACT;
-		lCameraPos.mZ = pViewingCharacter->mPosition.mZ + 1050;
+		lOrientation = pViewingCharacter->GetRenderCabinOrientation();
+		lCameraPos.mX = lPosition.mX - 256 * MR_Cos[lOrientation] / MR_TRIGO_FRACT;
+		lCameraPos.mY = lPosition.mY - 256 * MR_Sin[lOrientation] / MR_TRIGO_FRACT;
+		lCameraPos.mZ = lPosition.mZ + 1050;
 	}
 	else {
 		int lDist = 3400;
 
-		lOrientation = pViewingCharacter->mOrientation;
+		lOrientation = pViewingCharacter->GetRenderOrientation();
 
 		if (demoMode) {
 			//TODO: Cycle through a set of cinematic camera pans.
@@ -461,9 +488,9 @@ void Observer::Render3DView(const ClientSession *pSession, const MainCharacter::
 			lDist += lFactor;
 		}
 
-		lCameraPos.mX = pViewingCharacter->mPosition.mX - lDist * MR_Cos[lOrientation] / MR_TRIGO_FRACT;
-		lCameraPos.mY = pViewingCharacter->mPosition.mY - lDist * MR_Sin[lOrientation] / MR_TRIGO_FRACT;
-		lCameraPos.mZ = pViewingCharacter->mPosition.mZ + 1700;
+		lCameraPos.mX = lPosition.mX - lDist * MR_Cos[lOrientation] / MR_TRIGO_FRACT;
+		lCameraPos.mY = lPosition.mY - lDist * MR_Sin[lOrientation] / MR_TRIGO_FRACT;
+		lCameraPos.mZ = lPosition.mZ + 1700;
 
 		if(mLastCameraPosValid) {
 			lCameraPos.mX = (3 * lCameraPos.mX + mLastCameraPos.mX) / 4;
@@ -475,122 +502,56 @@ void Observer::Render3DView(const ClientSession *pSession, const MainCharacter::
 	mLastCameraPos = lCameraPos;
 	mLastCameraPosValid = TRUE;
 
-	m3DView.SetupCameraPosition(lCameraPos, lOrientation, mScroll);
-
-	// Clear background
-	if(pBackImage == NULL) {
-		m3DView.Clear(0);						  // Will have to be replace by a bitmapped background
-	}
-	else {
-		m3DView.RenderBackground(pBackImage);
-	}
-
-	m3DView.ClearZ();
-
-	int lCounter;
-
-	// Floor and ceiling drawing
-
-	int lTotalSections = lLevel->GetNbVisibleSurface(lRoom);
-	const Model::SectionId *lFloorList = lLevel->GetVisibleFloorList(lRoom);
-	const Model::SectionId *lCeilingList = lLevel->GetVisibleCeilingList(lRoom);
-
-	for(lCounter = 0; lCounter < lTotalSections; lCounter++) {
-		// Draw the floor
-		RenderFloorOrCeiling(lLevel, lFloorList[lCounter], TRUE, pTime);
-
-		// Render the ceiling
-		RenderFloorOrCeiling(lLevel, lCeilingList[lCounter], FALSE, pTime);
-
-	}
-
-	// Draw the walls and features of the visibles rooms
-
-	int lRoomCount;
-	const int *lRoomList = lLevel->GetVisibleZones(lRoom, lRoomCount);
-
-	for(lCounter = -1; lCounter < lRoomCount; lCounter++) {
-		int lRoomId;
-
-		if(lCounter == -1) {
-			lRoomId = lRoom;
-		}
-		else {
-			lRoomId = lRoomList[lCounter];
-		}
-
-		// Draw all the features
-
-		int lNbFeature = lLevel->GetFeatureCount(lRoomId);
-
-		for(int lCounter2 = 0; lCounter2 < lNbFeature; lCounter2++) {
-			RenderFeatureWalls(lLevel, lLevel->GetFeature(lRoomId, lCounter2), pTime);
-		}
-
-		RenderRoomWalls(lLevel, lRoomId, pTime);
-	}
-
-	// Draw all the elements of the visibles room
-	for(lCounter = -1; lCounter < lRoomCount; lCounter++) {
-		int lRoomId;
-
-		if(lCounter == -1) {
-			lRoomId = lRoom;
-		}
-		else {
-			lRoomId = lRoomList[lCounter];
-		}
-
-		MR_FreeElementHandle lHandle = lLevel->GetFirstFreeElement(lRoomId);
-
-		while(lHandle != NULL) {
-			Model::FreeElement *lElement = Model::Level::GetFreeElement(lHandle);
-
-			lElement->Render(&m3DView, pTime);
-
-			lHandle = Model::Level::GetNextFreeElement(lHandle);
-		}
-	}
-
-	// Display cockpit
-	int lXRes = m3DView.GetXRes();
-	int lYRes = m3DView.GetYRes();
+	viewState.cameraPos = lCameraPos;
+	viewState.orientation = lOrientation;
 
 	// MissileLevel
-	std::shared_ptr<ObjFac1::SpriteHandle> lWeaponSprite;
-	int lWeaponSpriteIndex = 0;
-
 	if(pViewingCharacter->GetCurrentWeapon() == MainCharacter::MainCharacter::eMissile) {
-		lWeaponSprite = mMissileLevel;
-		lWeaponSpriteIndex = pViewingCharacter->GetMissileRefillLevel(mMissileLevel->GetSprite()->GetNbItem());
+		viewState.weaponSprite = mMissileLevel;
+		viewState.weaponSpriteIndex = pViewingCharacter->GetMissileRefillLevel(mMissileLevel->GetSprite()->GetNbItem());
 	}
 	else if(pViewingCharacter->GetCurrentWeapon() == MainCharacter::MainCharacter::eMine) {
-		lWeaponSprite = mMineDisp;
-		lWeaponSpriteIndex = pViewingCharacter->GetMineCount();
+		viewState.weaponSprite = mMineDisp;
+		viewState.weaponSpriteIndex = pViewingCharacter->GetMineCount();
 
-		if(lWeaponSpriteIndex > 0) {
-			lWeaponSpriteIndex = ((lWeaponSpriteIndex - 1) * 2) + 1;
+		if(viewState.weaponSpriteIndex > 0) {
+			viewState.weaponSpriteIndex = ((viewState.weaponSpriteIndex - 1) * 2) + 1;
 			if((pTime >> 9) & 1) {
-				lWeaponSpriteIndex++;
+				viewState.weaponSpriteIndex++;
 			}
 		}
 	}
 	else if(pViewingCharacter->GetCurrentWeapon() == MainCharacter::MainCharacter::ePowerUp) {
-		lWeaponSprite = mPowerUpDisp;
-		lWeaponSpriteIndex = pViewingCharacter->GetPowerUpFraction(4);
-		if(lWeaponSpriteIndex == 0) {
-			lWeaponSpriteIndex = pViewingCharacter->GetPowerUpCount();
+		viewState.weaponSprite = mPowerUpDisp;
+		viewState.weaponSpriteIndex = pViewingCharacter->GetPowerUpFraction(4);
+		if(viewState.weaponSpriteIndex == 0) {
+			viewState.weaponSpriteIndex = pViewingCharacter->GetPowerUpCount();
 		}
 		else {
-			lWeaponSpriteIndex = 9 - lWeaponSpriteIndex;
+			viewState.weaponSpriteIndex = 9 - viewState.weaponSpriteIndex;
 		}
 
 	}
+}
 
-	if (drawHud && lWeaponSprite != NULL) {
+void Observer::Render3DView(const ClientSession *pSession, MR_SimulationTime pTime, const MR_UInt8 * pBackImage)
+{
+	using HoverRace::VideoServices::Sprite;
+
+	const bool drawHud = hudVisible && Config::GetInstance()->runtime.enableHud;
+
+	Render3DView(pSession->GetCurrentLevel(), pSession->GetRenderSnapshot(),
+		viewState.cameraPos, viewState.orientation, viewState.room,
+		pTime, pBackImage);
+
+	// Display cockpit
+	int lXRes = m3DView.GetXRes();
+	int lYRes = m3DView.GetYRes();
+
+	if (drawHud && viewState.weaponSprite != NULL) {
 		int lMissileScaling = 1 + (310 / lXRes);
 
-		lWeaponSprite->GetSprite()->Blt(lXRes, lYRes / 16, &m3DView, Sprite::eRight, Sprite::eTop, lWeaponSpriteIndex, lMissileScaling);
+		viewState.weaponSprite->GetSprite()->Blt(lXRes, lYRes / 16, &m3DView, Sprite::eRight, Sprite::eTop, viewState.weaponSpriteIndex, lMissileScaling);
 	}
 
 	// Print text
@@ -808,6 +769,328 @@ void Observer::Render3DView(const ClientSession *pSession, const MainCharacter::
 
 }
 
+/**
+ * Render the track as seen from a camera.
+ * This only renders the 3D world (no cockpit or HUD) into the viewport that
+ * was last set up.
+ * @param pLevel The level.
+ * @param pSnapshot The elements to draw.
+ * @param pCameraPos The camera position.
+ * @param pOrientation The camera orientation.
+ * @param pRoom The room the camera (or the character it is following) is in.
+ * @param pTime The current simulation time.
+ * @param pBackImage The background image (may be @c NULL).
+ */
+void Observer::Render3DView(const Model::Level * pLevel, const Model::RenderSnapshot & pSnapshot, const MR_3DCoordinate & pCameraPos, MR_Angle pOrientation, int pRoom, MR_SimulationTime pTime, const MR_UInt8 * pBackImage)
+{
+	HR_TRACE_ZONE("render3DView");
+
+	m3DView.SetupCameraPosition(pCameraPos, pOrientation, mScroll);
+
+	const Config *cfg = Config::GetInstance();
+	m3DView.SetBackgroundCache(cfg->runtime.backgroundCache ? TRUE : FALSE);
+
+	// Clear background
+	if(pBackImage == NULL) {
+		m3DView.Clear(0);						  // Will have to be replace by a bitmapped background
+	}
+	else {
+		m3DView.RenderBackground(pBackImage);
+	}
+
+	m3DView.SetWallCoverage(cfg->runtime.wallCoverage ? TRUE : FALSE);
+	m3DView.SetOverdrawTracking(cfg->runtime.showOverdraw ? TRUE : FALSE);
+	m3DView.SetZGenerations(cfg->runtime.zGenerations ? TRUE : FALSE);
+	m3DView.SetTiledTextures(cfg->runtime.tiledTextures ? TRUE : FALSE);
+	m3DView.SetActorBatching(cfg->runtime.actorBatching ? TRUE : FALSE);
+
+	if(clearZProfiler) {
+		Util::Profiler::Sampler lSampler(*clearZProfiler);
+		m3DView.ClearZ();
+	}
+	else {
+		m3DView.ClearZ();
+	}
+
+	int lCounter;
+
+	// Narrow the precomputed visible set down to the rooms that can actually
+	// be seen through the portals in front of the camera.
+	// If the camera isn't in (or near) the character's room, then we can't
+	// trace the portals, so fall back to the precomputed set.
+	int lCameraRoom = (cfg->runtime.portalCulling || cfg->runtime.wallCoverage) ?
+		pLevel->FindRoomForPoint(pCameraPos, pRoom) : -1;
+	ComputePortalVisibility(pLevel, cfg->runtime.portalCulling ? lCameraRoom : -1);
+
+	// The wall drawing order needs the distance to the camera even when the
+	// rooms aren't culled.
+	if(cfg->runtime.wallCoverage) {
+		ComputePortalHops(pLevel, (lCameraRoom == -1) ? pRoom : lCameraRoom);
+	}
+
+	renderStats = RenderStats();
+
+	// Floor and ceiling drawing
+
+	int lTotalSections = pLevel->GetNbVisibleSurface(pRoom);
+	const Model::SectionId *lFloorList = pLevel->GetVisibleFloorList(pRoom);
+	const Model::SectionId *lCeilingList = pLevel->GetVisibleCeilingList(pRoom);
+
+	for(lCounter = 0; lCounter < lTotalSections; lCounter++) {
+		renderStats.pvsSurfaces += 2;
+
+		// Draw the floor
+		if(IsSectionVisible(pLevel, lFloorList[lCounter])) {
+			RenderFloorOrCeiling(pLevel, lFloorList[lCounter], TRUE, pTime);
+			renderStats.surfaces++;
+		}
+
+		// Render the ceiling
+		if(IsSectionVisible(pLevel, lCeilingList[lCounter])) {
+			RenderFloorOrCeiling(pLevel, lCeilingList[lCounter], FALSE, pTime);
+			renderStats.surfaces++;
+		}
+	}
+
+	// Draw the walls and features of the visibles rooms
+
+	int lRoomCount;
+	const int *lRoomList = pLevel->GetVisibleZones(pRoom, lRoomCount);
+
+	wallRooms.clear();
+
+	for(lCounter = -1; lCounter < lRoomCount; lCounter++) {
+		int lRoomId;
+
+		if(lCounter == -1) {
+			lRoomId = pRoom;
+		}
+		else {
+			lRoomId = lRoomList[lCounter];
+		}
+
+		int lNbFeature = pLevel->GetFeatureCount(lRoomId);
+		int lNbWall = pLevel->GetRoomVertexCount(lRoomId);
+
+		for(int lCounter2 = 0; lCounter2 < lNbFeature; lCounter2++) {
+			lNbWall += pLevel->GetFeatureVertexCount(pLevel->GetFeature(lRoomId, lCounter2));
+		}
+
+		renderStats.pvsRooms++;
+		renderStats.pvsSurfaces += lNbWall;
+
+		if(!IsRoomVisible(lRoomId)) {
+			continue;
+		}
+
+		renderStats.visibleRooms++;
+		renderStats.surfaces += lNbWall;
+
+		wallRooms.push_back(lRoomId);
+	}
+
+	// The coverage buffer can only skip the walls that are behind the ones
+	// already drawn, so draw the rooms nearest to the camera first.
+	if(m3DView.GetWallCoverage()) {
+		std::stable_sort(wallRooms.begin(), wallRooms.end(),
+			[&](int a, int b) {
+				return portalWindows[a].hops < portalWindows[b].hops;
+			});
+	}
+
+	for(int lRoomId : wallRooms) {
+		// Draw all the features
+		int lNbFeature = pLevel->GetFeatureCount(lRoomId);
+
+		for(int lCounter2 = 0; lCounter2 < lNbFeature; lCounter2++) {
+			RenderFeatureWalls(pLevel, pLevel->GetFeature(lRoomId, lCounter2), pTime);
+		}
+
+		RenderRoomWalls(pLevel, lRoomId, pTime);
+	}
+
+	renderStats.wallColumns = m3DView.GetCoverageTested();
+	renderStats.hiddenWallColumns = m3DView.GetCoverageSkipped();
+
+	// Draw all the elements of the visibles room, as they were when the
+	// snapshot was taken (the simulation may be moving them by now).
+	for(lCounter = -1; lCounter < lRoomCount; lCounter++) {
+		int lRoomId;
+
+		if(lCounter == -1) {
+			lRoomId = pRoom;
+		}
+		else {
+			lRoomId = lRoomList[lCounter];
+		}
+
+		for(const auto &lEntry : pSnapshot.GetElements(lRoomId)) {
+			renderStats.elements++;
+
+			BOOL lVisible = TRUE;
+			if(cfg->runtime.elementCulling) {
+				lVisible = m3DView.IsSphereVisible(lEntry.center, lEntry.ray);
+			}
+
+			if(lVisible) {
+				lEntry.element->Render(&m3DView, pTime);
+			}
+			else {
+				renderStats.culledElements++;
+			}
+		}
+	}
+
+	renderStats.patches = m3DView.GetPatchTested();
+	renderStats.culledPatches = m3DView.GetPatchCulled();
+
+	if(cfg->runtime.showOverdraw) {
+		m3DView.RenderOverdraw();
+	}
+}
+
+/**
+ * Determine which rooms are visible from the camera by walking the portals
+ * (the walls shared with neighboring rooms), narrowing the range of visible
+ * screen columns at each step.
+ *
+ * This must be called after the camera position has been set up.
+ *
+ * @param pLevel The level.
+ * @param pCameraRoom The room that contains the camera, or @c -1 to disable
+ *                    culling (all rooms will be considered visible).
+ */
+void Observer::ComputePortalVisibility(const Model::Level * pLevel, int pCameraRoom)
+{
+	const int lNbRoom = pLevel->GetRoomCount();
+	const int lXRes = m3DView.GetXRes();
+
+	if(pCameraRoom == -1) {
+		portalWindows.assign(static_cast<size_t>(lNbRoom), PortalWindow{ 0, lXRes, 0 });
+		return;
+	}
+
+	portalWindows.assign(static_cast<size_t>(lNbRoom), PortalWindow{ 0, 0, 0 });
+	portalStack.clear();
+
+	portalWindows[pCameraRoom] = PortalWindow{ 0, lXRes, 0 };
+	portalStack.push_back(pCameraRoom);
+
+	while(!portalStack.empty()) {
+		int lRoomId = portalStack.back();
+		portalStack.pop_back();
+
+		// Copy, since the window may be widened while we walk the neighbors.
+		PortalWindow lWindow = portalWindows[lRoomId];
+
+		int lNbVertex = pLevel->GetRoomVertexCount(lRoomId);
+
+		for(int lVertex = 0; lVertex < lNbVertex; lVertex++) {
+			int lNeighbor = pLevel->GetNeighbor(lRoomId, lVertex);
+
+			if(lNeighbor == -1) {
+				continue;
+			}
+
+			int lNext = (lVertex + 1 == lNbVertex) ? 0 : lVertex + 1;
+			int lLeft;
+			int lRight;
+
+			if(!m3DView.ComputeWallColumns(
+				pLevel->GetRoomVertex(lRoomId, lVertex),
+				pLevel->GetRoomVertex(lRoomId, lNext),
+				lLeft, lRight))
+			{
+				continue;
+			}
+
+			lLeft = std::max(lLeft, lWindow.left);
+			lRight = std::min(lRight, lWindow.right);
+
+			if(lLeft >= lRight) {
+				continue;
+			}
+
+			// A room may be reached through several portals; keep the union
+			// and only revisit the room if the window actually grew.
+			PortalWindow &lNeighborWindow = portalWindows[lNeighbor];
+
+			if(lNeighborWindow.left < lNeighborWindow.right) {
+				if(lLeft >= lNeighborWindow.left && lRight <= lNeighborWindow.right) {
+					continue;
+				}
+				lLeft = std::min(lLeft, lNeighborWindow.left);
+				lRight = std::max(lRight, lNeighborWindow.right);
+			}
+
+			lNeighborWindow.left = lLeft;
+			lNeighborWindow.right = lRight;
+			portalStack.push_back(lNeighbor);
+		}
+	}
+}
+
+/**
+ * Count the portals between each room and the camera room, walking the
+ * neighbors breadth-first.  Unlike ComputePortalVisibility, this ignores
+ * the camera direction, so it works whether or not the rooms are culled.
+ *
+ * This must be called after ComputePortalVisibility.
+ *
+ * @param pLevel The level.
+ * @param pCameraRoom The room that contains the camera.
+ */
+void Observer::ComputePortalHops(const Model::Level * pLevel, int pCameraRoom)
+{
+	const int lNbRoom = pLevel->GetRoomCount();
+
+	// Rooms that can't be reached from the camera are drawn last.
+	for(PortalWindow &lWindow : portalWindows) {
+		lWindow.hops = lNbRoom;
+	}
+
+	portalStack.clear();
+
+	portalWindows[pCameraRoom].hops = 0;
+	portalStack.push_back(pCameraRoom);
+
+	// The stack is used as a queue here, so that each room is reached
+	// through the fewest portals first.
+	for(size_t lHead = 0; lHead < portalStack.size(); lHead++) {
+		int lRoomId = portalStack[lHead];
+		int lHops = portalWindows[lRoomId].hops + 1;
+
+		int lNbVertex = pLevel->GetRoomVertexCount(lRoomId);
+
+		for(int lVertex = 0; lVertex < lNbVertex; lVertex++) {
+			int lNeighbor = pLevel->GetNeighbor(lRoomId, lVertex);
+
+			if(lNeighbor == -1 || portalWindows[lNeighbor].hops <= lHops) {
+				continue;
+			}
+
+			portalWindows[lNeighbor].hops = lHops;
+			portalStack.push_back(lNeighbor);
+		}
+	}
+}
+
+/**
+ * Check if a floor or ceiling passed portal culling.
+ * @param pLevel The level.
+ * @param pSectionId The room or feature.
+ * @return @c true if the room (or the feature's parent room) is visible.
+ */
+bool Observer::IsSectionVisible(const Model::Level * pLevel, const Model::SectionId & pSectionId) const
+{
+	if(pSectionId.mType == Model::SectionId::eRoom) {
+		return IsRoomVisible(pSectionId.mId);
+	}
+	else {
+		return IsRoomVisible(pLevel->GetParent(pSectionId.mId));
+	}
+}
+
 void Observer::RenderRoomWalls(const Model::Level * pLevel, int lRoomId, MR_SimulationTime pTime)
 {
 	Model::PolygonShape *lSectionShape = pLevel->GetRoomShape(lRoomId);
@@ -969,8 +1252,8 @@ void Observer::RenderDebugDisplay(VideoServices::VideoBuffer * pDest, const Clie
 {
 	using Cell = Display::HudCell;
 
-	int lXRes = pDest->GetWidth();
-	int lYRes = pDest->GetHeight();
+	int lXRes = pDest->GetRenderWidth();
+	int lYRes = pDest->GetRenderHeight();
 	int lYOffset = 0;
 	int lXOffset = 0;
 
@@ -1015,17 +1298,26 @@ void Observer::RenderDebugDisplay(VideoServices::VideoBuffer * pDest, const Clie
 
 		Render2DDebugView(pDest, lLevel, pViewingCharacter);
 		RenderWireFrameView(lLevel, pViewingCharacter);
-		Render3DView(pSession, pViewingCharacter, pTime, pBackImage);
+		SaveRenderState(pViewingCharacter, pTime);
+		Render3DView(pSession, pTime, pBackImage);
 	}
 
 }
 
-void Observer::RenderNormalDisplay(VideoServices::VideoBuffer * pDest, const ClientSession *pSession, const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime, const MR_UInt8 * pBackImage)
+/**
+ * Render the view saved by the last SaveRenderState().
+ * This only reads the session's render snapshot, not the live elements.
+ * @param pDest The destination buffer.
+ * @param pSession The session.
+ * @param pTime The simulation time (for animated surfaces and elements).
+ * @param pBackImage The background image (may be @c NULL).
+ */
+void Observer::RenderNormalDisplay(VideoServices::VideoBuffer * pDest, const ClientSession *pSession, MR_SimulationTime pTime, const MR_UInt8 * pBackImage)
 {
 	using Cell = Display::HudCell;
 
-	int lXRes = pDest->GetWidth();
-	int lYRes = pDest->GetHeight();
+	int lXRes = pDest->GetRenderWidth();
+	int lYRes = pDest->GetRenderHeight();
 	int lYOffset = 0;
 	int lXOffset = 0;
 	int lYMargin_1024 = mYMargin_1024;
@@ -1139,11 +1431,32 @@ void Observer::RenderNormalDisplay(VideoServices::VideoBuffer * pDest, const Cli
 
 	m3DView.Setup(pDest, lXOffset + lXMargin, lYOffset + lYMargin, lXRes - 2 * lXMargin, lYRes - 2 * lYMargin, mApperture);
 
-	if(pViewingCharacter->mRoom != -1) {
-		Render3DView(pSession, pViewingCharacter, pTime, pBackImage);
+	if(viewState.room != -1) {
+		Render3DView(pSession, pTime, pBackImage);
 	}
 }
 
+/**
+ * Render the track from an arbitrary camera, filling the whole render area
+ * of the buffer (see VideoServices::VideoBuffer::SetRenderScale).
+ * Unlike RenderNormalDisplay, there is no viewing character, so the
+ * cockpit, HUD and split-screen settings are ignored.
+ * @param pDest The destination buffer.
+ * @param pLevel The level.
+ * @param pSnapshot The elements to draw (see Model::RenderSnapshot::Capture).
+ * @param pCameraPos The camera position.
+ * @param pOrientation The camera orientation.
+ * @param pRoom The room the camera is in.
+ * @param pTime The simulation time (for animated surfaces and elements).
+ * @param pBackImage The background image (may be @c NULL).
+ */
+void Observer::RenderCameraView(VideoServices::VideoBuffer * pDest, const Model::Level * pLevel, const Model::RenderSnapshot & pSnapshot, const MR_3DCoordinate & pCameraPos, MR_Angle pOrientation, int pRoom, MR_SimulationTime pTime, const MR_UInt8 * pBackImage)
+{
+	m3DView.Setup(pDest, 0, 0, pDest->GetRenderWidth(), pDest->GetRenderHeight(), mApperture);
+
+	Render3DView(pLevel, pSnapshot, pCameraPos, pOrientation, pRoom, pTime, pBackImage);
+}
+
 void Observer::PlaySounds(const Model::Level * pLevel, MainCharacter::MainCharacter * pViewingCharacter)
 {
 	// Play the sound of all moving elemnts arround
@@ -31,8 +31,12 @@ namespace HoverRace {
 		class ClientSession;
 	}
 	namespace Model {
+		class RenderSnapshot;
 		struct SectionId;
 	}
+	namespace Util {
+		class Profiler;
+	}
 }
 
 namespace HoverRace {
@@ -40,6 +44,41 @@ namespace Client {
 
 class Observer
 {
+public:
+	/// Statistics from the last call to Render3DView.
+	struct RenderStats
+	{
+		int pvsRooms;  ///< Rooms in the precomputed visible set.
+		int visibleRooms;  ///< Rooms that passed portal culling.
+		int pvsSurfaces;  ///< Surfaces in the precomputed visible set.
+		int surfaces;  ///< Surfaces actually submitted for rendering.
+		int wallColumns;  ///< Wall columns checked against the coverage buffer.
+		int hiddenWallColumns;  ///< Wall columns skipped by the coverage buffer.
+		int elements;  ///< Free elements in the visible rooms.
+		int culledElements;  ///< Free elements skipped by the frustum test.
+		int patches;  ///< Actor patches checked before rasterization.
+		int culledPatches;  ///< Actor patches that were off-screen or back-facing.
+	};
+
+private:
+	/// Range of screen columns through which a room can be seen.
+	struct PortalWindow
+	{
+		int left;
+		int right;
+		int hops;  ///< Portals crossed from the camera room (see ComputePortalHops).
+	};
+
+	/// The view of the viewing character, saved by SaveRenderState().
+	struct ViewState
+	{
+		MR_3DCoordinate cameraPos;
+		MR_Angle orientation;
+		int room;  ///< The character's room, or @c -1 to draw nothing.
+		std::shared_ptr<ObjFac1::SpriteHandle> weaponSprite;
+		int weaponSpriteIndex;
+	};
+
 private:
 	MR_3DCoordinate mLastCameraPos;
 	BOOL mLastCameraPosValid;
@@ -68,6 +107,13 @@ private:
 	std::shared_ptr<ObjFac1::SpriteHandle> mPowerUpDisp;
 	std::shared_ptr<ObjFac1::SpriteHandle> mHoverIcons;
 
+	std::vector<PortalWindow> portalWindows;  ///< One per room in the level.
+	std::vector<int> portalStack;
+	std::vector<int> wallRooms;  ///< Visible rooms, in wall drawing order.
+	std::shared_ptr<Util::Profiler> clearZProfiler;
+	RenderStats renderStats;
+	ViewState viewState;
+
 public:
 	Observer();
 	~Observer() { }
@@ -75,7 +121,13 @@ public:
 private:
 	void Render2DDebugView(VideoServices::VideoBuffer * pDest, const Model::Level * pLevel, const MainCharacter::MainCharacter * pViewingCharacter);
 	void RenderWireFrameView(const Model::Level * pLevel, const MainCharacter::MainCharacter * pViewingCharacter);
-	void Render3DView(const HoverRace::Client::ClientSession * pSession, const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
+	void Render3DView(const HoverRace::Client::ClientSession * pSession, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
+	void Render3DView(const Model::Level * pLevel, const Model::RenderSnapshot & pSnapshot, const MR_3DCoordinate & pCameraPos, MR_Angle pOrientation, int pRoom, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
+
+	void ComputePortalVisibility(const Model::Level * pLevel, int pCameraRoom);
+	void ComputePortalHops(const Model::Level * pLevel, int pCameraRoom);
+	bool IsRoomVisible(int pRoomId) const { return portalWindows[pRoomId].left < portalWindows[pRoomId].right; }
+	bool IsSectionVisible(const Model::Level * pLevel, const Model::SectionId & pSectionId) const;
 
 	void DrawWFSection(const Model::Level * pLevel, const Model::SectionId & pSectionId, MR_UInt8 pColor);
 	void RenderRoomWalls(const Model::Level * pLevel, int pRoomId, MR_SimulationTime pTime);
@@ -103,11 +155,17 @@ public:
 
 	void SetCockpitView(BOOL pOn);
 
+	void SetClearZProfiler(std::shared_ptr<Util::Profiler> profiler);
+
 	void SetSplitMode(Display::HudCell pMode);
 
+	const RenderStats &GetRenderStats() const { return renderStats; }
+
 	// Rendering function
+	void SaveRenderState(const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime);
 	void RenderDebugDisplay(VideoServices::VideoBuffer * pDest, const HoverRace::Client::ClientSession *pSession, const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
-	void RenderNormalDisplay(VideoServices::VideoBuffer * pDest, const HoverRace::Client::ClientSession *pSession, const MainCharacter::MainCharacter * pViewingCharacter, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
+	void RenderNormalDisplay(VideoServices::VideoBuffer * pDest, const HoverRace::Client::ClientSession *pSession, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
+	void RenderCameraView(VideoServices::VideoBuffer * pDest, const Model::Level * pLevel, const Model::RenderSnapshot & pSnapshot, const MR_3DCoordinate & pCameraPos, MR_Angle pOrientation, int pRoom, MR_SimulationTime pTime, const MR_UInt8 * pBackImage);
 
 	void PlaySounds(const Model::Level * pLevel, MainCharacter::MainCharacter * pViewingCharacter);
 
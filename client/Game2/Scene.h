@@ -179,6 +179,15 @@ public:
 	 */
 	virtual void OnScenePushed() { }
 
+	/**
+	 * Wait for any work that the scene is doing in the background.
+	 *
+	 * This is called by the main loop at the start of each frame, before
+	 * input is processed, so that the scene state is settled before anything
+	 * else touches it.
+	 */
+	virtual void Sync() { }
+
 	/**
 	 * Determine if the mouse cursor is enabled for this scene.
 	 * @return @c true if the cursor should be shown,
@@ -0,0 +1,244 @@
+
+// SessionTelemetry.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <iomanip>
+
+#include "../../engine/Exception.h"
+#include "../../engine/Util/Config.h"
+#include "../../engine/Util/Log.h"
+#include "../../engine/Util/Str.h"
+
+#include "SessionTelemetry.h"
+
+namespace fs = boost::filesystem;
+using namespace HoverRace::Util;
+
+namespace HoverRace {
+namespace Client {
+
+namespace {
+
+/**
+ * Retrieve a percentile from a sorted list.
+ * @param sorted The values, in ascending order.
+ * @param pct The percentile (0 to 100).
+ * @return The value.
+ */
+template<class T>
+T Percentile(const std::vector<T> &sorted, int pct)
+{
+	if (sorted.empty()) return 0;
+	return sorted[(sorted.size() - 1) * pct / 100];
+}
+
+}  // namespace
+
+/**
+ * Constructor.
+ * @param title The title of the session (usually the track name).
+ * @throw Exception The output file could not be created.
+ */
+SessionTelemetry::SessionTelemetry(const std::string &title) :
+	title(title), primed(false), summarized(false), lastRow(0),
+	rowFrames(0), rowFrameTotal(0), rowFrameMax(0),
+	rowSlices(0), rowLateElements(0), rowNetQueueMax(0),
+	netQueueMax(0), memPeak(0)
+{
+	OS::path_t path = Config::GetInstance()->misc.telemetryPath;
+	if (path.empty()) {
+		throw Exception("Telemetry path is not configured.");
+	}
+	if (!fs::exists(path) && !fs::create_directories(path)) {
+		throw Exception(
+			std::string("Unable to create telemetry directory: ") +
+				(const char*)Str::PU(path));
+	}
+
+	// The filename is based on the timestamp, like the screenshots.
+	std::string base = OS::FileTimeString();
+	for (int i = 0;; i++) {
+		std::ostringstream oss;
+		oss << base;
+		if (i > 0) oss << ' ' << i;
+
+		basePath = path / oss.str();
+		if (!fs::exists(OS::path_t(basePath).concat(".csv"))) break;
+	}
+
+	OS::path_t csvPath = OS::path_t(basePath).concat(".csv");
+	csv.open(csvPath, std::ios::out | std::ios::trunc);
+	if (!csv.is_open()) {
+		throw Exception(std::string("Unable to write telemetry: ") +
+			(const char*)Str::PU(csvPath));
+	}
+	csv.imbue(OS::stdLocale);
+
+	csv << "time_s,frames,frame_ms_mean,frame_ms_max,slices_per_frame,"
+		"late_elements,net_queue_max,memory_kb\n";
+
+	HR_LOG(info) << "Writing session telemetry to: " << csvPath;
+}
+
+SessionTelemetry::~SessionTelemetry()
+{
+	Summarize();
+}
+
+/**
+ * Record the stats for a frame.
+ * This must be called once per frame, after the session is simulated.
+ * @param frame The stats.
+ */
+void SessionTelemetry::AddFrame(const Frame &frame)
+{
+	auto now = clock_t::now();
+
+	// The first frame only sets the baseline.
+	if (!primed) {
+		primed = true;
+		start = lastFrame = now;
+		last = frame;
+		return;
+	}
+
+	double frameMs =
+		std::chrono::duration<double, std::milli>(now - lastFrame).count();
+	auto slices = static_cast<unsigned int>(frame.slices - last.slices);
+
+	frameTimes.push_back(static_cast<float>(frameMs));
+	slicesPerFrame.push_back(slices);
+	netQueueMax = std::max(netQueueMax, frame.netQueueDepth);
+
+	rowFrames++;
+	rowFrameTotal += frameMs;
+	rowFrameMax = std::max(rowFrameMax, frameMs);
+	rowSlices += slices;
+	rowLateElements += frame.lateElements - last.lateElements;
+	rowNetQueueMax = std::max(rowNetQueueMax, frame.netQueueDepth);
+
+	lastFrame = now;
+	last = frame;
+
+	double t = std::chrono::duration<double>(now - start).count();
+	if (t - lastRow >= 1.0) {
+		WriteRow(t);
+	}
+}
+
+/**
+ * Append the stats since the last row to the CSV file.
+ * @param now The current time, in seconds since the start.
+ */
+void SessionTelemetry::WriteRow(double now)
+{
+	size_t mem = OS::GetProcessMemory();
+	memPeak = std::max(memPeak, mem);
+
+	csv << std::fixed << std::setprecision(3) <<
+		now << ',' << rowFrames << ',' <<
+		(rowFrames > 0 ? rowFrameTotal / rowFrames : 0.0) << ',' <<
+		rowFrameMax << ',' <<
+		(rowFrames > 0 ? static_cast<double>(rowSlices) / rowFrames : 0.0) <<
+		',' << rowLateElements << ',' << rowNetQueueMax << ',' <<
+		(mem / 1024) << '\n';
+
+	lastRow = now;
+	rowFrames = 0;
+	rowFrameTotal = 0;
+	rowFrameMax = 0;
+	rowSlices = 0;
+	rowLateElements = 0;
+	rowNetQueueMax = 0;
+}
+
+/**
+ * Write the summary for the whole session.
+ * This is called automatically when the telemetry is destroyed; calling it
+ * again has no effect.
+ */
+void SessionTelemetry::Summarize()
+{
+	if (summarized) return;
+	summarized = true;
+
+	if (rowFrames > 0) {
+		WriteRow(std::chrono::duration<double>(lastFrame - start).count());
+	}
+	csv.close();
+
+	double duration = primed ?
+		std::chrono::duration<double>(lastFrame - start).count() : 0;
+	size_t frames = frameTimes.size();
+
+	double frameTotal = 0;
+	for (float t : frameTimes) frameTotal += t;
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	MR_UInt64 sliceTotal = 0;
+	for (unsigned int s : slicesPerFrame) sliceTotal += s;
+	std::sort(slicesPerFrame.begin(), slicesPerFrame.end());
+
+	OS::path_t jsonPath = OS::path_t(basePath).concat(".json");
+	fs::ofstream json(jsonPath, std::ios::out | std::ios::trunc);
+	if (!json.is_open()) {
+		HR_LOG(error) << "Unable to write telemetry summary: " << jsonPath;
+		return;
+	}
+	json.imbue(OS::stdLocale);
+
+	std::string escTitle;
+	for (char c : title) {
+		if (c == '"' || c == '\\') escTitle += '\\';
+		if (static_cast<unsigned char>(c) >= 0x20) escTitle += c;
+	}
+
+	json << std::fixed << std::setprecision(3) <<
+		"{\n"
+		"  \"title\": \"" << escTitle << "\",\n"
+		"  \"duration_s\": " << duration << ",\n"
+		"  \"frames\": " << frames << ",\n"
+		"  \"frame_ms\": { " <<
+			"\"mean\": " << (frames > 0 ? frameTotal / frames : 0.0) <<
+			", \"p50\": " << Percentile(frameTimes, 50) <<
+			", \"p90\": " << Percentile(frameTimes, 90) <<
+			", \"p99\": " << Percentile(frameTimes, 99) <<
+			", \"max\": " << Percentile(frameTimes, 100) << " },\n"
+		"  \"slices_per_frame\": { " <<
+			"\"mean\": " <<
+				(frames > 0 ? static_cast<double>(sliceTotal) / frames : 0.0) <<
+			", \"p50\": " << Percentile(slicesPerFrame, 50) <<
+			", \"p99\": " << Percentile(slicesPerFrame, 99) <<
+			", \"max\": " << Percentile(slicesPerFrame, 100) << " },\n"
+		"  \"late_elements\": " << (last.lateElements) << ",\n"
+		"  \"net_queue_max\": " << netQueueMax << ",\n"
+		"  \"memory_peak_kb\": " << (memPeak / 1024) << "\n"
+		"}\n";
+
+	HR_LOG(info) << "Session telemetry: " << frames << " frames in " <<
+		duration << " s, frame time p50 " << Percentile(frameTimes, 50) <<
+		" p90 " << Percentile(frameTimes, 90) <<
+		" p99 " << Percentile(frameTimes, 99) <<
+		" max " << Percentile(frameTimes, 100) << " ms; summary: " <<
+		jsonPath;
+}
+
+}  // namespace Client
+}  // namespace HoverRace
@@ -0,0 +1,99 @@
+
+// SessionTelemetry.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <chrono>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include "../../engine/Util/OS.h"
+
+namespace HoverRace {
+namespace Client {
+
+/**
+ * Records how a session performed.
+ *
+ * Once per second, the frame times, simulation slices, late elements,
+ * network queue depth and memory usage are appended to a CSV file.
+ * When the session ends, the percentiles for the whole session are written
+ * to a JSON file with the same name.
+ *
+ * The files are written to the telemetry path from the config.
+ * @author Michael Imamura
+ */
+class SessionTelemetry
+{
+public:
+	SessionTelemetry(const std::string &title);
+	SessionTelemetry(const SessionTelemetry&) = delete;
+	~SessionTelemetry();
+
+	SessionTelemetry &operator=(const SessionTelemetry&) = delete;
+
+public:
+	/// Stats for a single frame.
+	struct Frame
+	{
+		MR_UInt64 slices;  ///< Total simulated slices so far.
+		MR_UInt64 lateElements;  ///< Total late elements so far.
+		int netQueueDepth;
+	};
+
+	void AddFrame(const Frame &frame);
+
+	void Summarize();
+
+private:
+	void WriteRow(double now);
+
+private:
+	using clock_t = std::chrono::steady_clock;
+
+	std::string title;
+	Util::OS::path_t basePath;  ///< Path of the output, minus the extension.
+	boost::filesystem::ofstream csv;
+	bool primed;  ///< Has the first frame been seen?
+	bool summarized;
+
+	clock_t::time_point start;
+	clock_t::time_point lastFrame;
+	double lastRow;  ///< Time of the last row, in seconds from the start.
+	Frame last;
+
+	// Since the last row.
+	unsigned int rowFrames;
+	double rowFrameTotal;
+	double rowFrameMax;
+	MR_UInt64 rowSlices;
+	MR_UInt64 rowLateElements;
+	int rowNetQueueMax;
+
+	// For the whole session.
+	std::vector<float> frameTimes;  ///< In ms.
+	std::vector<unsigned int> slicesPerFrame;
+	int netQueueMax;
+	size_t memPeak;
+};
+
+}  // namespace Client
+}  // namespace HoverRace
@@ -59,6 +59,7 @@ bool verboseLog = false;
 bool showFramerate = false;
 bool noAccel = false;
 bool skipStartupWarning = false;
+bool pipelineSim = false;
 std::string reqLocale;
 
 /**
@@ -130,6 +131,9 @@ bool ProcessCmdLine(int argc, char **argv)
 		else if (strcmp("--no-accel", arg) == 0) {
 			noAccel = true;
 		}
+		else if (strcmp("--pipeline-sim", arg) == 0) {
+			pipelineSim = true;
+		}
 		else if (strcmp("-s", arg) == 0) {
 			safeMode = true;
 		}
@@ -223,6 +227,7 @@ int main(int argc, char** argv)
 	cfg.runtime.showFramerate = showFramerate;
 	cfg.runtime.noAccel = noAccel;
 	cfg.runtime.skipStartupWarning = skipStartupWarning;
+	cfg.runtime.pipelineSim = pipelineSim;
 	cfg.runtime.initScripts = initScripts;
 	cfg.Load();
 	if (!reqLocale.empty()) {
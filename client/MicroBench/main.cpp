@@ -0,0 +1,1010 @@
+// main.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+// Microbenchmarks for the engine's hot kernels.
+//
+// Each benchmark runs a fixed number of operations on inputs generated from
+// a fixed seed, repeated a number of times, and reports the time per
+// operation along with a checksum of the results (so optimizations can be
+// checked for changes in behavior).  The results can be written as JSON so
+// runs from different commits can be diffed.
+//
+// Level::FindRoomForPoint needs a real level, so it uses the first installed
+// track unless another one is named with --track.  The Parcel benchmarks
+// load every installed track and ObjFac1.dat, with each parcel reader; the
+// ObjFac1.dat index pass (lazy resource loading) is measured on its own.
+// Reloading the track list is measured with and without the track index.
+
+#include "StdAfx.h"
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <type_traits>
+
+#include "../../engine/ColorTools/ColorTools.h"
+#include "../../engine/Exception.h"
+#include "../../engine/Model/ConcreteShape.h"
+#include "../../engine/Model/GameOptions.h"
+#include "../../engine/Model/Level.h"
+#include "../../engine/Model/ShapeCollisions.h"
+#include "../../engine/Model/Track.h"
+#include "../../engine/Model/TrackEntry.h"
+#include "../../engine/Model/TrackList.h"
+#include "../../engine/ObjFacTools/ResourceLib.h"
+#include "../../engine/Parcel/ClassicObjStream.h"
+#include "../../engine/Parcel/MemObjStream.h"
+#include "../../engine/Parcel/TrackBundle.h"
+#include "../../engine/Util/BitPacking.h"
+#include "../../engine/Util/Config.h"
+#include "../../engine/Util/Log.h"
+#include "../../engine/Util/OS.h"
+#include "../../engine/VideoServices/Bitmap.h"
+#include "../../engine/VideoServices/OffscreenVideoBuffer.h"
+#include "../../engine/VideoServices/Viewport3D.h"
+#include "../../engine/Engine.h"
+
+#include <hoverrace/hr-version.h>
+
+using namespace HoverRace;
+using namespace HoverRace::Util;
+namespace fs = boost::filesystem;
+
+namespace {
+
+OS::path_t sysCfgPath;
+OS::path_t mediaPath;
+int repeat = 15;
+std::string filter;
+std::string jsonPath;
+std::string trackName;
+bool verboseLog = false;
+
+/// Seed for all generated inputs, so every run does the same work.
+const unsigned int SEED = 12345;
+
+/**
+ * Process command-line options.
+ * @param argc The arg count.
+ * @param argv The original argument list.
+ * @return @c true if successful.
+ */
+bool ProcessCmdLine(int argc, char **argv)
+{
+	int i = 0;
+
+	// Pull the next argument as a string.
+	const auto argStr = [&](const char *name, const char *desc,
+		std::string &dest) -> bool
+	{
+		if (i < argc) {
+			dest = argv[i++];
+			return true;
+		}
+		std::cerr << "Expected: " << name << " (" << desc << ")" << std::endl;
+		return false;
+	};
+
+	for (i = 1; i < argc; ) {
+		const char *arg = argv[i++];
+
+		if (strcmp("--filter", arg) == 0) {
+			if (!argStr("--filter", "part of a benchmark name", filter)) {
+				return false;
+			}
+		}
+		else if (strcmp("--json", arg) == 0) {
+			if (!argStr("--json", "output file, or - for stdout", jsonPath)) {
+				return false;
+			}
+		}
+		else if (strcmp("--media-path", arg) == 0) {
+			if (i < argc) {
+				mediaPath = argv[i++];
+			}
+			else {
+				std::cerr << "Expected: --media-path (path to media files)" <<
+					std::endl;
+				return false;
+			}
+		}
+		else if (strcmp("--repeat", arg) == 0) {
+			if (i < argc) {
+				repeat = atoi(argv[i++]);
+			}
+			if (repeat <= 0) {
+				std::cerr << "Expected: --repeat (positive integer)" <<
+					std::endl;
+				return false;
+			}
+		}
+		else if (strcmp("--sys-cfg-path", arg) == 0) {
+			if (i < argc) {
+				sysCfgPath = argv[i++];
+			}
+			else {
+				std::cerr << "Expected: --sys-cfg-path (path to system "
+					"config files)" << std::endl;
+				return false;
+			}
+		}
+		else if (strcmp("--track", arg) == 0) {
+			if (!argStr("--track", "track name", trackName)) return false;
+		}
+		else if (strcmp("-v", arg) == 0 || strcmp("--verbose", arg) == 0) {
+			verboseLog = true;
+		}
+		else {
+			std::cerr << "Unknown option: " << arg << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Fold a value into a running FNV-1a hash.
+ * @param hash The running hash.
+ * @param val The value.
+ * @return The updated hash.
+ */
+MR_UInt64 Mix(MR_UInt64 hash, MR_UInt64 val)
+{
+	for (int i = 0; i < 8; i++, val >>= 8) {
+		hash ^= val & 0xff;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+const MR_UInt64 HASH_INIT = 14695981039346656037ull;
+
+/// The timings of a single benchmark.
+struct Result
+{
+	std::string name;
+	size_t ops;  ///< Operations per repetition.
+	double min;  ///< Nanoseconds per operation.
+	double median;
+	double mean;
+	double max;
+	MR_UInt64 checksum;
+};
+
+std::vector<Result> results;
+bool checksumChanged = false;  ///< Set if any benchmark was inconsistent.
+
+/**
+ * Run a benchmark, if it is selected by the filter.
+ * @param name The name of the benchmark.
+ * @param ops The number of operations performed by each call to @p fn.
+ * @param fn The benchmark.  Returns a checksum of the results, which must
+ *           be the same for every call.
+ */
+void Run(const std::string &name, size_t ops, std::function<MR_UInt64()> fn)
+{
+	if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+	using clock = std::chrono::steady_clock;
+
+	// Warm up the caches (and catch the first checksum).
+	MR_UInt64 checksum = fn();
+
+	std::vector<double> times;
+	times.reserve(static_cast<size_t>(repeat));
+	for (int i = 0; i < repeat; i++) {
+		auto start = clock::now();
+		MR_UInt64 sum = fn();
+		auto elapsed = clock::now() - start;
+
+		if (sum != checksum) {
+			std::cerr << name << ": checksum changed between runs" << std::endl;
+			checksumChanged = true;
+		}
+		times.push_back(
+			std::chrono::duration<double, std::nano>(elapsed).count() / ops);
+	}
+
+	std::sort(times.begin(), times.end());
+	double total = 0;
+	for (double t : times) total += t;
+
+	Result result;
+	result.name = name;
+	result.ops = ops;
+	result.min = times.front();
+	result.median = times[times.size() / 2];
+	result.mean = total / times.size();
+	result.max = times.back();
+	result.checksum = checksum;
+
+	std::cout << std::fixed << std::setprecision(2) <<
+		std::left << std::setw(44) << name << std::right <<
+		" min " << std::setw(10) << result.min <<
+		" median " << std::setw(10) << result.median <<
+		" ns/op, checksum " <<
+		std::hex << std::setw(16) << std::setfill('0') << checksum <<
+		std::dec << std::setfill(' ') << std::endl;
+
+	results.push_back(result);
+}
+
+/**
+ * A regular polygon, used as a room or feature.
+ */
+class BenchPolygon : public Model::PolygonShape
+{
+public:
+	BenchPolygon(int sides, MR_Int32 radius, MR_Int32 cx, MR_Int32 cy) :
+		xMin(cx), xMax(cx), yMin(cy), yMax(cy)
+	{
+		for (int i = 0; i < sides; i++) {
+			double angle = 2 * M_PI * i / sides;
+			MR_2DCoordinate v(
+				cx + static_cast<MR_Int32>(radius * cos(angle)),
+				cy + static_cast<MR_Int32>(radius * sin(angle)));
+			verts.push_back(v);
+			xMin = std::min(xMin, v.mX);
+			xMax = std::max(xMax, v.mX);
+			yMin = std::min(yMin, v.mY);
+			yMax = std::max(yMax, v.mY);
+		}
+		for (int i = 0; i < sides; i++) {
+			const auto &a = verts[i];
+			const auto &b = verts[(i + 1) % sides];
+			sideLens.push_back(static_cast<MR_Int32>(
+				hypot(b.mX - a.mX, b.mY - a.mY)));
+		}
+	}
+
+	MR_Int32 XMin() const override { return xMin; }
+	MR_Int32 XMax() const override { return xMax; }
+	MR_Int32 YMin() const override { return yMin; }
+	MR_Int32 YMax() const override { return yMax; }
+	MR_Int32 ZMin() const override { return 0; }
+	MR_Int32 ZMax() const override { return 5000; }
+
+	int VertexCount() const override { return static_cast<int>(verts.size()); }
+	MR_Int32 X(int i) const override { return verts[i].mX; }
+	MR_Int32 Y(int i) const override { return verts[i].mY; }
+	MR_Int32 SideLen(int i) const override { return sideLens[i]; }
+
+private:
+	std::vector<MR_2DCoordinate> verts;
+	std::vector<MR_Int32> sideLens;
+	MR_Int32 xMin, xMax, yMin, yMax;
+};
+
+/**
+ * Generate cylinders (hovercraft-sized) scattered around the origin.
+ * @param count The number of cylinders.
+ * @param spread The maximum distance from the origin on each axis.
+ * @return The cylinders.
+ */
+std::vector<Model::Cylinder> GenerateCylinders(size_t count, MR_Int32 spread)
+{
+	std::mt19937 rng(SEED);
+	std::uniform_int_distribution<MR_Int32> pos(-spread, spread);
+	std::uniform_int_distribution<MR_Int32> z(-500, 4500);
+
+	std::vector<Model::Cylinder> retv(count);
+	for (auto &cyl : retv) {
+		cyl.mAxis.mX = pos(rng);
+		cyl.mAxis.mY = pos(rng);
+		cyl.mRayLen = 600;
+		cyl.mZMin = z(rng);
+		cyl.mZMax = cyl.mZMin + 1000;
+	}
+	return retv;
+}
+
+void BenchShapeCollisions()
+{
+	using namespace Model;
+
+	const size_t COUNT = 4096;
+	BenchPolygon room(12, 10000, 0, 0);
+	auto actors = GenerateCylinders(COUNT, 12000);
+	auto obstacles = GenerateCylinders(COUNT + 1, 2000);
+
+	Run("ShapeCollisions.GetPolygonInclusion", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		for (const auto &actor : actors) {
+			hash = Mix(hash, GetPolygonInclusion(room, actor.mAxis));
+		}
+		return hash;
+	});
+
+	Run("ShapeCollisions.DetectActorContact", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		ContactSpec spec;
+		for (size_t i = 0; i < COUNT; i++) {
+			// Offset the obstacles so that roughly half are in contact.
+			if (DetectActorContact(&obstacles[i], &obstacles[i + 1], spec)) {
+				hash = Mix(hash, spec.mZMin);
+				hash = Mix(hash, spec.mZMax);
+			}
+		}
+		return hash;
+	});
+
+	Run("ShapeCollisions.DetectRoomContact", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		RoomContactSpec spec;
+		for (const auto &actor : actors) {
+			DetectRoomContact(&actor, &room, spec);
+			hash = Mix(hash, spec.mTouchingRoom);
+			hash = Mix(hash, spec.mNbWallContact);
+		}
+		return hash;
+	});
+}
+
+void BenchBitPack()
+{
+	using Pack = BitPack<32>;
+
+	// Field layouts like the ones used by the network messages.
+	struct Field { MR_UInt32 offset, len, precision; MR_Int32 value; };
+	std::vector<Field> fields;
+	std::mt19937 rng(SEED);
+	MR_UInt32 offset = 0;
+	while (true) {
+		MR_UInt32 len = 1 + rng() % 24;
+		if (offset + len > Pack::SIZE * 8) break;
+		Field field;
+		field.offset = offset;
+		field.len = len;
+		field.precision = rng() % 4;
+		field.value = static_cast<MR_Int32>(rng() % (1u << (len - 1))) <<
+			field.precision;
+		fields.push_back(field);
+		offset += len;
+	}
+
+	const int PACKS = 256;
+	std::vector<Pack> packs(PACKS);
+
+	Run("BitPack.Set", PACKS * fields.size(), [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		for (auto &pack : packs) {
+			pack.Clear();
+			for (const auto &field : fields) {
+				pack.Set(field.offset, field.len, field.precision, field.value);
+			}
+			hash = Mix(hash, static_cast<MR_UInt8>(pack.bdata[0]));
+		}
+		return hash;
+	});
+
+	Run("BitPack.Get", PACKS * fields.size(), [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		for (const auto &pack : packs) {
+			for (const auto &field : fields) {
+				hash = Mix(hash, static_cast<MR_UInt32>(
+					pack.Get(field.offset, field.len, field.precision)));
+			}
+		}
+		return hash;
+	});
+}
+
+void BenchObjStream()
+{
+	using Parcel::ClassicObjStream;
+	using Parcel::MemObjStream;
+
+	const size_t COUNT = 64 * 1024;
+
+	FILE *file = tmpfile();
+	if (!file) {
+		std::cerr << "Unable to create temporary file; "
+			"skipping ClassicObjStream" << std::endl;
+		return;
+	}
+
+	// The values are the same in every section, so the checksums of the
+	// reads can be compared to each other.
+	{
+		ClassicObjStream os(file, "microbench", true);
+		for (size_t i = 0; i < COUNT; i++) os.WriteUInt8(static_cast<MR_UInt8>(i));
+		for (size_t i = 0; i < COUNT; i++) os.WriteInt16(static_cast<MR_Int16>(i));
+		for (size_t i = 0; i < COUNT; i++) os.WriteInt32(static_cast<MR_Int32>(i));
+		for (size_t i = 0; i < COUNT; i++) os.WriteString("Microbench");
+	}
+	fflush(file);
+
+	const long uint8Start = 0;
+	const long int16Start = uint8Start + COUNT;
+	const long int32Start = int16Start + COUNT * 2;
+	const long stringStart = int32Start + COUNT * 4;
+
+	ClassicObjStream is(file, "microbench", false);
+
+	Run("ClassicObjStream.ReadUInt8", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		fseek(file, uint8Start, SEEK_SET);
+		MR_UInt8 val;
+		for (size_t i = 0; i < COUNT; i++) {
+			is.ReadUInt8(val);
+			hash = Mix(hash, val);
+		}
+		return hash;
+	});
+
+	Run("ClassicObjStream.ReadInt16", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		fseek(file, int16Start, SEEK_SET);
+		MR_Int16 val;
+		for (size_t i = 0; i < COUNT; i++) {
+			is.ReadInt16(val);
+			hash = Mix(hash, static_cast<MR_UInt16>(val));
+		}
+		return hash;
+	});
+
+	Run("ClassicObjStream.ReadInt32", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		fseek(file, int32Start, SEEK_SET);
+		MR_Int32 val;
+		for (size_t i = 0; i < COUNT; i++) {
+			is.ReadInt32(val);
+			hash = Mix(hash, static_cast<MR_UInt32>(val));
+		}
+		return hash;
+	});
+
+	std::vector<MR_Int32> arr(COUNT);
+
+	Run("ClassicObjStream.ReadArrayInt32", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		fseek(file, int32Start, SEEK_SET);
+		is.ReadArray(arr.data(), COUNT);
+		for (MR_Int32 val : arr) {
+			hash = Mix(hash, static_cast<MR_UInt32>(val));
+		}
+		return hash;
+	});
+
+	Run("ClassicObjStream.ReadString", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		fseek(file, stringStart, SEEK_SET);
+		std::string val;
+		for (size_t i = 0; i < COUNT; i++) {
+			is.ReadString(val);
+			hash = Mix(hash, val.length());
+		}
+		return hash;
+	});
+
+	// The same reads from memory, as done for memory-mapped parcels.
+	std::vector<char> buf(static_cast<size_t>(ftell(file)));
+	fseek(file, 0, SEEK_SET);
+	if (fread(buf.data(), buf.size(), 1, file) != 1) {
+		std::cerr << "Unable to read temporary file; "
+			"skipping MemObjStream" << std::endl;
+		fclose(file);
+		return;
+	}
+	fclose(file);
+
+	const char *bufEnd = buf.data() + buf.size();
+
+	Run("MemObjStream.ReadInt32", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		MemObjStream ms(buf.data() + int32Start, bufEnd, "microbench");
+		MR_Int32 val;
+		for (size_t i = 0; i < COUNT; i++) {
+			ms.ReadInt32(val);
+			hash = Mix(hash, static_cast<MR_UInt32>(val));
+		}
+		return hash;
+	});
+
+	Run("MemObjStream.ReadArrayInt32", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		MemObjStream ms(buf.data() + int32Start, bufEnd, "microbench");
+		ms.ReadArray(arr.data(), COUNT);
+		for (MR_Int32 val : arr) {
+			hash = Mix(hash, static_cast<MR_UInt32>(val));
+		}
+		return hash;
+	});
+
+	Run("MemObjStream.ReadString", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		MemObjStream ms(buf.data() + stringStart, bufEnd, "microbench");
+		std::string val;
+		for (size_t i = 0; i < COUNT; i++) {
+			ms.ReadString(val);
+			hash = Mix(hash, val.length());
+		}
+		return hash;
+	});
+}
+
+void BenchColorTools()
+{
+	const size_t COUNT = 16 * 1024;
+
+	std::mt19937 rng(SEED);
+	std::uniform_real_distribution<double> comp(0, 1);
+	std::vector<double> colors(COUNT * 3);
+	for (auto &c : colors) c = comp(rng);
+
+	Run("ColorTools.GetNearest", COUNT, [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		for (size_t i = 0; i < COUNT * 3; i += 3) {
+			hash = Mix(hash,
+				ColorTools::GetNearest(colors[i], colors[i + 1], colors[i + 2]));
+		}
+		return hash;
+	});
+}
+
+/**
+ * A checkerboard texture with a single sub-bitmap.
+ */
+class BenchBitmap : public VideoServices::Bitmap
+{
+public:
+	static const int RES = 64;
+
+	BenchBitmap() : data(RES * RES)
+	{
+		for (int x = 0; x < RES; x++) {
+			for (int y = 0; y < RES; y++) {
+				data[x * RES + y] = static_cast<MR_UInt8>(
+					(((x / 8) + (y / 8)) & 1) ? 32 + x : 96 + y);
+			}
+			columns[x] = &data[x * RES];
+		}
+	}
+
+	int GetWidth() const override { return 2000; }
+	int GetHeight() const override { return 2000; }
+	int GetMaxXRes() const override { return RES; }
+	int GetMaxYRes() const override { return RES; }
+	MR_UInt8 GetPlainColor() const override { return 64; }
+
+	int GetNbSubBitmap() const override { return 1; }
+	int GetXRes(int) const override { return RES; }
+	int GetYRes(int) const override { return RES; }
+	int GetXResShiftFactor(int) const override { return 0; }
+	int GetYResShiftFactor(int) const override { return 0; }
+	MR_UInt8 *GetBuffer(int) const override
+	{
+		return const_cast<MR_UInt8*>(data.data());
+	}
+	MR_UInt8 *GetColumnBuffer(int, int col) const override
+	{
+		return columns[col];
+	}
+	MR_UInt8 **GetColumnBufferTable(int) const override
+	{
+		return const_cast<MR_UInt8**>(columns);
+	}
+
+private:
+	std::vector<MR_UInt8> data;
+	MR_UInt8 *columns[RES];
+};
+
+/**
+ * Fold a sparse grid of the visible pixels into a running hash.
+ * This is cheap enough to not swamp the rendering time, but still catches
+ * most changes in the output.
+ * @param hash The running hash.
+ * @param vbuf The video buffer.
+ * @return The updated hash.
+ */
+MR_UInt64 HashFrame(MR_UInt64 hash, const VideoServices::VideoBuffer &vbuf)
+{
+	const int STEP = 7;
+	const MR_UInt8 *row = vbuf.GetBuffer();
+	for (int y = 0; y < vbuf.GetHeight();
+		y += STEP, row += vbuf.GetPitch() * STEP)
+	{
+		for (int x = 0; x < vbuf.GetWidth(); x += STEP) {
+			hash ^= row[x];
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+void BenchViewport3D()
+{
+	const int WIDTH = 640;
+	const int HEIGHT = 480;
+
+	// The camera spins in place in the middle of a square room.
+	const int VIEWS = 16;
+	const MR_Int32 HALF = 8000;
+	const MR_Int32 FLOOR = 0;
+	const MR_Int32 CEILING = 4000;
+
+	VideoServices::OffscreenVideoBuffer vbuf(WIDTH, HEIGHT);
+	VideoServices::Viewport3D view;
+	BenchBitmap bitmap;
+
+	const MR_2DCoordinate corners[] = {
+		{ -HALF, -HALF }, { HALF, -HALF }, { HALF, HALF }, { -HALF, HALF } };
+
+	view.SetZGenerations(TRUE);
+
+	// Must be called while the buffer is locked.
+	const auto setupView = [&](int i) {
+		view.Setup(&vbuf, 0, 0, WIDTH, HEIGHT, MR_PI / 2);
+		view.SetupCameraPosition(MR_3DCoordinate(1000, 500, 1700),
+			MR_NORMALIZE_ANGLE(i * MR_2PI / VIEWS), 0);
+		view.Clear(0);
+		view.ClearZ();
+	};
+
+	Run("Viewport3D.RenderHorizontalSurface", VIEWS * 2, [&]() {
+		VideoServices::VideoBuffer::Lock lock(vbuf);
+		MR_UInt64 hash = HASH_INIT;
+		for (int i = 0; i < VIEWS; i++) {
+			setupView(i);
+			view.RenderHorizontalSurface(4, corners, FLOOR, FALSE, &bitmap);
+			view.RenderHorizontalSurface(4, corners, CEILING, TRUE, &bitmap);
+			hash = HashFrame(hash, vbuf);
+		}
+		return hash;
+	});
+
+	Run("Viewport3D.RenderWallSurface", VIEWS * 4, [&]() {
+		VideoServices::VideoBuffer::Lock lock(vbuf);
+		MR_UInt64 hash = HASH_INIT;
+		for (int i = 0; i < VIEWS; i++) {
+			setupView(i);
+			for (int c = 0; c < 4; c++) {
+				const auto &a = corners[c];
+				const auto &b = corners[(c + 1) % 4];
+				// Only one winding faces the camera; the other is culled.
+				view.RenderWallSurface(
+					MR_3DCoordinate(a.mX, a.mY, CEILING),
+					MR_3DCoordinate(b.mX, b.mY, FLOOR), HALF * 2, &bitmap);
+				view.RenderWallSurface(
+					MR_3DCoordinate(b.mX, b.mY, CEILING),
+					MR_3DCoordinate(a.mX, a.mY, FLOOR), HALF * 2, &bitmap);
+			}
+			hash = HashFrame(hash, vbuf);
+		}
+		return hash;
+	});
+}
+
+/**
+ * Benchmark the room search on a real level.
+ * @return @c true if successful, @c false if the track could not be loaded.
+ */
+bool BenchLevel()
+{
+	auto &cfg = *Config::GetInstance();
+
+	if (trackName.empty()) {
+		Model::TrackList trackList;
+		trackList.Reload(cfg.GetTrackBundle());
+		if (trackList.begin() == trackList.end()) {
+			std::cerr << "No tracks installed; skipping Level" << std::endl;
+			return true;
+		}
+		trackName = (*trackList.begin())->name;
+	}
+
+	auto track = cfg.GetTrackBundle().OpenTrack(trackName);
+	if (!track) {
+		std::cerr << "Unable to open track: " << trackName << std::endl;
+		return false;
+	}
+	track->Load(false, Model::GameOptions());
+	const Model::Level *level = track->GetLevel();
+
+	int numRooms = level->GetRoomCount();
+	if (numRooms == 0) return true;
+
+	// Points scattered through each room, searched for starting from either
+	// the same room (the common case while moving) or a room further away.
+	struct Query { MR_2DCoordinate pos; int startRoom; };
+	std::vector<Query> queries;
+	std::mt19937 rng(SEED);
+	for (int room = 0; room < numRooms; room++) {
+		int numVerts = level->GetRoomVertexCount(room);
+		if (numVerts == 0) continue;
+
+		for (int i = 0; i < 8; i++) {
+			// A random blend of the vertices is inside a convex room.
+			MR_2DCoordinate pos;
+			double totalWeight = 0;
+			double x = 0, y = 0;
+			for (int v = 0; v < numVerts; v++) {
+				double weight = (rng() % 1000) + 1;
+				const auto &vert = level->GetRoomVertex(room, v);
+				x += vert.mX * weight;
+				y += vert.mY * weight;
+				totalWeight += weight;
+			}
+			pos.mX = static_cast<MR_Int32>(x / totalWeight);
+			pos.mY = static_cast<MR_Int32>(y / totalWeight);
+
+			Query query;
+			query.pos = pos;
+			query.startRoom = (i % 2 == 0) ? room :
+				static_cast<int>(rng() % static_cast<unsigned>(numRooms));
+			queries.push_back(query);
+		}
+	}
+
+	Run("Level.FindRoomForPoint", queries.size(), [&]() {
+		MR_UInt64 hash = HASH_INIT;
+		for (const auto &query : queries) {
+			hash = Mix(hash, static_cast<MR_UInt32>(
+				level->FindRoomForPoint(query.pos, query.startRoom)));
+		}
+		return hash;
+	});
+
+	return true;
+}
+
+/**
+ * Benchmark loading the shipped tracks and the object factory resources,
+ * with both the stream and the memory-mapped parcel readers.
+ * The checksums of the two readers should match.
+ */
+void BenchParcels()
+{
+	auto &cfg = *Config::GetInstance();
+
+	// Use a scratch track index so the user's own index is left alone.
+	const OS::path_t indexPath = fs::temp_directory_path() /
+		fs::unique_path("hr-microbench-%%%%-%%%%.idx");
+
+	Model::TrackList trackList;
+	trackList.Reload(cfg.GetTrackBundle(), indexPath);
+	std::vector<std::string> trackNames;
+	for (const auto &ent : trackList) {
+		trackNames.push_back(ent->name);
+	}
+
+	// The warm-up run (re)builds the track index, so the timed runs of the
+	// indexed reload only open tracks which are not in the index.
+	const bool origIndex = cfg.runtime.trackIndex;
+	for (bool indexed : { false, true }) {
+		cfg.runtime.trackIndex = indexed;
+		Run(std::string("Parcel.ReloadTrackList") +
+			(indexed ? ".Indexed" : ".Scan"), 1, [&]()
+		{
+			Model::TrackList list;
+			list.Reload(cfg.GetTrackBundle(), indexPath);
+
+			MR_UInt64 hash = HASH_INIT;
+			for (const auto &ent : list) {
+				for (char c : ent->name) {
+					hash = Mix(hash, static_cast<MR_UInt8>(c));
+				}
+				hash = Mix(hash, static_cast<MR_UInt32>(ent->sortingIndex));
+			}
+			return hash;
+		});
+	}
+	cfg.runtime.trackIndex = origIndex;
+
+	boost::system::error_code ec;
+	fs::remove(indexPath, ec);
+
+	const OS::path_t resPath = cfg.GetMediaPath("ObjFac1.dat");
+
+	const bool origMapped = cfg.runtime.mappedParcels;
+	const bool origLazy = cfg.runtime.lazyResources;
+	for (bool mapped : { false, true }) {
+		cfg.runtime.mappedParcels = mapped;
+		const std::string suffix = mapped ? ".Mapped" : ".Stream";
+
+		if (trackNames.empty()) {
+			std::cerr << "No tracks installed; skipping Parcel.LoadTracks" <<
+				std::endl;
+		}
+		else {
+			Run("Parcel.LoadTracks" + suffix, trackNames.size(), [&]() {
+				MR_UInt64 hash = HASH_INIT;
+				for (const auto &name : trackNames) {
+					auto track = cfg.GetTrackBundle().OpenTrack(name);
+					track->Load(false, Model::GameOptions());
+					const Model::Level *level = track->GetLevel();
+
+					int numRooms = level->GetRoomCount();
+					hash = Mix(hash, static_cast<MR_UInt32>(numRooms));
+					for (int room = 0; room < numRooms; room++) {
+						hash = Mix(hash, static_cast<MR_UInt32>(
+							level->GetRoomVertexCount(room)));
+						hash = Mix(hash, static_cast<MR_UInt32>(
+							level->GetFeatureCount(room)));
+					}
+				}
+				return hash;
+			});
+		}
+
+		cfg.runtime.lazyResources = false;
+		Run("Parcel.LoadResourceLib" + suffix, 1, [&]() {
+			ObjFacTools::ResourceLib lib(resPath);
+
+			// All of the resource IDs are below 2000 (see ObjFac1Res.h).
+			MR_UInt64 hash = HASH_INIT;
+			for (int id = 0; id < 2000; id++) {
+				if (auto bitmap = lib.GetBitmap(id)) {
+					hash = Mix(hash, static_cast<MR_UInt32>(id));
+					hash = Mix(hash, static_cast<MR_UInt32>(bitmap->GetWidth()));
+					hash = Mix(hash, static_cast<MR_UInt32>(bitmap->GetHeight()));
+				}
+				if (lib.GetActor(id)) {
+					hash = Mix(hash, static_cast<MR_UInt32>(id));
+				}
+			}
+			return hash;
+		});
+
+		// Only index the resources; nothing is loaded until it is requested.
+		cfg.runtime.lazyResources = true;
+		Run("Parcel.IndexResourceLib" + suffix, 1, [&]() {
+			ObjFacTools::ResourceLib lib(resPath);
+			return Mix(HASH_INIT, lib.GetSprite(0) ? 1u : 0u);
+		});
+	}
+	cfg.runtime.mappedParcels = origMapped;
+	cfg.runtime.lazyResources = origLazy;
+}
+
+/**
+ * Write a string as a JSON string literal.
+ * @param os The output stream.
+ * @param s The string.
+ */
+void OutputJsonString(std::ostream &os, const std::string &s)
+{
+	os << '"';
+	for (char c : s) {
+		if (c == '"' || c == '\\') os << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20) os << ' ';
+		else os << c;
+	}
+	os << '"';
+}
+
+/**
+ * Write the results as JSON.
+ * @param os The output stream.
+ */
+void OutputJson(std::ostream &os)
+{
+	os << "{\n  \"version\": ";
+	OutputJsonString(os, Config::GetInstance()->GetVersion());
+	os << ",\n  \"repeat\": " << repeat << ",\n  \"track\": ";
+	OutputJsonString(os, trackName);
+	os << ",\n  \"benchmarks\": [";
+
+	bool first = true;
+	for (const auto &result : results) {
+		os << (first ? "\n" : ",\n") << "    { \"name\": ";
+		first = false;
+		OutputJsonString(os, result.name);
+		os << std::fixed << std::setprecision(3) <<
+			", \"ops\": " << result.ops <<
+			", \"min_ns\": " << result.min <<
+			", \"median_ns\": " << result.median <<
+			", \"mean_ns\": " << result.mean <<
+			", \"max_ns\": " << result.max <<
+			", \"checksum\": \"" <<
+			std::hex << std::setw(16) << std::setfill('0') << result.checksum <<
+			std::dec << std::setfill(' ') << "\" }";
+	}
+	os << "\n  ]\n}\n";
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+	std::ios::sync_with_stdio(false);
+
+	if (!ProcessCmdLine(argc, argv)) {
+		std::cerr << "Usage: hr-microbench [--media-path PATH] "
+			"[--sys-cfg-path PATH] [--repeat N] [--filter NAME] "
+			"[--track NAME] [--json FILE|-]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Log::Init(verboseLog);
+
+	// No window is ever opened, but the engine still initializes SDL.
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+
+	auto &cfg = Config::Init(PACKAGE, HR_APP_VERSION,
+		HR_APP_VERSION_PRERELEASE, mediaPath, sysCfgPath);
+	cfg.runtime.silent = true;
+	cfg.Load();
+
+	// When writing JSON to stdout, keep the human-readable output out of it.
+	std::ostringstream discard;
+	std::streambuf *origCout = nullptr;
+	if (jsonPath == "-") {
+		origCout = std::cout.rdbuf(discard.rdbuf());
+	}
+
+	int retv = EXIT_SUCCESS;
+	try {
+		Engine engine{ PACKAGE_NAME };
+		ColorTools::Init();
+
+		BenchShapeCollisions();
+		BenchBitPack();
+		BenchObjStream();
+		BenchColorTools();
+		BenchViewport3D();
+		if (filter.empty() ||
+			std::string("Level.FindRoomForPoint").find(filter) !=
+				std::string::npos)
+		{
+			if (!BenchLevel()) {
+				retv = EXIT_FAILURE;
+			}
+		}
+		BenchParcels();
+	}
+	catch (Exception &ex) {
+		std::cerr << ex.what() << std::endl;
+		retv = EXIT_FAILURE;
+	}
+
+	// A benchmark whose result changes between runs can't be trusted.
+	if (checksumChanged) {
+		retv = EXIT_FAILURE;
+	}
+
+	if (origCout) {
+		std::cout.rdbuf(origCout);
+		OutputJson(std::cout);
+	}
+	else if (!jsonPath.empty()) {
+		std::ofstream os(jsonPath, std::ios::out | std::ios::trunc);
+		if (!os.is_open()) {
+			std::cerr << "Unable to write: " << jsonPath << std::endl;
+			return EXIT_FAILURE;
+		}
+		OutputJson(os);
+	}
+
+	return retv;
+}
@@ -0,0 +1,484 @@
+// main.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+// Headless benchmark for the legacy 3D renderer.
+//
+// Loads each track, flies the camera along a few deterministic paths and
+// renders every frame into an offscreen video buffer, then reports the
+// frame time distribution and a hash of the rendered pixels (so renderer
+// optimizations can be checked for regressions in the output).
+// By default each track is rendered once with the column texture layout and
+// once with the tiled layout, along with the L1 data cache misses per frame
+// where the platform can count them; the two must render the same pixels.
+// The user's config file is not loaded, so every run uses the defaults.
+
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+#include "../../engine/Exception.h"
+#include "../../engine/Model/GameOptions.h"
+#include "../../engine/Model/Level.h"
+#include "../../engine/Model/RenderSnapshot.h"
+#include "../../engine/Model/Track.h"
+#include "../../engine/Model/TrackEntry.h"
+#include "../../engine/Model/TrackList.h"
+#include "../../engine/Parcel/TrackBundle.h"
+#include "../../engine/Util/Config.h"
+#include "../../engine/Util/Log.h"
+#include "../../engine/Util/OS.h"
+#include "../../engine/VideoServices/OffscreenVideoBuffer.h"
+#include "../../engine/Engine.h"
+#include "../Game2/Observer.h"
+
+#include <hoverrace/hr-version.h>
+
+using namespace HoverRace;
+using namespace HoverRace::Util;
+
+namespace {
+
+OS::path_t mediaPath;
+int width = 640;
+int height = 480;
+int framesPerPath = 64;
+std::string textureLayout = "both";
+bool verboseLog = false;
+std::vector<std::string> trackNames;
+
+/// Height of the camera above the floor (same as a craft's eye level).
+const MR_Int32 CAMERA_HEIGHT = 1700;
+
+/// Simulation time between frames (ms).
+const MR_SimulationTime FRAME_TIME = 16;
+
+/**
+ * Process command-line options.
+ * @param argc The arg count.
+ * @param argv The original argument list.
+ * @return @c true if successful.
+ */
+bool ProcessCmdLine(int argc, char **argv)
+{
+	int i = 0;
+
+	// Pull the next argument as a positive integer.
+	const auto argInt = [&](const char *name, int &dest) -> bool {
+		if (i < argc) {
+			dest = atoi(argv[i++]);
+			if (dest > 0) return true;
+		}
+		std::cerr << "Expected: " << name << " (positive integer)" <<
+			std::endl;
+		return false;
+	};
+
+	for (i = 1; i < argc; ) {
+		const char *arg = argv[i++];
+
+		if (strcmp("--frames", arg) == 0) {
+			if (!argInt("--frames", framesPerPath)) return false;
+		}
+		else if (strcmp("--height", arg) == 0) {
+			if (!argInt("--height", height)) return false;
+		}
+		else if (strcmp("--media-path", arg) == 0) {
+			if (i < argc) {
+				mediaPath = argv[i++];
+			}
+			else {
+				std::cerr << "Expected: --media-path (path to media files)" <<
+					std::endl;
+				return false;
+			}
+		}
+		else if (strcmp("--texture-layout", arg) == 0) {
+			if (i < argc) {
+				textureLayout = argv[i++];
+			}
+			if (textureLayout != "column" && textureLayout != "tiled" &&
+				textureLayout != "both")
+			{
+				std::cerr << "Expected: --texture-layout "
+					"(column, tiled, or both)" << std::endl;
+				return false;
+			}
+		}
+		else if (strcmp("-v", arg) == 0 || strcmp("--verbose", arg) == 0) {
+			verboseLog = true;
+		}
+		else if (strcmp("--width", arg) == 0) {
+			if (!argInt("--width", width)) return false;
+		}
+		else if (arg[0] == '-') {
+			std::cerr << "Unknown option: " << arg << std::endl;
+			return false;
+		}
+		else {
+			trackNames.emplace_back(arg);
+		}
+	}
+
+	return true;
+}
+
+/// A single camera position along a path.
+struct CameraPos
+{
+	MR_3DCoordinate pos;
+	MR_Angle orientation;
+	int room;
+};
+
+/**
+ * Generate the camera paths for a level.
+ *
+ * The first set of paths spins the camera in place at each starting
+ * position.  The last path visits the center of every room.
+ *
+ * @param level The level.
+ * @return The list of paths.
+ */
+std::vector<std::vector<CameraPos>> GeneratePaths(const Model::Level &level)
+{
+	std::vector<std::vector<CameraPos>> retv;
+
+	for (int i = 0; i < level.GetPlayerCount(); i++) {
+		std::vector<CameraPos> path;
+		path.reserve(framesPerPath);
+
+		CameraPos cam;
+		cam.pos = level.GetStartingPos(i);
+		cam.pos.mZ += CAMERA_HEIGHT;
+		cam.room = level.GetStartingRoom(i);
+		MR_Angle start = level.GetStartingOrientation(i);
+		for (int frame = 0; frame < framesPerPath; frame++) {
+			cam.orientation = MR_NORMALIZE_ANGLE(
+				start + (frame * MR_2PI) / framesPerPath);
+			path.push_back(cam);
+		}
+		retv.emplace_back(std::move(path));
+	}
+
+	std::vector<CameraPos> tour;
+	for (int room = 0; room < level.GetRoomCount() &&
+		static_cast<int>(tour.size()) < framesPerPath; room++)
+	{
+		int numVerts = level.GetRoomVertexCount(room);
+		if (numVerts == 0) continue;
+
+		MR_2DCoordinate center = { 0, 0 };
+		for (int i = 0; i < numVerts; i++) {
+			const MR_2DCoordinate &vert = level.GetRoomVertex(room, i);
+			center.mX += vert.mX / numVerts;
+			center.mY += vert.mY / numVerts;
+		}
+
+		// The centroid may be outside of a concave room.
+		int centerRoom = level.FindRoomForPoint(center, room);
+		if (centerRoom < 0) continue;
+
+		MR_Int32 floor = level.GetRoomBottomLevel(centerRoom);
+		MR_Int32 ceiling = level.GetRoomTopLevel(centerRoom);
+
+		CameraPos cam;
+		cam.pos.mX = center.mX;
+		cam.pos.mY = center.mY;
+		cam.pos.mZ = floor + std::min(CAMERA_HEIGHT, (ceiling - floor) / 2);
+		cam.room = centerRoom;
+		cam.orientation = MR_NORMALIZE_ANGLE(room * (MR_2PI / 8));
+		tour.push_back(cam);
+	}
+	if (!tour.empty()) {
+		retv.emplace_back(std::move(tour));
+	}
+
+	return retv;
+}
+
+/**
+ * Fold the visible pixels of the buffer into a running FNV-1a hash.
+ * @param hash The running hash.
+ * @param vbuf The video buffer.
+ * @return The updated hash.
+ */
+MR_UInt64 HashFrame(MR_UInt64 hash, const VideoServices::VideoBuffer &vbuf)
+{
+	const MR_UInt8 *row = vbuf.GetBuffer();
+	for (int y = 0; y < vbuf.GetHeight(); y++, row += vbuf.GetPitch()) {
+		for (int x = 0; x < vbuf.GetWidth(); x++) {
+			hash ^= row[x];
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+/**
+ * Retrieve a percentile from a sorted list of frame times.
+ * @param sorted The frame times, in ascending order.
+ * @param pct The percentile (0 to 100).
+ * @return The frame time.
+ */
+double Percentile(const std::vector<double> &sorted, int pct)
+{
+	if (sorted.empty()) return 0;
+	size_t idx = (sorted.size() - 1) * pct / 100;
+	return sorted[idx];
+}
+
+/**
+ * Counts the L1 data cache read misses of this thread, where supported
+ * (currently Linux only, and only if perf events are permitted).
+ */
+class CacheMissCounter
+{
+public:
+	CacheMissCounter() : fd(-1)
+	{
+#		ifdef __linux__
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_L1D |
+				(PERF_COUNT_HW_CACHE_OP_READ << 8) |
+				(PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#		endif
+	}
+
+	~CacheMissCounter()
+	{
+#		ifdef __linux__
+			if (fd >= 0) close(fd);
+#		endif
+	}
+
+	CacheMissCounter(const CacheMissCounter&) = delete;
+	CacheMissCounter &operator=(const CacheMissCounter&) = delete;
+
+public:
+	bool IsAvailable() const { return fd >= 0; }
+
+	void Start()
+	{
+#		ifdef __linux__
+			if (fd >= 0) {
+				ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#		endif
+	}
+
+	/**
+	 * Stop counting.
+	 * @return The number of misses since Start().
+	 */
+	MR_UInt64 Stop()
+	{
+		MR_UInt64 retv = 0;
+#		ifdef __linux__
+			if (fd >= 0) {
+				ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+				if (read(fd, &retv, sizeof(retv)) != sizeof(retv)) {
+					retv = 0;
+				}
+			}
+#		endif
+		return retv;
+	}
+
+private:
+	int fd;
+};
+
+/**
+ * Render all camera paths for a single track with one texture layout.
+ * @param name The name of the track.
+ * @param level The loaded level.
+ * @param paths The camera paths.
+ * @param tiled @c true to use the tiled texture layout.
+ * @param cacheMisses The cache miss counter.
+ * @return The hash of all the rendered frames.
+ */
+MR_UInt64 BenchLayout(const std::string &name, const Model::Level *level,
+	const std::vector<std::vector<CameraPos>> &paths, bool tiled,
+	CacheMissCounter &cacheMisses)
+{
+	Config::GetInstance()->runtime.tiledTextures = tiled;
+
+	VideoServices::OffscreenVideoBuffer vbuf(width, height);
+	Client::Observer observer;
+
+	// Nothing is simulated, so the elements stay where they were loaded.
+	Model::RenderSnapshot snapshot;
+	snapshot.Capture(*level);
+
+	std::vector<double> frameTimes;
+	MR_UInt64 totalMisses = 0;
+	MR_UInt64 hash = 14695981039346656037ull;
+	MR_SimulationTime simTime = 0;
+
+	for (const auto &path : paths) {
+		for (const auto &cam : path) {
+			using clock = std::chrono::high_resolution_clock;
+
+			clock::time_point start;
+			{
+				VideoServices::VideoBuffer::Lock lock(vbuf);
+				start = clock::now();
+				cacheMisses.Start();
+				observer.RenderCameraView(&vbuf, level, snapshot, cam.pos,
+					cam.orientation, cam.room, simTime, nullptr);
+				totalMisses += cacheMisses.Stop();
+			}
+			auto elapsed = clock::now() - start;
+
+			frameTimes.push_back(
+				std::chrono::duration<double, std::milli>(elapsed).count());
+			hash = HashFrame(hash, vbuf);
+			simTime += FRAME_TIME;
+		}
+	}
+
+	std::sort(frameTimes.begin(), frameTimes.end());
+	double total = 0;
+	for (double t : frameTimes) total += t;
+
+	std::cout << std::fixed << std::setprecision(3) <<
+		name << " (" << (tiled ? "tiled" : "column") << "): " <<
+		frameTimes.size() << " frames, " <<
+		"mean " << (frameTimes.empty() ? 0 : total / frameTimes.size()) <<
+		" p50 " << Percentile(frameTimes, 50) <<
+		" p90 " << Percentile(frameTimes, 90) <<
+		" p99 " << Percentile(frameTimes, 99) <<
+		" max " << (frameTimes.empty() ? 0 : frameTimes.back()) <<
+		" ms/frame, ";
+	if (cacheMisses.IsAvailable() && !frameTimes.empty()) {
+		std::cout << (totalMisses / frameTimes.size()) <<
+			" L1D misses/frame, ";
+	}
+	std::cout << "hash " <<
+		std::hex << std::setw(16) << std::setfill('0') << hash <<
+		std::dec << std::setfill(' ') << std::endl;
+
+	return hash;
+}
+
+/**
+ * Render all camera paths for a single track.
+ * @param name The name of the track.
+ * @return @c true if successful, @c false if the track could not be loaded
+ *         or the texture layouts rendered different pixels.
+ */
+bool BenchTrack(const std::string &name)
+{
+	auto track = Config::GetInstance()->GetTrackBundle().OpenTrack(name);
+	if (!track) {
+		std::cerr << "Unable to open track: " << name << std::endl;
+		return false;
+	}
+	track->Load(true, Model::GameOptions());
+	const Model::Level *level = track->GetLevel();
+
+	auto paths = GeneratePaths(*level);
+	CacheMissCounter cacheMisses;
+
+	MR_UInt64 columnHash = 0;
+	MR_UInt64 tiledHash = 0;
+	if (textureLayout != "tiled") {
+		columnHash = BenchLayout(name, level, paths, false, cacheMisses);
+	}
+	if (textureLayout != "column") {
+		tiledHash = BenchLayout(name, level, paths, true, cacheMisses);
+	}
+
+	// Both layouts must produce the same hash.
+	if (textureLayout == "both" && columnHash != tiledHash) {
+		std::cerr << name << ": texture layouts rendered different frames" <<
+			std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+	std::ios::sync_with_stdio(false);
+
+	if (!ProcessCmdLine(argc, argv)) {
+		std::cerr << "Usage: hr-renderbench [--media-path PATH] "
+			"[--width W] [--height H] [--frames N] "
+			"[--texture-layout column|tiled|both] [TRACK ...]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Log::Init(verboseLog);
+
+	// No window is ever opened, but the engine still initializes SDL.
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+
+	auto &cfg = Config::Init(PACKAGE, HR_APP_VERSION,
+		HR_APP_VERSION_PRERELEASE, mediaPath, OS::path_t());
+	cfg.runtime.silent = true;
+
+	int retv = EXIT_SUCCESS;
+	try {
+		Engine engine{ PACKAGE_NAME };
+
+		if (trackNames.empty()) {
+			Model::TrackList trackList;
+			trackList.Reload(cfg.GetTrackBundle());
+			for (const auto &entry : trackList) {
+				trackNames.push_back(entry->name);
+			}
+		}
+
+		for (const auto &name : trackNames) {
+			if (!BenchTrack(name)) {
+				retv = EXIT_FAILURE;
+			}
+		}
+	}
+	catch (Exception &ex) {
+		std::cerr << ex.what() << std::endl;
+		retv = EXIT_FAILURE;
+	}
+
+	return retv;
+}
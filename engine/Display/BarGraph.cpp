@@ -0,0 +1,60 @@
+// BarGraph.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "BarGraph.h"
+
+using namespace HoverRace::Util;
+
+namespace HoverRace {
+namespace Display {
+
+/**
+ * Constructor.
+ * @param size The size of the graph, where @c x is the width
+ *             and @c y is the height.
+ * @param numBars The number of bars.
+ * @param colors The color of each segment, from the bottom of each bar.
+ * @param layoutFlags Optional layout flags.
+ */
+BarGraph::BarGraph(const Vec2 &size, size_t numBars,
+	std::vector<Color> colors, uiLayoutFlags_t layoutFlags) :
+	SUPER(size, layoutFlags),
+	numBars(numBars), colors(std::move(colors)),
+	heights(numBars * this->colors.size(), 0.0)
+{
+}
+
+/**
+ * Set the segments of a single bar.
+ * @param idx The index of the bar (must be less than GetNumBars()).
+ * @param segments The heights of the segments (one per color),
+ *                 from the bottom.
+ */
+void BarGraph::SetBar(size_t idx, const double *segments)
+{
+	double *bar = heights.data() + (idx * colors.size());
+	if (!std::equal(segments, segments + colors.size(), bar)) {
+		std::copy(segments, segments + colors.size(), bar);
+		FireModelUpdate(Props::BARS);
+	}
+}
+
+}  // namespace Display
+}  // namespace HoverRace
@@ -0,0 +1,100 @@
+// BarGraph.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include "Color.h"
+
+#include "Box.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+	namespace Display {
+		class Display;
+	}
+}
+
+namespace HoverRace {
+namespace Display {
+
+/**
+ * A row of stacked bars, drawn as a single widget.
+ *
+ * Each bar is made up of the same number of segments, stacked from the
+ * bottom of the box upwards; each segment has its own color.  The bars are
+ * spread evenly over the width of the box, and anything above the top of
+ * the box is cut off.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare BarGraph : public Box
+{
+	using SUPER = Box;
+
+public:
+	struct Props
+	{
+		enum {
+			BARS = SUPER::Props::NEXT_,
+			NEXT_,  ///< First index for subclasses.
+		};
+	};
+
+public:
+	BarGraph(const Vec2 &size, size_t numBars, std::vector<Color> colors,
+		uiLayoutFlags_t layoutFlags = 0);
+	virtual ~BarGraph() { }
+
+public:
+	virtual void AttachView(Display &disp) { AttachViewDynamic(disp, this); }
+
+public:
+	size_t GetNumBars() const { return numBars; }
+	const std::vector<Color> &GetColors() const { return colors; }
+
+	/**
+	 * Retrieve the segments of a single bar.
+	 * @param idx The index of the bar (must be less than GetNumBars()).
+	 * @return The heights of the segments (one per color), from the bottom.
+	 */
+	const double *GetBar(size_t idx) const
+	{
+		return heights.data() + (idx * colors.size());
+	}
+	void SetBar(size_t idx, const double *segments);
+
+private:
+	size_t numBars;
+	std::vector<Color> colors;
+	std::vector<double> heights;
+};
+
+}  // namespace Display
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
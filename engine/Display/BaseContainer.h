@@ -92,8 +92,12 @@ protected:
 	{
 	public:
 		Child(BaseContainer &bc, std::shared_ptr<UiViewModel> child) :
-			child(std::move(child)), visible(true)
+			child(std::move(child)), visible(true), container(&bc)
 		{
+			// Let the container know when the child changes so it can
+			// determine if it needs to adjust its layout.
+			this->child->SetLayoutParent(&bc);
+
 			// Route focus request events back to the container.
 			focusRequestedConn.reset(
 				new boost::signals2::scoped_connection(
@@ -108,6 +112,12 @@ protected:
 		}
 		Child(const Child&) = delete;
 		Child(Child&&) = default;
+		~Child()
+		{
+			if (child && child->GetLayoutParent() == container) {
+				child->SetLayoutParent(nullptr);
+			}
+		}
 
 		Child &operator=(const Child&) = delete;
 		Child &operator=(Child&&) = default;
@@ -116,6 +126,7 @@ protected:
 		std::shared_ptr<UiViewModel> child;
 		bool visible;  ///< Used for filtering in subclasses.
 	private:
+		BaseContainer *container;
 		// scoped_connection is not movable, so we wrap in a unique_ptr.
 		std::unique_ptr<boost::signals2::scoped_connection> focusRequestedConn;
 		std::unique_ptr<boost::signals2::scoped_connection> focusRelinquishedConn;
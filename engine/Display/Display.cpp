@@ -24,6 +24,7 @@
 #include "../Util/Str.h"
 #include "../Util/Symbol.h"
 #include "TypeCase.h"
+#include "ViewModel.h"
 
 #include "Display.h"
 
@@ -64,30 +65,90 @@ const std::string TYPE_CASE_SYMBOL_INIT((const char*)Str::WU(COMMON_SYMBOLS));
 }  // namespace
 
 std::shared_ptr<TypeCase> Display::GetTypeCase(const UiFont &font)
+{
+	const UiFont normFont = NormalizeFont(font);
+
+	if (auto retv = FindTypeCase(normFont)) {
+		return retv;
+	}
+
+	auto retv = MakeTypeCase(normFont);
+	retv->Prepare(GetTypeCaseInitChars(normFont));
+
+	AddTypeCase(normFont, retv);
+	return retv;
+}
+
+/**
+ * Look up a TypeCase in the cache.
+ * @param font The normalized font.
+ * @return The TypeCase, or @c nullptr if not cached.
+ */
+std::shared_ptr<TypeCase> Display::FindTypeCase(const UiFont &font)
 {
 	auto iter = typeCases.find(font);
-	if (iter != typeCases.end()) {
-		if (auto retv = iter->second.lock()) {
-			return retv;
-		}
-		else {
-			typeCases.erase(iter);
-		}
+	if (iter == typeCases.end()) {
+		return std::shared_ptr<TypeCase>();
 	}
 
-	auto retv = MakeTypeCase(font);
+	auto retv = iter->second.lock();
+	if (!retv) {
+		typeCases.erase(iter);
+		return retv;
+	}
 
-	if (font.name == Config::GetInstance()->GetDefaultSymbolFontName()) {
-		retv->Prepare(TYPE_CASE_SYMBOL_INIT);
+	// Mark as most recently used.
+	auto riter = std::find(retainedTypeCases.begin(), retainedTypeCases.end(),
+		retv);
+	if (riter == retainedTypeCases.end()) {
+		retainedTypeCases.push_front(retv);
 	}
 	else {
-		retv->Prepare(TYPE_CASE_INIT);
+		retainedTypeCases.splice(retainedTypeCases.begin(),
+			retainedTypeCases, riter);
 	}
 
-	typeCases.emplace(font, retv);
 	return retv;
 }
 
+/**
+ * Add a new TypeCase to the cache.
+ * @param font The normalized font.
+ * @param typeCase The TypeCase.
+ */
+void Display::AddTypeCase(const UiFont &font,
+	std::shared_ptr<TypeCase> typeCase)
+{
+	typeCases[font] = typeCase;
+	retainedTypeCases.push_front(std::move(typeCase));
+
+	TrimTypeCaseCache();
+}
+
+/**
+ * Drop every TypeCase held by the cache.
+ *
+ * Subclasses must call this from their destructor before releasing the
+ * resources the TypeCase textures depend on (e.g., the renderer), since the
+ * base destructor runs too late.
+ */
+void Display::ReleaseTypeCases()
+{
+	retainedTypeCases.clear();
+	typeCases.clear();
+}
+
+/**
+ * Retrieve the characters a new TypeCase is initialized with.
+ * @param font The normalized font.
+ * @return The characters (UTF-8).
+ */
+const std::string &Display::GetTypeCaseInitChars(const UiFont &font)
+{
+	return font.name == Config::GetInstance()->GetDefaultSymbolFontName() ?
+		TYPE_CASE_SYMBOL_INIT : TYPE_CASE_INIT;
+}
+
 /**
  * Clean up the cache of TypeCase instances.
  *
@@ -97,6 +158,8 @@ std::shared_ptr<TypeCase> Display::GetTypeCase(const UiFont &font)
  */
 void Display::CleanTypeCaseCache()
 {
+	TrimTypeCaseCache();
+
 	for (auto iter = typeCases.begin(); iter != typeCases.end();) {
 		if (iter->second.expired()) {
 			iter = typeCases.erase(iter);
@@ -107,6 +170,127 @@ void Display::CleanTypeCaseCache()
 	}
 }
 
+/**
+ * Release the least-recently-used TypeCase instances until the total number
+ * of backing textures fits in the budget.
+ * TypeCase instances that are still in use are never released.
+ */
+void Display::TrimTypeCaseCache()
+{
+	const size_t budget = static_cast<size_t>(
+		Config::GetInstance()->video.glyphCacheTextures);
+
+	size_t total = 0;
+	for (const auto &typeCase : retainedTypeCases) {
+		total += typeCase->CountTextures();
+	}
+
+	auto iter = retainedTypeCases.end();
+	while (total > budget && iter != retainedTypeCases.begin()) {
+		--iter;
+		if (iter->use_count() == 1) {
+			HR_LOG(debug) << "Evicting type case with " <<
+				(*iter)->CountTextures() << " texture(s).";
+			total -= (*iter)->CountTextures();
+			typeCaseEvictions++;
+			iter = retainedTypeCases.erase(iter);
+		}
+	}
+}
+
+/**
+ * Prepare the TypeCase instances for the standard UI fonts at the current
+ * UI scale, so that the glyphs are ready before the first screen that uses
+ * them.
+ */
+void Display::PrewarmTypeCases()
+{
+	const double textScale = Config::GetInstance()->video.textScale;
+
+	std::vector<UiFont> fonts;
+	for (UiFont font : {
+		styles.bodyFont, styles.bodyHeadFont, styles.bodyAsideFont,
+		styles.announcementHeadFont, styles.announcementBodyFont,
+		styles.formFont, styles.headingFont })
+	{
+		// Scale the same way as the text views, so the sizes match exactly.
+		font.size *= uiScale;
+		font.size *= textScale;
+		font = NormalizeFont(font);
+
+		auto iter = typeCases.find(font);
+		if (iter != typeCases.end() && !iter->second.expired()) continue;
+
+		if (std::find(fonts.begin(), fonts.end(), font) == fonts.end()) {
+			fonts.push_back(font);
+		}
+	}
+
+	if (!fonts.empty()) {
+		PrewarmFonts(fonts);
+	}
+}
+
+/**
+ * Prepare the TypeCase instances for a set of fonts.
+ *
+ * The default implementation prepares them immediately; subclasses may
+ * do the work in the background and add the TypeCase instances to the
+ * cache (see AddTypeCase()) when they are ready.
+ *
+ * @param fonts The normalized fonts that are not cached yet.
+ */
+void Display::PrewarmFonts(const std::vector<UiFont> &fonts)
+{
+	for (const auto &font : fonts) {
+		GetTypeCase(font);
+	}
+}
+
+/**
+ * Retrieve statistics for the TypeCase cache.
+ * @return The statistics.
+ */
+Display::TypeCaseStats Display::GetTypeCaseStats() const
+{
+	TypeCaseStats retv;
+	retv.evictions = typeCaseEvictions;
+	for (const auto &typeCase : retainedTypeCases) {
+		retv.typeCases++;
+		retv.textures += typeCase->CountTextures();
+		retv.glyphHits += typeCase->GetGlyphHits();
+		retv.glyphMisses += typeCase->GetGlyphMisses();
+	}
+	return retv;
+}
+
+/**
+ * Record the number of component layouts for the frame that just finished.
+ * Subclasses should call this once per frame in Flip().
+ */
+void Display::CountFrameLayouts()
+{
+	frameLayouts = ViewModel::TakeLayoutCount();
+}
+
+/**
+ * Output a stream of debug information describing the display.
+ * The output text may include newlines.
+ * @param [in,out] oss The output stream to write to.
+ * @return The same output stream as was passed in.
+ */
+std::ostream &Display::OutputDebugText(std::ostream &oss) const
+{
+	auto stats = GetTypeCaseStats();
+	oss << "Type cases: " << stats.typeCases << ", " <<
+		stats.textures << " textures\n"
+		"Glyph hits: " << stats.glyphHits <<
+		"  misses: " << stats.glyphMisses <<
+		"  evictions: " << stats.evictions << "\n"
+		"Layouts: " << frameLayouts << " per frame\n";
+	return oss;
+}
+
 void Display::OnDisplayConfigChanged()
 {
 	const auto &vidCfg = Config::GetInstance()->video;
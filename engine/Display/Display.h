@@ -39,6 +39,7 @@
 namespace HoverRace {
 	namespace Display {
 		class ActiveText;
+		class BarGraph;
 		class BaseContainer;
 		class Button;
 		class ClickRegion;
@@ -72,6 +73,7 @@ namespace Display {
  */
 class MR_DllDeclare Display :
 	public ViewAttacher<ActiveText>,
+	public ViewAttacher<BarGraph>,
 	public ViewAttacher<BaseContainer>,
 	public ViewAttacher<Button>,
 	public ViewAttacher<ClickRegion>,
@@ -87,18 +89,40 @@ class MR_DllDeclare Display :
 {
 public:
 	Display() : uiOrigin(0, 0), uiLayoutFlags(0), uiScale(1.0),
-		uiOffset(0, 0), uiScreenSize(1280, 720) { }
+		uiOffset(0, 0), uiScreenSize(1280, 720), typeCaseEvictions(0),
+		frameLayouts(0) { }
 	virtual ~Display() { }
 
 public:
 	/**
 	 * Retrieve or create the TypeCase for a particular font.
+	 *
+	 * Recently-used TypeCase instances are kept after they are no longer
+	 * used, as long as their backing textures fit in the configured budget.
+	 *
 	 * @param font The font.
 	 * @return The TypeCase, never @c nullptr.
 	 */
 	std::shared_ptr<TypeCase> GetTypeCase(const UiFont &font);
 
 	void CleanTypeCaseCache();
+	void PrewarmTypeCases();
+
+	/**
+	 * Statistics for the TypeCase cache.
+	 */
+	struct TypeCaseStats
+	{
+		TypeCaseStats() : typeCases(0), textures(0),
+			glyphHits(0), glyphMisses(0), evictions(0) { }
+
+		size_t typeCases;  ///< Number of cached TypeCase instances.
+		size_t textures;  ///< Total number of backing textures.
+		MR_UInt64 glyphHits;
+		MR_UInt64 glyphMisses;
+		size_t evictions;
+	};
+	TypeCaseStats GetTypeCaseStats() const;
 
 protected:
 	/**
@@ -111,6 +135,23 @@ protected:
 	 */
 	virtual std::shared_ptr<TypeCase> MakeTypeCase(const UiFont &font) = 0;
 
+	/**
+	 * Normalize a font, so that fonts which render the same way share the
+	 * same TypeCase.
+	 * @param font The font.
+	 * @return The normalized font (by default, the same font).
+	 */
+	virtual UiFont NormalizeFont(const UiFont &font) const { return font; }
+
+	virtual void PrewarmFonts(const std::vector<UiFont> &fonts);
+
+	std::shared_ptr<TypeCase> FindTypeCase(const UiFont &font);
+	void AddTypeCase(const UiFont &font, std::shared_ptr<TypeCase> typeCase);
+	static const std::string &GetTypeCaseInitChars(const UiFont &font);
+	void ReleaseTypeCases();
+private:
+	void TrimTypeCaseCache();
+
 public:
 	/**
 	 * Retrieve the legacy (8-bit) framebuffer.
@@ -173,6 +214,11 @@ public:
 	 */
 	virtual void Screenshot() = 0;
 
+	virtual std::ostream &OutputDebugText(std::ostream &oss) const;
+
+protected:
+	void CountFrameLayouts();
+
 public:
 	/**
 	 * Retrieve the current UI origin coordinates.
@@ -257,6 +303,9 @@ private:
 	Vec2 uiOffset;
 	Vec2 uiScreenSize;
 	std::unordered_map<UiFont, std::weak_ptr<TypeCase>> typeCases;
+	std::list<std::shared_ptr<TypeCase>> retainedTypeCases;  ///< Most recently used first.
+	size_t typeCaseEvictions;
+	unsigned int frameLayouts;  ///< Number of layouts in the last frame.
 	displayConfigChangedSignal_t displayConfigChangedSignal;
 	uiScaleChangedSignal_t uiScaleChangedSignal;
 
@@ -511,6 +511,24 @@ void FlexGrid::Reserve(size_t rowCapacity, size_t colCapacity)
 	}
 }
 
+/**
+ * Check if any of the cells have changed size since the last check.
+ * Only the cells whose contents changed are measured.
+ * @return @c true if the grid needs to be laid out again.
+ */
+bool FlexGrid::IsLayoutStale()
+{
+	// Every changed child is checked (not just up to the first resized
+	// one) so that none of them is left flagged.
+	bool stale = false;
+	for (auto &child : GetChildren()) {
+		if (child->child->TakeResized()) {
+			stale = true;
+		}
+	}
+	return stale;
+}
+
 void FlexGrid::Layout()
 {
 	std::vector<double> heights(rows.size(), 0.0);
@@ -590,6 +590,7 @@ public:
 	void Reserve(size_t rows, size_t cols);
 
 protected:
+	bool IsLayoutStale() override;
 	void Layout() override;
 
 public:
@@ -0,0 +1,90 @@
+// SdlBarGraphView.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "../BarGraph.h"
+#include "SdlDisplay.h"
+
+#include "SdlBarGraphView.h"
+
+namespace HoverRace {
+namespace Display {
+namespace SDL {
+
+void SdlBarGraphView::Render()
+{
+	CalcScreenBounds();
+
+	const auto &colors = model.GetColors();
+	const size_t numBars = model.GetNumBars();
+	const size_t numSegs = colors.size();
+	if (numBars == 0 || numSegs == 0) return;
+
+	const double scale = model.IsLayoutUnscaled() ?
+		1.0 : display.GetUiScale();
+	const double barW = screenSize.x / numBars;
+	const double bottom = screenPos.y + screenSize.y;
+
+	// Leave a gap between the bars, as long as they're wide enough.
+	const int drawW = std::max(1, static_cast<int>(barW) - 1);
+
+	rects.resize(numSegs);
+	for (auto &segRects : rects) {
+		segRects.clear();
+	}
+
+	for (size_t i = 0; i < numBars; i++) {
+		const double *bar = model.GetBar(i);
+		const int x = static_cast<int>(screenPos.x + barW * i);
+		double y = bottom;
+		for (size_t seg = 0; seg < numSegs && y > screenPos.y; seg++) {
+			double h = std::min(bar[seg] * scale, y - screenPos.y);
+			if (h <= 0) continue;
+			const int top = static_cast<int>(y - h);
+			const int ih = static_cast<int>(y) - top;
+			y -= h;
+			if (ih > 0) {
+				rects[seg].push_back(SDL_Rect{ x, top, drawW, ih });
+			}
+		}
+	}
+
+	SDL_Renderer *renderer = display.GetRenderer();
+	SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+	for (size_t seg = 0; seg < numSegs; seg++) {
+		const auto &segRects = rects[seg];
+		if (segRects.empty()) continue;
+
+		const Color color = colors[seg];
+		SDL_SetRenderDrawColor(renderer,
+			color.bits.r, color.bits.g, color.bits.b, color.bits.a);
+		SDL_RenderFillRects(renderer, segRects.data(),
+			static_cast<int>(segRects.size()));
+	}
+}
+
+Vec3 SdlBarGraphView::Measure()
+{
+	return model.GetSize().Promote();
+}
+
+}  // namespace SDL
+}  // namespace Display
+}  // namespace HoverRace
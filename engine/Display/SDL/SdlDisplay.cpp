@@ -27,6 +27,7 @@
 #include "../../Util/Str.h"
 #include "../../Exception.h"
 #include "../ActiveText.h"
+#include "../BarGraph.h"
 #include "../BaseContainer.h"
 #include "../Button.h"
 #include "../ClickRegion.h"
@@ -42,10 +43,12 @@
 #include "../UiFont.h"
 #include "../Wallpaper.h"
 #include "SdlActiveTextView.h"
+#include "SdlBarGraphView.h"
 #include "SdlBaseContainerView.h"
 #include "SdlButtonView.h"
 #include "SdlClickRegionView.h"
 #include "SdlFillBoxView.h"
+#include "SdlImageLoader.h"
 #include "SdlKeycapIconView.h"
 #include "SdlLabelView.h"
 #include "SdlPictureView.h"
@@ -86,6 +89,9 @@ namespace SDL {
 
 namespace {
 
+/// Glyphs rendered for the prewarmed type cases after each frame.
+const size_t PREWARM_GLYPHS_PER_FRAME = 32;
+
 /**
  * Defines aliases for font names.
  */
@@ -115,6 +121,12 @@ private:
 	std::unordered_map<std::string, std::string> map;
 };
 
+FontAliasMap &GetFontAliasMap()
+{
+	static FontAliasMap aliasMap;
+	return aliasMap;
+}
+
 /**
  * Wraps an istream in a SDL_RWops struct.
  */
@@ -369,6 +381,23 @@ bool ActivateFullscreen(SDL_Window *window, SDL_DisplayMode &mode)
 
 }  // namespace
 
+/**
+ * Glyphs of a TypeCase being rendered a few at a time between frames.
+ */
+struct SdlDisplay::TypeCasePrewarm
+{
+	TypeCasePrewarm() : chars(nullptr), pos(0) { }
+	~TypeCasePrewarm()
+	{
+		SdlTypeCase::FreeRasterized(glyphs);
+	}
+
+	UiFont font;
+	const std::string *chars;
+	size_t pos;  ///< Offset of the next character to render in chars.
+	SdlTypeCase::rasterGlyphs_t glyphs;
+};
+
 /**
  * Constructor.
  * This will create a new window with the specified title.
@@ -385,6 +414,8 @@ SdlDisplay::SdlDisplay(const std::string &windowTitle) :
 	SUPER::OnDisplayConfigChanged();
 	legacyDisplay->CreatePalette();
 
+	imageLoader.reset(new SdlImageLoader(&SdlDisplay::DecodeRes));
+
 	// Set window icon.
 	// We don't throw an exception if this fails since it's not critical.
 	const auto cfg = Config::GetInstance();
@@ -395,12 +426,24 @@ SdlDisplay::SdlDisplay(const std::string &windowTitle) :
 	else {
 		HR_LOG(error) << IMG_GetError();
 	}
+
+	PrewarmTypeCases();
 }
 
 SdlDisplay::~SdlDisplay()
 {
+	// The retained TypeCases own textures, so they must go before the
+	// renderer (the base destructor would be too late).
+	ReleaseTypeCases();
+
 	delete legacyDisplay;
 
+	// Cached textures must be released before the renderer.
+	imageLoader.reset();
+	FlushTextureCache();
+
+	typeCasePrewarms.clear();
+
 	for (auto &entry : loadedFonts) {
 		TTF_CloseFont(entry.second);
 	}
@@ -414,6 +457,11 @@ void SdlDisplay::AttachView(ActiveText &model)
 	model.SetView(std::unique_ptr<View>(new SdlActiveTextView(*this, model)));
 }
 
+void SdlDisplay::AttachView(BarGraph &model)
+{
+	model.SetView(std::unique_ptr<View>(new SdlBarGraphView(*this, model)));
+}
+
 void SdlDisplay::AttachView(BaseContainer &model)
 {
 	model.SetView(std::unique_ptr<View>(new SdlBaseContainerView(*this, model)));
@@ -475,6 +523,11 @@ void SdlDisplay::AttachView(Wallpaper &model)
 }
 
 std::shared_ptr<TypeCase> SdlDisplay::MakeTypeCase(const UiFont &font)
+{
+	return MakeSdlTypeCase(font);
+}
+
+std::shared_ptr<SdlTypeCase> SdlDisplay::MakeSdlTypeCase(const UiFont &font)
 {
 	// Decide texture size based on font size.
 	int sz;
@@ -491,36 +544,202 @@ std::shared_ptr<TypeCase> SdlDisplay::MakeTypeCase(const UiFont &font)
 	return std::make_shared<SdlTypeCase>(*this, font, sz, sz);
 }
 
+UiFont SdlDisplay::NormalizeFont(const UiFont &font) const
+{
+	// Aliases (e.g. the default font) share the TypeCase of the real font.
+	UiFont retv = font;
+	retv.name = GetFontAliasMap().Lookup(font.name);
+	return retv;
+}
+
+/**
+ * Queue the initial glyphs of a set of fonts to be rendered between frames.
+ *
+ * SDL_ttf (and FreeType underneath) may only be used from the main thread,
+ * so instead of rendering everything at once, a few glyphs are rendered
+ * after each frame (see UpdateTypeCasePrewarm()).  The TypeCase instances
+ * are added to the cache once all of their glyphs are ready.
+ *
+ * @param fonts The normalized fonts that are not cached yet.
+ */
+void SdlDisplay::PrewarmFonts(const std::vector<UiFont> &fonts)
+{
+	typeCasePrewarms.clear();
+	for (const auto &font : fonts) {
+		std::unique_ptr<TypeCasePrewarm> prewarm(new TypeCasePrewarm());
+		prewarm->font = font;
+		prewarm->chars = &GetTypeCaseInitChars(font);
+		typeCasePrewarms.emplace_back(std::move(prewarm));
+	}
+
+	HR_LOG(debug) << "Prewarming " << typeCasePrewarms.size() <<
+		" type case(s).";
+}
+
+/**
+ * Render the next few glyphs of the prewarmed type cases.
+ */
+void SdlDisplay::UpdateTypeCasePrewarm()
+{
+	if (typeCasePrewarms.empty()) return;
+
+	auto &prewarm = *typeCasePrewarms.front();
+
+	// Skip the fonts that were needed before they were ready.
+	if (!FindTypeCase(prewarm.font)) {
+		try {
+			prewarm.pos = SdlTypeCase::Rasterize(
+				LoadTtfFont(prewarm.font, false), *prewarm.chars,
+				prewarm.pos, PREWARM_GLYPHS_PER_FRAME, prewarm.glyphs);
+			if (prewarm.pos < prewarm.chars->size()) return;
+
+			auto typeCase = MakeSdlTypeCase(prewarm.font);
+			typeCase->AddRasterized(prewarm.glyphs);
+			AddTypeCase(prewarm.font, typeCase);
+		}
+		catch (Exception &ex) {
+			HR_LOG(error) << "Failed to prewarm font [" <<
+				prewarm.font << "]: " << ex.what();
+		}
+	}
+
+	typeCasePrewarms.erase(typeCasePrewarms.begin());
+}
+
 /**
  * Loads a texture resource.
+ *
+ * Textures are shared by resource ID (see Res::GetId()), so views showing
+ * the same image share a single texture.  Images are decoded in the
+ * background; the returned texture is an empty placeholder until the
+ * image is ready (see SdlTexture::IsPending()).  Textures that are no longer used
+ * by any view are kept around (least-recently-used first out) as long as
+ * they fit in the configured budget.
+ *
  * @param res The resource (may be @c nullptr).
  * @return The loaded resource.
  * @throw ResLoadExn
  */
 std::shared_ptr<SdlTexture> SdlDisplay::LoadRes(std::shared_ptr<Res<Texture>> res)
 {
-	SDL_Surface *surface = nullptr;
-
 	if (!res) {
-		// Return the default texture.
-		// Generally, this shouldn't happen.
-		// We generate a new instance of the default texture in case something
-		// modifies the texture with SDL_UpdateTexture().
-		surface = SDL_CreateRGBSurface(0, 2, 2, 32, 0, 0, 0, 0);
-		if (!surface) {
-			throw ResLoadExn(
-				std::string("Failed to create default texture surface: ") +
-				SDL_GetError());
+		return LoadDefaultTexture();
+	}
+
+	const std::string id = res->GetId();
+
+	auto iter = texCache.find(id);
+	if (iter != texCache.end()) {
+		texCacheStats.hits++;
+		texLru.splice(texLru.begin(), texLru, iter->second);
+		return iter->second->texture;
+	}
+
+	texCacheStats.misses++;
+
+	// The image is decoded in the background; until it is uploaded, the
+	// views will draw an empty placeholder.
+	auto texture = std::make_shared<SdlTexture>(*this,
+		CreatePlaceholderTexture(), true);
+	imageLoader->Enqueue(res, texture);
+	texCacheStats.pending++;
+
+	size_t bytes = 4;
+
+	texLru.emplace_front(id, texture, bytes);
+	texCache[id] = texLru.begin();
+	texCacheStats.entries++;
+	texCacheStats.bytes += bytes;
+
+	TrimTextureCache();
+
+	return texture;
+}
+
+/**
+ * Evict unused textures until the cache fits in the budget.
+ * Textures that are still in use by a view are never evicted.
+ */
+void SdlDisplay::TrimTextureCache()
+{
+	const size_t budget =
+		static_cast<size_t>(Config::GetInstance()->video.textureCacheSize) *
+		1024 * 1024;
+
+	auto iter = texLru.end();
+	while (texCacheStats.bytes > budget && iter != texLru.begin()) {
+		--iter;
+		if (iter->texture.use_count() == 1 && !iter->texture->IsPending()) {
+			texCacheStats.evictions++;
+			texCacheStats.entries--;
+			texCacheStats.bytes -= iter->bytes;
+			texCache.erase(iter->id);
+			iter = texLru.erase(iter);
 		}
+	}
+}
+
+/**
+ * Release all cached textures that are not currently in use.
+ * Textures still in use are forgotten by the cache (they will be released
+ * when their views are done with them).
+ */
+void SdlDisplay::FlushTextureCache()
+{
+	texLru.clear();
+	texCache.clear();
+	texCacheStats.entries = 0;
+	texCacheStats.bytes = 0;
+	texCacheStats.pending = 0;
+}
 
-#		ifdef _DEBUG
-			//TODO: Fill in the surface with a checkerboard pattern.
-#		endif
+/**
+ * Create the texture shown for a missing resource, bypassing the cache.
+ * Generally, this shouldn't happen.
+ * @return The texture.
+ * @throw ResLoadExn
+ */
+std::shared_ptr<SdlTexture> SdlDisplay::LoadDefaultTexture()
+{
+	// We generate a new instance of the default texture in case something
+	// modifies the texture with SDL_UpdateTexture().
+	SDL_Surface *surface = SDL_CreateRGBSurface(0, 2, 2, 32, 0, 0, 0, 0);
+	if (!surface) {
+		throw ResLoadExn(
+			std::string("Failed to create default texture surface: ") +
+			SDL_GetError());
 	}
-	else if (res->IsGenerated()) {
-		auto imageData = res->GetImageData();
+
+#	ifdef _DEBUG
+		//TODO: Fill in the surface with a checkerboard pattern.
+#	endif
+
+	SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+	SDL_FreeSurface(surface);
+	if (!texture) {
+		throw ResLoadExn(
+			std::string("Failed to create default texture: ") +
+			SDL_GetError());
+	}
+
+	return std::make_shared<SdlTexture>(*this, texture);
+}
+
+/**
+ * Decode a texture resource into a surface.
+ * This does not use the renderer, so it may be called from any thread.
+ * @param res The resource.
+ * @return The surface (never @c nullptr).
+ * @throw ResLoadExn
+ */
+SDL_Surface *SdlDisplay::DecodeRes(Res<Texture> &res)
+{
+	SDL_Surface *surface = nullptr;
+
+	if (res.IsGenerated()) {
+		auto imageData = res.GetImageData();
 		if (!imageData) {
-			throw ResLoadExn(res->GetId() + ": "
+			throw ResLoadExn(res.GetId() + ": "
 				"Generated image has no image data");
 		}
 
@@ -531,7 +750,7 @@ std::shared_ptr<SdlTexture> SdlDisplay::LoadRes(std::shared_ptr<Res<Texture>> re
 				break;
 			default: {
 				std::ostringstream oss;
-				oss << res->GetId() << ": Unsupported color depth: " <<
+				oss << res.GetId() << ": Unsupported color depth: " <<
 					imageData->depth;
 				throw ResLoadExn(oss.str());
 			}
@@ -543,35 +762,135 @@ std::shared_ptr<SdlTexture> SdlDisplay::LoadRes(std::shared_ptr<Res<Texture>> re
 			imageData->rMask, imageData->gMask,
 			imageData->bMask, imageData->aMask);
 		if (!surface) {
-			throw ResLoadExn(res->GetId() + ": " + SDL_GetError());
-		}
-
-		// Assign palette if 8-bit.
-		if (imageData->depth == 8) {
-			if (SDL_SetPaletteColors(surface->format->palette,
-				GetLegacyDisplay().GetPalette(), 0, 256) < 0)
-			{
-				throw ResLoadExn(res->GetId() + ": " + SDL_GetError());
-			}
+			throw ResLoadExn(res.GetId() + ": " + SDL_GetError());
 		}
 	}
 	else {
-		auto is = res->Open();
+		auto is = res.Open();
 		InputStreamRwOps ops(is.get());
 
 		surface = IMG_Load_RW(ops.ops, 1);
 		if (!surface) {
-			throw ResLoadExn(res->GetId() + ": " + IMG_GetError());
+			throw ResLoadExn(res.GetId() + ": " + IMG_GetError());
+		}
+	}
+
+	return surface;
+}
+
+/**
+ * Convert a decoded surface into a texture.
+ * @param res The resource the surface was decoded from.
+ * @param surface The surface (will be freed).
+ * @return The texture (never @c nullptr).
+ * @throw ResLoadExn
+ */
+SDL_Texture *SdlDisplay::UploadSurface(Res<Texture> &res, SDL_Surface *surface)
+{
+	// Generated 8-bit images use the legacy palette.
+	if (res.IsGenerated() && surface->format->BitsPerPixel == 8) {
+		if (SDL_SetPaletteColors(surface->format->palette,
+			GetLegacyDisplay().GetPalette(), 0, 256) < 0)
+		{
+			SDL_FreeSurface(surface);
+			throw ResLoadExn(res.GetId() + ": " + SDL_GetError());
 		}
 	}
 
 	SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
 	SDL_FreeSurface(surface);
 	if (!texture) {
-		throw ResLoadExn(res->GetId() + ": " + SDL_GetError());
+		throw ResLoadExn(res.GetId() + ": " + SDL_GetError());
 	}
 
-	return std::make_shared<SdlTexture>(*this, texture);
+	return texture;
+}
+
+/**
+ * Create an empty texture to stand in for an image that is being loaded.
+ * @return The texture (never @c nullptr).
+ * @throw ResLoadExn
+ */
+SDL_Texture *SdlDisplay::CreatePlaceholderTexture()
+{
+	SDL_Texture *texture = SDL_CreateTexture(renderer,
+		SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+	if (!texture) {
+		throw ResLoadExn(
+			std::string("Failed to create placeholder texture: ") +
+			SDL_GetError());
+	}
+
+	const MR_UInt32 pixel = 0;
+	SDL_UpdateTexture(texture, nullptr, &pixel, sizeof(pixel));
+
+	return texture;
+}
+
+/**
+ * Upload the images that have finished decoding in the background,
+ * and cancel the ones that are no longer needed.
+ */
+void SdlDisplay::UpdateTextureLoads()
+{
+	// Textures that are only referenced by the cache aren't used by any view,
+	// so there's no point in finishing them.
+	if (texCacheStats.pending > 0) {
+		for (auto iter = texLru.begin(); iter != texLru.end(); ) {
+			if (iter->texture->IsPending() && iter->texture.use_count() == 1) {
+				texCacheStats.pending--;
+				texCacheStats.cancelled++;
+				texCacheStats.entries--;
+				texCacheStats.bytes -= iter->bytes;
+				texCache.erase(iter->id);
+				iter = texLru.erase(iter);
+			}
+			else {
+				++iter;
+			}
+		}
+	}
+
+	for (auto &result : imageLoader->TakeResults()) {
+		auto texture = result.texture.lock();
+		if (!texture) {
+			if (result.surface) SDL_FreeSurface(result.surface);
+			continue;
+		}
+
+		SDL_Texture *loaded = nullptr;
+		if (result.surface) {
+			try {
+				loaded = UploadSurface(*result.res, result.surface);
+			}
+			catch (ResLoadExn &ex) {
+				result.error = ex.what();
+			}
+		}
+		if (!loaded) {
+			// Keep the placeholder so the view has something to draw.
+			HR_LOG(error) << "Failed to load texture: " << result.error;
+		}
+
+		texture->Resolve(loaded);
+
+		// The cache may have been flushed while the image was loading.
+		auto iter = texCache.find(result.res->GetId());
+		if (iter == texCache.end() || iter->second->texture != texture) {
+			continue;
+		}
+
+		texCacheStats.pending--;
+		if (loaded) {
+			int w = 0, h = 0;
+			SDL_QueryTexture(loaded, nullptr, nullptr, &w, &h);
+			size_t bytes = static_cast<size_t>(w) * static_cast<size_t>(h) * 4;
+			texCacheStats.bytes += bytes - iter->second->bytes;
+			iter->second->bytes = bytes;
+		}
+	}
+
+	TrimTextureCache();
 }
 
 void SdlDisplay::OnDesktopModeChanged(int width, int height)
@@ -585,6 +904,9 @@ void SdlDisplay::OnDisplayConfigChanged()
 
 	bool resChanged = (vidCfg.xRes != width || vidCfg.yRes != height);
 
+	// The texture cache budget may have changed.
+	TrimTextureCache();
+
 	//TODO: Determine what settings actually changed and decide if resources
 	// need to be reloaded.
 
@@ -600,12 +922,32 @@ void SdlDisplay::OnDisplayConfigChanged()
 		loadedFonts.clear();
 
 		SUPER::OnDisplayConfigChanged();
+
+		// Prepare the fonts for the new UI scale.
+		PrewarmTypeCases();
 	}
 }
 
 void SdlDisplay::Flip()
 {
 	SDL_RenderPresent(renderer);
+
+	CountFrameLayouts();
+	UpdateTextureLoads();
+	UpdateTypeCasePrewarm();
+}
+
+std::ostream &SdlDisplay::OutputDebugText(std::ostream &oss) const
+{
+	SUPER::OutputDebugText(oss);
+
+	const auto &stats = texCacheStats;
+	oss << "Texture cache: " << stats.entries << " textures, " <<
+		(stats.bytes / 1024) << " KB, " << stats.pending << " loading\n"
+		"Texture cache hits: " << stats.hits <<
+		"  misses: " << stats.misses <<
+		"  evictions: " << stats.evictions << '\n';
+	return oss;
 }
 
 void SdlDisplay::Screenshot()
@@ -767,8 +1109,30 @@ void SdlDisplay::ApplyVideoMode()
  */
 TTF_Font *SdlDisplay::LoadTtfFont(const UiFont &font, bool uiScale)
 {
-	static FontAliasMap aliasMap;
+	loadedFontKey key = GetTtfFontKey(font, uiScale);
+
+	auto iter = loadedFonts.find(key);
+	if (iter == loadedFonts.end()) {
+		TTF_Font *retv = OpenTtfFont(key);
+
+		loadedFonts.insert(loadedFonts_t::value_type(key, retv));
+
+		return retv;
+	}
+	else {
+		return iter->second;
+	}
+}
 
+/**
+ * Determine the font file and point size for a font.
+ * @param font The font specification.
+ * @param uiScale Apply the user-selected scaling.
+ * @return The font file name and point size.
+ */
+SdlDisplay::loadedFontKey SdlDisplay::GetTtfFontKey(const UiFont &font,
+	bool uiScale) const
+{
 	const Config *cfg = Config::GetInstance();
 
 	// Scale the font size to match the DPI we used in SDL_Pango.
@@ -777,30 +1141,32 @@ TTF_Font *SdlDisplay::LoadTtfFont(const UiFont &font, bool uiScale)
 	if (uiScale) dsize *= cfg->video.textScale;
 	int size = static_cast<int>(dsize / 75.0);
 
-	std::string fullFontName = aliasMap.Lookup(font.name);
+	std::string fullFontName = GetFontAliasMap().Lookup(font.name);
 	if (font.isBold()) fullFontName += "Bold";
 	if (font.isItalic()) fullFontName += "Oblique";
 	fullFontName += ".ttf";
-	loadedFontKey key(fullFontName, size);
-
-	auto iter = loadedFonts.find(key);
-	if (iter == loadedFonts.end()) {
-		OS::path_t fontPath = cfg->GetMediaPath();
-		fontPath /= Str::UP("fonts");
-		fontPath /= Str::UP(fullFontName);
 
-		TTF_Font *retv = TTF_OpenFont((const char*)Str::PU(fontPath), size);
-		if (!retv) {
-			throw Exception(TTF_GetError());
-		}
+	return loadedFontKey(fullFontName, size);
+}
 
-		loadedFonts.insert(loadedFonts_t::value_type(key, retv));
+/**
+ * Open a new instance of a TTF font, bypassing the cache.
+ * @param key The font file name and point size.
+ * @return The font (never @c nullptr); the caller must close it.
+ * @throws HoverRace::Exception The font could not be loaded.
+ */
+TTF_Font *SdlDisplay::OpenTtfFont(const loadedFontKey &key) const
+{
+	OS::path_t fontPath = Config::GetInstance()->GetMediaPath();
+	fontPath /= Str::UP("fonts");
+	fontPath /= Str::UP(key.first);
 
-		return retv;
-	}
-	else {
-		return iter->second;
+	TTF_Font *retv = TTF_OpenFont((const char*)Str::PU(fontPath), key.second);
+	if (!retv) {
+		throw Exception(TTF_GetError());
 	}
+
+	return retv;
 }
 
 /**
@@ -41,7 +41,9 @@
 namespace HoverRace {
 	namespace Display {
 		namespace SDL {
+			class SdlImageLoader;
 			class SdlTexture;
+			class SdlTypeCase;
 		}
 		class Label;
 		class Texture;
@@ -68,6 +70,7 @@ public:
 public:
 	// ViewAttacher
 	void AttachView(ActiveText &model) override;
+	void AttachView(BarGraph &model) override;
 	void AttachView(BaseContainer &model) override;
 	void AttachView(Button &model) override;
 	void AttachView(ClickRegion &model) override;
@@ -83,8 +86,40 @@ public:
 
 protected:
 	std::shared_ptr<TypeCase> MakeTypeCase(const UiFont &font) override;
+	UiFont NormalizeFont(const UiFont &font) const override;
+	void PrewarmFonts(const std::vector<UiFont> &fonts) override;
+private:
+	std::shared_ptr<SdlTypeCase> MakeSdlTypeCase(const UiFont &font);
+	void UpdateTypeCasePrewarm();
 public:
 	std::shared_ptr<SdlTexture> LoadRes(std::shared_ptr<Res<Texture>> res);
+private:
+	std::shared_ptr<SdlTexture> LoadDefaultTexture();
+	static SDL_Surface *DecodeRes(Res<Texture> &res);
+	SDL_Texture *UploadSurface(Res<Texture> &res, SDL_Surface *surface);
+	SDL_Texture *CreatePlaceholderTexture();
+	void UpdateTextureLoads();
+	void TrimTextureCache();
+
+public:
+	/**
+	 * Statistics for the texture cache used by LoadRes().
+	 */
+	struct TextureCacheStats
+	{
+		TextureCacheStats() : hits(0), misses(0), evictions(0),
+			cancelled(0), entries(0), pending(0), bytes(0) { }
+
+		size_t hits;
+		size_t misses;
+		size_t evictions;
+		size_t cancelled;  ///< Loads dropped because no view needed them.
+		size_t entries;  ///< Number of cached textures (in use or not).
+		size_t pending;  ///< Number of textures still being decoded.
+		size_t bytes;  ///< Estimated memory used by the cached textures.
+	};
+	const TextureCacheStats &GetTextureCacheStats() const { return texCacheStats; }
+	void FlushTextureCache();
 
 public:
 	// Display
@@ -93,6 +128,7 @@ public:
 	void OnDisplayConfigChanged() override;
 	void Flip() override;
 	void Screenshot() override;
+	std::ostream &OutputDebugText(std::ostream &oss) const override;
 
 private:
 	void ApplyVideoMode();
@@ -107,6 +143,10 @@ public:
 public:
 	// Text-renderer-specific utilities.
 	TTF_Font *LoadTtfFont(const UiFont &font, bool uiScale = true);
+private:
+	using loadedFontKey = std::pair<std::string, int>;
+	loadedFontKey GetTtfFontKey(const UiFont &font, bool uiScale) const;
+	TTF_Font *OpenTtfFont(const loadedFontKey &key) const;
 
 public:
 	// SDL-specific utilities.
@@ -122,9 +162,27 @@ private:
 	int width, height;
 	VideoServices::VideoBuffer *legacyDisplay;
 
-	using loadedFontKey = std::pair<std::string, int>;
 	using loadedFonts_t = std::map<loadedFontKey, TTF_Font*>;
 	loadedFonts_t loadedFonts;
+
+	struct TypeCasePrewarm;
+	std::vector<std::unique_ptr<TypeCasePrewarm>> typeCasePrewarms;
+
+	struct CachedTexture
+	{
+		CachedTexture(const std::string &id,
+			std::shared_ptr<SdlTexture> texture, size_t bytes) :
+			id(id), texture(std::move(texture)), bytes(bytes) { }
+
+		std::string id;
+		std::shared_ptr<SdlTexture> texture;
+		size_t bytes;
+	};
+	using texLru_t = std::list<CachedTexture>;
+	texLru_t texLru;  ///< Cached textures, most recently used first.
+	std::unordered_map<std::string, texLru_t::iterator> texCache;
+	TextureCacheStats texCacheStats;
+	std::unique_ptr<SdlImageLoader> imageLoader;
 };
 
 }  // namespace SDL
@@ -0,0 +1,124 @@
+// SdlImageLoader.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "SdlTexture.h"
+
+#include "../../Util/Tracer.h"
+
+#include "SdlImageLoader.h"
+
+namespace HoverRace {
+namespace Display {
+namespace SDL {
+
+/**
+ * Constructor.
+ * @param decoder The function that decodes a resource into a surface.
+ *                This is called from the loader thread, and may throw
+ *                an exception to indicate failure.
+ */
+SdlImageLoader::SdlImageLoader(decoder_t decoder) :
+	decoder(std::move(decoder)), quit(false),
+	thread(&SdlImageLoader::ThreadProc, this)
+{
+}
+
+SdlImageLoader::~SdlImageLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		quit = true;
+	}
+	cond.notify_all();
+	thread.join();
+
+	for (auto &result : results) {
+		if (result.surface) SDL_FreeSurface(result.surface);
+	}
+}
+
+/**
+ * Queue a resource to be decoded.
+ * @param res The resource.
+ * @param texture The texture that will receive the image.
+ *                If it is released before the resource is decoded, the
+ *                request is dropped.
+ */
+void SdlImageLoader::Enqueue(std::shared_ptr<Res<Texture>> res,
+	std::weak_ptr<SdlTexture> texture)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queue.emplace_back();
+		auto &req = queue.back();
+		req.res = std::move(res);
+		req.texture = std::move(texture);
+	}
+	cond.notify_all();
+}
+
+/**
+ * Retrieve the requests that have been decoded since the last call.
+ * The caller takes ownership of the surfaces.
+ * @return The results, in the order they were decoded.
+ */
+SdlImageLoader::results_t SdlImageLoader::TakeResults()
+{
+	results_t retv;
+	std::lock_guard<std::mutex> lock(mutex);
+	std::swap(retv, results);
+	return retv;
+}
+
+void SdlImageLoader::ThreadProc()
+{
+	Util::Tracer::SetThreadName("image loader");
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;) {
+		cond.wait(lock, [&]{ return !queue.empty() || quit; });
+		if (quit) break;
+
+		Result req = std::move(queue.front());
+		queue.pop_front();
+
+		// Skip the request if nobody is waiting for it.
+		// We only check expired() so this thread never holds the last
+		// reference to a texture.
+		if (req.texture.expired()) continue;
+
+		lock.unlock();
+
+		try {
+			HR_TRACE_ZONE("decodeImage");
+			req.surface = decoder(*req.res);
+		}
+		catch (std::exception &ex) {
+			req.error = ex.what();
+		}
+
+		lock.lock();
+		results.emplace_back(std::move(req));
+	}
+}
+
+}  // namespace SDL
+}  // namespace Display
+}  // namespace HoverRace
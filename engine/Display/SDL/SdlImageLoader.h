@@ -0,0 +1,114 @@
+// SdlImageLoader.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <SDL2/SDL.h>
+
+#include "../Res.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+	namespace Display {
+		namespace SDL {
+			class SdlTexture;
+		}
+		class Texture;
+	}
+}
+
+namespace HoverRace {
+namespace Display {
+namespace SDL {
+
+/**
+ * Decodes texture resources into surfaces on a background thread.
+ *
+ * Only the decoding happens in the background; the surfaces are uploaded
+ * to textures by the display on the main thread.
+ *
+ * The loader only keeps weak references to the textures being loaded,
+ * so a request is dropped when nothing is waiting for the texture anymore.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare SdlImageLoader
+{
+public:
+	using decoder_t = std::function<SDL_Surface*(Res<Texture>&)>;
+
+	/**
+	 * A decoded (or failed) request.
+	 */
+	struct Result
+	{
+		Result() : surface(nullptr) { }
+
+		std::shared_ptr<Res<Texture>> res;
+		std::weak_ptr<SdlTexture> texture;
+		SDL_Surface *surface;  ///< The decoded surface (@c nullptr on error).
+		std::string error;  ///< The error message if decoding failed.
+	};
+	using results_t = std::vector<Result>;
+
+public:
+	SdlImageLoader(decoder_t decoder);
+	~SdlImageLoader();
+
+	SdlImageLoader(const SdlImageLoader&) = delete;
+	SdlImageLoader &operator=(const SdlImageLoader&) = delete;
+
+public:
+	void Enqueue(std::shared_ptr<Res<Texture>> res,
+		std::weak_ptr<SdlTexture> texture);
+	results_t TakeResults();
+
+private:
+	void ThreadProc();
+
+private:
+	decoder_t decoder;
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::deque<Result> queue;
+	results_t results;
+	bool quit;
+	std::thread thread;
+};
+
+}  // namespace SDL
+}  // namespace Display
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
@@ -77,10 +77,15 @@ void SdlLegacyDisplay::Flip()
 	if (legacySurface && texture) {
 		SDL_Renderer *renderer = sdlDisplay.GetRenderer();
 
+		// Only the part of the surface that was rendered to is converted;
+		// when the render scale is below 1.0, the renderer stretches it to
+		// fill the window.
+		SDL_Rect renderRect = { 0, 0, GetRenderWidth(), GetRenderHeight() };
+
 		// We can't use SDL_ConvertPixels to convert from an indexed format, so
 		// we use SDL_BlitSurface to do that, using the nativeSurface as a
 		// temporary buffer.
-		SDL_BlitSurface(legacySurface, nullptr, nativeSurface, nullptr);
+		SDL_BlitSurface(legacySurface, &renderRect, nativeSurface, nullptr);
 
 		if (SDL_MUSTLOCK(nativeSurface)) {
 			if (SDL_LockSurface(nativeSurface) < 0) {
@@ -101,7 +106,7 @@ void SdlLegacyDisplay::Flip()
 		// streaming texture.
 		// Since the nativeSurface and destination texture use the same pixel
 		// format, this is effectively a memcpy with a some sanity checks.
-		if (SDL_ConvertPixels(nativeSurface->w, nativeSurface->h,
+		if (SDL_ConvertPixels(renderRect.w, renderRect.h,
 			nativeSurface->format->format, nativeSurface->pixels, nativeSurface->pitch,
 			destFmt, pixels, pitch) < 0)
 		{
@@ -114,7 +119,7 @@ void SdlLegacyDisplay::Flip()
 			SDL_UnlockSurface(nativeSurface);
 		}
 
-		SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+		SDL_RenderCopy(renderer, texture, &renderRect, nullptr);
 	}
 }
 
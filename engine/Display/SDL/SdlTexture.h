@@ -57,8 +57,9 @@ class MR_DllDeclare SdlTexture : public Texture
 
 public:
 	SdlTexture() = delete;
-	SdlTexture(SdlDisplay &display, SDL_Texture *texture) :
-		SUPER(), texture(texture), display(display) { }
+	SdlTexture(SdlDisplay &display, SDL_Texture *texture,
+		bool pending = false) :
+		SUPER(), texture(texture), display(display), pending(pending) { }
 	SdlTexture(const SdlTexture&) = delete;
 
 	virtual ~SdlTexture()
@@ -71,9 +72,30 @@ public:
 public:
 	SDL_Texture *Get() const { return texture; }
 
+	/**
+	 * Check if this is a placeholder for an image that is still loading.
+	 * @return @c true if still loading.
+	 */
+	bool IsPending() const { return pending; }
+
+	/**
+	 * Replace the placeholder with the loaded image.
+	 * @param loaded The loaded texture (may be @c nullptr to keep the
+	 *               placeholder if the image could not be loaded).
+	 */
+	void Resolve(SDL_Texture *loaded)
+	{
+		if (loaded) {
+			if (texture) SDL_DestroyTexture(texture);
+			texture = loaded;
+		}
+		pending = false;
+	}
+
 protected:
 	SDL_Texture *texture;
 	SdlDisplay &display;
+	bool pending;
 };
 
 }  // namespace SDL
@@ -66,21 +66,162 @@ MR_UInt32 SdlTypeCase::CountTextures() const
 }
 
 /**
- * Adds a glyph to the backing textures.
- * @param [in,out] ent The glyph entry to initialize.
+ * Render a single glyph.
+ * This only uses the given font, so it may be called from any thread as
+ * long as the font isn't being used by another thread.
+ * @param ttfFont The font.
  * @param s A single UTF-8 character.
  * @param cp The Unicode code point represented by the character.
- * @param added Buffer of added glyphs.
- * @return The same glyph entry that was passed in.
+ * @param[out] advance The width of the glyph when placed next to other glyphs.
+ * @return The rendered glyph, or @c nullptr if it could not be rendered.
  */
-GlyphEntry &SdlTypeCase::AddGlyph(GlyphEntry &ent, const std::string &s,
-	MR_UInt32 cp, std::string &added)
+SDL_Surface *SdlTypeCase::RenderGlyph(TTF_Font *ttfFont, const std::string &s,
+	MR_UInt32 cp, int &advance)
 {
-	TTF_Font *ttfFont = display.LoadTtfFont(font, false);
 	SDL_Color color = { 0xff, 0xff, 0xff, 0xff };
 	SDL_Surface *src = TTF_RenderUTF8_Blended(ttfFont, s.c_str(), color);
 	if (!src) {
 		// No need to log the error; SDL_ttf will log the error itself.
+		advance = 0;
+		return nullptr;
+	}
+	SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+
+	// Determine the character width (how far to advance when laying out each
+	// character in a line).  If we can't determine this, then we fall back
+	// to using the glyph width.
+	if (cp > 65535) {
+		advance = src->w;
+	}
+	else if (TTF_GlyphMetrics(ttfFont, static_cast<MR_UInt16>(cp),
+		nullptr, nullptr, nullptr, nullptr, &advance) < 0)
+	{
+		// No need to log the error; SDL_ttf will log the error itself.
+		advance = src->w;
+	}
+
+	return src;
+}
+
+/**
+ * Render the glyphs of a string ahead of time.
+ *
+ * This is used to prepare a type case a little at a time; the glyphs can
+ * then be added to the type case with AddRasterized().
+ * Whitespace is skipped, since it never needs a glyph.
+ *
+ * @param ttfFont The font.
+ * @param s The characters to render (UTF-8).
+ * @param pos The offset in @p s to start from.
+ * @param maxGlyphs The maximum number of glyphs to render.
+ * @param[out] glyphs The rendered glyphs are appended here.
+ * @return The offset to continue from, or the length of @p s if all of the
+ *         glyphs have been rendered.
+ */
+size_t SdlTypeCase::Rasterize(TTF_Font *ttfFont, const std::string &s,
+	size_t pos, size_t maxGlyphs, rasterGlyphs_t &glyphs)
+{
+	auto prev = s.begin() + static_cast<std::string::difference_type>(pos);
+	auto iter = prev;
+	auto end = s.end();
+	size_t count = 0;
+	try {
+		while (iter != end && count < maxGlyphs) {
+			MR_UInt32 cp = utf8::next(iter, end);
+			std::string buf(prev, iter);
+			prev = iter;
+
+			switch (cp) {
+				case 0:
+				case '\r':
+				case ' ':
+				case '\n':
+					break;
+
+				default:
+					if (cp > 65535) break;
+
+					glyphs.emplace_back();
+					auto &glyph = glyphs.back();
+					glyph.s = std::move(buf);
+					glyph.cp = cp;
+					glyph.surface = RenderGlyph(ttfFont, glyph.s, cp,
+						glyph.advance);
+					count++;
+			}
+		}
+	}
+	catch (utf8::exception&) {
+		// Only our own (valid) strings are rasterized.
+		return s.size();
+	}
+
+	return static_cast<size_t>(iter - s.begin());
+}
+
+/**
+ * Free the surfaces of rendered glyphs that were not added to a type case.
+ * @param glyphs The rendered glyphs (will be cleared).
+ */
+void SdlTypeCase::FreeRasterized(rasterGlyphs_t &glyphs)
+{
+	for (auto &glyph : glyphs) {
+		if (glyph.surface) SDL_FreeSurface(glyph.surface);
+	}
+	glyphs.clear();
+}
+
+/**
+ * Add glyphs that were rendered ahead of time (see Rasterize()).
+ * @param glyphs The rendered glyphs.  The type case takes ownership of the
+ *               surfaces, and the list is cleared.
+ */
+void SdlTypeCase::AddRasterized(rasterGlyphs_t &glyphs)
+{
+	std::string added;
+
+	for (auto iter = glyphs.begin(); iter != glyphs.end(); ++iter) {
+		SDL_Surface *src = iter->surface;
+		iter->surface = nullptr;
+
+		GlyphEntry &ent = GetGlyphEntry(iter->cp);
+		if (ent.IsInitialized() || !src) {
+			if (src) SDL_FreeSurface(src);
+			continue;
+		}
+
+		try {
+			PlaceGlyph(ent, iter->s, iter->cp, src, iter->advance, added);
+		}
+		catch (Exception&) {
+			// Free the glyphs that weren't added yet.
+			for (++iter; iter != glyphs.end(); ++iter) {
+				if (iter->surface) SDL_FreeSurface(iter->surface);
+			}
+			glyphs.clear();
+			UpdateMaps(added);
+			throw;
+		}
+	}
+	glyphs.clear();
+
+	UpdateMaps(added);
+}
+
+/**
+ * Adds a rendered glyph to the backing textures.
+ * @param [in,out] ent The glyph entry to initialize.
+ * @param s A single UTF-8 character.
+ * @param cp The Unicode code point represented by the character.
+ * @param src The rendered glyph (may be @c nullptr; will be freed).
+ * @param advance The width of the glyph when placed next to other glyphs.
+ * @param added Buffer of added glyphs.
+ * @return The same glyph entry that was passed in.
+ */
+GlyphEntry &SdlTypeCase::PlaceGlyph(GlyphEntry &ent, const std::string &s,
+	MR_UInt32 cp, SDL_Surface *src, int advance, std::string &added)
+{
+	if (!src) {
 		ent.page = 0;
 		auto &rect = ent.srcRect;
 		rect.x = 0;
@@ -89,7 +230,6 @@ GlyphEntry &SdlTypeCase::AddGlyph(GlyphEntry &ent, const std::string &s,
 		rect.h = 0;
 		return ent;
 	}
-	SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
 	int w = src->w;
 	int h = src->h;
 
@@ -136,19 +276,7 @@ GlyphEntry &SdlTypeCase::AddGlyph(GlyphEntry &ent, const std::string &s,
 
 	SDL_FreeSurface(src);
 
-	// Determine the character width (how far to advance when laying out each
-	// character in a line).  If we can't determine this, then we fall back
-	// to using the glyph width.
-	if (cp > 65535) {
-		ent.advance = w;
-	}
-	else if (TTF_GlyphMetrics(ttfFont, static_cast<MR_UInt16>(cp),
-		nullptr, nullptr, nullptr, nullptr, &ent.advance) < 0)
-	{
-		// No need to log the error; SDL_ttf will log the error itself.
-		ent.advance = w;
-	}
-
+	ent.advance = advance;
 	ent.cp = cp;
 	ent.page = curMap;
 	auto &rect = ent.srcRect;
@@ -164,6 +292,39 @@ GlyphEntry &SdlTypeCase::AddGlyph(GlyphEntry &ent, const std::string &s,
 	return ent;
 }
 
+/**
+ * Adds a glyph to the backing textures.
+ * @param [in,out] ent The glyph entry to initialize.
+ * @param s A single UTF-8 character.
+ * @param cp The Unicode code point represented by the character.
+ * @param added Buffer of added glyphs.
+ * @return The same glyph entry that was passed in.
+ */
+GlyphEntry &SdlTypeCase::AddGlyph(GlyphEntry &ent, const std::string &s,
+	MR_UInt32 cp, std::string &added)
+{
+	TTF_Font *ttfFont = display.LoadTtfFont(font, false);
+	int advance;
+	SDL_Surface *src = RenderGlyph(ttfFont, s, cp, advance);
+	return PlaceGlyph(ent, s, cp, src, advance, added);
+}
+
+/**
+ * Retrieve the entry for a glyph (initialized or not).
+ * @param cp The Unicode code point (up to 65535).
+ * @return The entry.
+ */
+GlyphEntry &SdlTypeCase::GetGlyphEntry(MR_UInt32 cp)
+{
+	// Glyphs are organized into "pages" of 256 glyphs.
+	MR_UInt32 pageIdx = cp / 256;
+	auto &page = glyphs[pageIdx];
+	if (!page) {
+		page.reset(new glyphPage_t());
+	}
+	return (*page)[cp % 256];
+}
+
 /**
  * Finds a glyph in the backing textures, creating it if necessary.
  * @param s A single UTF-8 character.
@@ -180,15 +341,35 @@ GlyphEntry &SdlTypeCase::FindGlyph(const std::string &s, MR_UInt32 cp,
 	}
 
 	// Find the GlyphEntry for this glyph.
-	// Glyphs are organized into "pages" of 256 glyphs.
-	MR_UInt32 pageIdx = cp / 256;
-	auto &page = glyphs[pageIdx];
-	if (!page) {
-		page.reset(new glyphPage_t());
+	GlyphEntry &ent = GetGlyphEntry(cp);
+
+	if (ent.IsInitialized()) {
+		glyphHits++;
+		return ent;
+	}
+	else {
+		glyphMisses++;
+		return AddGlyph(ent, s, cp, added);
+	}
+}
+
+/**
+ * Upload the glyphs that were added to the backing textures.
+ * @param added The glyphs that were added (UTF-8).
+ */
+void SdlTypeCase::UpdateMaps(const std::string &added)
+{
+	// All maps that need update will be at the end, so update in reverse
+	// order until we find one that didn't need updating.
+	for (auto miter = maps.rbegin(); miter != maps.rend(); ++miter) {
+		if (!(*miter)->Update()) break;
 	}
-	GlyphEntry &ent = (*page)[cp % 256];
 
-	return ent.IsInitialized() ? ent : AddGlyph(ent, s, cp, added);
+	if (!added.empty()) {
+		HR_LOG(debug) << "Type case [" << font << "] added "
+			"[" << utf8::distance(added.cbegin(), added.cend()) << "] "
+			"glyphs: " << added;
+	}
 }
 
 void SdlTypeCase::Prepare(const std::string &s, TypeLine *rects)
@@ -278,17 +459,7 @@ void SdlTypeCase::Prepare(const std::string &s, TypeLine *rects)
 		rects->height = cy + metrics.fontHeight;
 	}
 
-	// All maps that need update will be at the end, so update in reverse
-	// order until we find one that didn't need updating.
-	for (auto miter = maps.rbegin(); miter != maps.rend(); ++miter) {
-		if (!(*miter)->Update()) break;
-	}
-
-	if (!added.empty()) {
-		HR_LOG(debug) << "Type case [" << font << "] added "
-			"[" << utf8::distance(added.cbegin(), added.cend()) << "] "
-			"glyphs: " << added;
-	}
+	UpdateMaps(added);
 }
 
 void SdlTypeCase::Render(const TypeLine &s, const Color cm, int x, int y,
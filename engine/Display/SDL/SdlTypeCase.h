@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <SDL2/SDL_ttf.h>
+
 #include "../TypeCase.h"
 
 #if defined(_WIN32) && defined(HR_ENGINE_SHARED)
@@ -66,11 +68,37 @@ public:
 public:
 	MR_UInt32 CountTextures() const override;
 
+public:
+	/**
+	 * A glyph that has been rendered but not added to a texture yet.
+	 */
+	struct RasterGlyph
+	{
+		RasterGlyph() : cp(0), surface(nullptr), advance(0) { }
+
+		std::string s;  ///< The glyph, as a single UTF-8 character.
+		MR_UInt32 cp;  ///< The Unicode code point.
+		SDL_Surface *surface;  ///< The rendered glyph (may be @c nullptr).
+		int advance;
+	};
+	using rasterGlyphs_t = std::vector<RasterGlyph>;
+
+	static size_t Rasterize(TTF_Font *ttfFont, const std::string &s,
+		size_t pos, size_t maxGlyphs, rasterGlyphs_t &glyphs);
+	static void FreeRasterized(rasterGlyphs_t &glyphs);
+	void AddRasterized(rasterGlyphs_t &glyphs);
+
 private:
+	static SDL_Surface *RenderGlyph(TTF_Font *ttfFont, const std::string &s,
+		MR_UInt32 cp, int &advance);
+	GlyphEntry &PlaceGlyph(GlyphEntry &ent, const std::string &s,
+		MR_UInt32 cp, SDL_Surface *src, int advance, std::string &added);
 	GlyphEntry &AddGlyph(GlyphEntry &ent, const std::string &s,
 		MR_UInt32 cp, std::string &added);
+	GlyphEntry &GetGlyphEntry(MR_UInt32 cp);
 	GlyphEntry &FindGlyph(const std::string &s, MR_UInt32 cp,
 		std::string &added);
+	void UpdateMaps(const std::string &added);
 
 public:
 	void Prepare(const std::string &s, TypeLine *rects = nullptr) override;
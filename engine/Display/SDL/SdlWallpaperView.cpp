@@ -61,8 +61,8 @@ void CalcFill(SDL_Texture *tex, int destW, int destH, SDL_Rect &dest)
 }  // namespace
 
 SdlWallpaperView::SdlWallpaperView(SdlDisplay &disp, Wallpaper &model) :
-	SUPER(disp, model), fillChanged(true), opacityChanged(true),
-	computedAlpha(0), destRectPtr(nullptr)
+	SUPER(disp, model), texturePending(false), fillChanged(true),
+	opacityChanged(true), computedAlpha(0), destRectPtr(nullptr)
 {
 	displayConfigChangedConn =
 		disp.GetDisplayConfigChangedSignal().connect([&](int, int) {
@@ -92,6 +92,12 @@ void SdlWallpaperView::PrepareRender()
 {
 	if (!texture) {
 		texture = display.LoadRes(model.GetTexture());
+		texturePending = texture->IsPending();
+	}
+	else if (texturePending && !texture->IsPending()) {
+		// The real image has replaced the placeholder.
+		texturePending = false;
+		fillChanged = true;
 	}
 	if (fillChanged) {
 		switch (model.GetFill()) {
@@ -67,6 +67,7 @@ class MR_DllDeclare SdlWallpaperView : public SdlView<Wallpaper>
 		void Update();
 
 	private:
+		bool texturePending;
 		bool fillChanged;
 		bool opacityChanged;
 		MR_UInt8 computedAlpha;
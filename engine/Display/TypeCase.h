@@ -76,7 +76,8 @@ public:
 	 * @param height The height of the backing texture.
 	 */
 	TypeCase(const UiFont &font, int width, int height) :
-		font(font), width(width), height(height) { }
+		font(font), width(width), height(height),
+		glyphHits(0), glyphMisses(0) { }
 	TypeCase(const TypeCase&) = delete;
 
 	virtual ~TypeCase() { }
@@ -102,6 +103,18 @@ public:
 	 */
 	virtual MR_UInt32 CountTextures() const = 0;
 
+	/**
+	 * Count the number of glyph lookups that found an existing glyph.
+	 * @return The number of hits.
+	 */
+	MR_UInt64 GetGlyphHits() const { return glyphHits; }
+
+	/**
+	 * Count the number of glyph lookups that had to render a new glyph.
+	 * @return The number of misses.
+	 */
+	MR_UInt64 GetGlyphMisses() const { return glyphMisses; }
+
 public:
 	/**
 	 * Prepare a string to be rendered.
@@ -143,6 +156,8 @@ protected:
 	const UiFont font;
 	const int width;
 	const int height;
+	MR_UInt64 glyphHits;
+	MR_UInt64 glyphMisses;
 };
 
 /**
@@ -55,7 +55,8 @@ namespace Display {
 class MR_DllDeclare ViewModel
 {
 	public:
-		ViewModel() : needsLayout(true) { }
+		ViewModel() : needsLayout(true), changed(false), childChanged(false),
+			checkedSize(0, 0, 0), layoutParent(nullptr) { }
 		virtual ~ViewModel() { }
 
 	public:
@@ -70,6 +71,29 @@ class MR_DllDeclare ViewModel
 			dynamic_cast<ViewAttacher<T>&>(disp).AttachView(*self);
 		}
 
+	public:
+		/**
+		 * Set the container whose layout depends on this component.
+		 * When this component changes, the parent (and its own parents) will
+		 * check during PrepareRender() whether the size of this component
+		 * changed, and adjust their layout if so.
+		 * @param parent The parent (may be @c nullptr to detach).
+		 */
+		void SetLayoutParent(ViewModel *parent) { layoutParent = parent; }
+		ViewModel *GetLayoutParent() const { return layoutParent; }
+
+		/**
+		 * Retrieve and reset the number of times Layout() has been called
+		 * on any component since the last call.
+		 * @return The number of layouts.
+		 */
+		static unsigned int TakeLayoutCount()
+		{
+			unsigned int retv = layoutCount;
+			layoutCount = 0;
+			return retv;
+		}
+
 	protected:
 		/**
 		 * Indicate that the current layout is out-of-date and needs to be adjusted.
@@ -78,6 +102,18 @@ class MR_DllDeclare ViewModel
 		 */
 		void RequestLayout() { needsLayout = true; }
 
+		/**
+		 * Check if changes to child elements affect the current layout.
+		 *
+		 * This is called during the PrepareRender() phase when a child has
+		 * changed since the last layout, so that containers can avoid
+		 * adjusting the layout if (for example) the sizes of the children are
+		 * unchanged (see TakeResized()).
+		 *
+		 * @return @c true if Layout() needs to be called.
+		 */
+		virtual bool IsLayoutStale() { return false; }
+
 		/**
 		 * Adjust the size and position of any child elements.
 		 *
@@ -104,13 +140,66 @@ class MR_DllDeclare ViewModel
 
 		void PrepareRender()
 		{
+			PrepareLayout();
+			if (view) view->PrepareRender();
+		}
+
+		/**
+		 * Check if the size of this component changed since the last check.
+		 *
+		 * Only components that changed since the last check are measured;
+		 * any pending layout is applied first so that the size is current.
+		 * Containers call this on their children from IsLayoutStale().
+		 *
+		 * @return @c true if the size changed.
+		 */
+		bool TakeResized()
+		{
+			if (!changed) return false;
+			changed = false;
+
+			PrepareLayout();
+			Vec3 size = Measure();
+			if (size == checkedSize) return false;
+			checkedSize = size;
+			return true;
+		}
+
+	private:
+		void PrepareLayout()
+		{
+			if (childChanged) {
+				childChanged = false;
+				if (IsLayoutStale()) {
+					needsLayout = true;
+				}
+			}
 			if (needsLayout) {
 				Layout();
+				layoutCount++;
 				needsLayout = false;
+				// Changes made by our own layout don't need to be re-checked.
+				childChanged = false;
 			}
-			if (view) view->PrepareRender();
 		}
 
+		/**
+		 * Flag this component and its parents to be checked for size changes.
+		 * The whole chain is flagged so that each parent checks its children
+		 * before its own layout, in the same PrepareRender() pass.
+		 */
+		void MarkChanged()
+		{
+			changed = true;
+			for (ViewModel *parent = layoutParent; parent;
+				parent = parent->layoutParent)
+			{
+				parent->childChanged = true;
+				parent->changed = true;
+			}
+		}
+
+	public:
 		void Render() { if (view) view->Render(); }
 
 	protected:
@@ -119,10 +208,19 @@ class MR_DllDeclare ViewModel
 		 * If a view is attached, it will be notified.
 		 * @param prop The model-specific ID of the property that changed.
 		 */
-		virtual void FireModelUpdate(int prop) { if (view) view->OnModelUpdate(prop); }
+		virtual void FireModelUpdate(int prop)
+		{
+			if (view) view->OnModelUpdate(prop);
+			MarkChanged();
+		}
 
 	private:
+		static unsigned int layoutCount;
 		bool needsLayout;
+		bool changed;  ///< Changed since the last TakeResized().
+		bool childChanged;  ///< A child changed since the last layout check.
+		Vec3 checkedSize;  ///< Size as of the last TakeResized().
+		ViewModel *layoutParent;
 		std::unique_ptr<View> view;
 };
 
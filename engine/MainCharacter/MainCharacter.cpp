@@ -198,7 +198,7 @@ unsigned int NextAllowedCraft(char gameOpts, unsigned int curCraft,
 
 MainCharacter::MainCharacter() :
 	Model::FreeElement(MAINCHAR_ID),
-	playerIdx(0), started(false), finished(false)
+	playerIdx(0), started(false), finished(false), signalQueue(nullptr)
 {
 	mMasterMode = TRUE;
 	mRoom = -1;
@@ -217,6 +217,11 @@ MainCharacter::MainCharacter() :
 	mYSpeedBeforeCollision = 0;
 	mOnFloor = FALSE;
 	mCabinOrientation = 0;						  // mOrientation; mOrientation is not set yet
+	mPrevCabinOrientation = 0;
+	mSimCabinOrientation = 0;
+	mRenderCabinOrientation = 0;
+	mRenderMotorOn = FALSE;
+	mRenderHoverModel = 0;
 	mOutOfControlDuration = 0;
 	mMissileRefillDuration = 0;
 
@@ -294,7 +299,16 @@ void MainCharacter::AddRenderer()
 void MainCharacter::Render(VideoServices::Viewport3D * pDest, MR_SimulationTime /*pTime */ )
 {
 	if (mRenderer)
-		mRenderer->Render(pDest, mPosition, mCabinOrientation, mMotorDisplay > 0, mHoverId, mHoverModel);
+		mRenderer->Render(pDest, mRenderPosition, mRenderCabinOrientation, mRenderMotorOn, mHoverId, mRenderHoverModel);
+}
+
+void MainCharacter::GetRenderBounds(MR_3DCoordinate &pCenter, MR_Int32 &pRay)
+{
+	FreeElement::GetRenderBounds(pCenter, pRay);
+
+	if (mRenderer) {
+		ExtendRenderBounds(pCenter, pRay, mRenderer->GetRay(mHoverModel));
+	}
 }
 
 /**
@@ -511,7 +525,7 @@ int MainCharacter::Simulate(MR_SimulationTime pDuration,
 		if(mMasterMode) {
 			if (!started) {
 				started = true;
-				startedSignal(this);
+				Emit([this]{ startedSignal(this); });
 			}
 			if((mMotorOnState) && (mFuelLevel > 0.0))
 				mMotorDisplay = 250;
@@ -818,6 +832,37 @@ const Model::ShapeInterface *MainCharacter::GetObstacleShape()
 	return &mCollisionShape;
 }
 
+void MainCharacter::SaveRenderState(int pRoom)
+{
+	FreeElement::SaveRenderState(pRoom);
+	mRenderCabinOrientation = mCabinOrientation;
+	mRenderMotorOn = mMotorDisplay > 0;
+	mRenderHoverModel = mHoverModel;
+}
+
+void MainCharacter::SavePrevState(int pRoom)
+{
+	FreeElement::SavePrevState(pRoom);
+	mPrevCabinOrientation = mCabinOrientation;
+}
+
+void MainCharacter::BeginInterpolation(double pAlpha, int pRoom)
+{
+	mSimCabinOrientation = mCabinOrientation;
+	if (CanInterpolate(pAlpha, pRoom)) {
+		mCabinOrientation = InterpolateAngle(mPrevCabinOrientation,
+			mCabinOrientation, pAlpha);
+	}
+
+	FreeElement::BeginInterpolation(pAlpha, pRoom);
+}
+
+void MainCharacter::EndInterpolation()
+{
+	FreeElement::EndInterpolation();
+	mCabinOrientation = mSimCabinOrientation;
+}
+
 void MainCharacter::ApplyEffect(const Model::ContactEffect *pEffect,
 	MR_SimulationTime pTime, MR_SimulationTime pDuration,
 	BOOL pValidDirection, MR_Angle pHorizontalDirection,
@@ -935,7 +980,7 @@ void MainCharacter::ApplyEffect(const Model::ContactEffect *pEffect,
 		switch (lLapCompleted->mType) {
 			case CheckPoint::eCheck1:
 				if (!mCheckPoint1 && !mCheckPoint2) {
-					checkpointSignal(this, 1);
+					Emit([this]{ checkpointSignal(this, 1); });
 					mCheckPoint1 = TRUE;
 					mCheckPoint2 = FALSE;
 				}
@@ -943,7 +988,7 @@ void MainCharacter::ApplyEffect(const Model::ContactEffect *pEffect,
 			case CheckPoint::eCheck2:
 				if (mCheckPoint1)
 					if (!mCheckPoint2) {
-						checkpointSignal(this, 2);
+						Emit([this]{ checkpointSignal(this, 2); });
 						mCheckPoint2 = TRUE;
 					}
 				break;
@@ -954,8 +999,10 @@ void MainCharacter::ApplyEffect(const Model::ContactEffect *pEffect,
 
 					// The finish line is the first checkpoint, but we fire
 					// a separate signal for convenience.
-					checkpointSignal(this, 0);
-					finishLineSignal(this);
+					Emit([this]{
+						checkpointSignal(this, 0);
+						finishLineSignal(this);
+					});
 
 					mLastLapDuration = pTime - mLastLapCompletion;
 					mLastLapCompletion = pTime;
@@ -1029,6 +1076,15 @@ MR_Angle MainCharacter::GetCabinOrientation() const
 	return mCabinOrientation;
 }
 
+/**
+ * Retrieve the cabin orientation saved by SaveRenderState().
+ * @return The orientation.
+ */
+MR_Angle MainCharacter::GetRenderCabinOrientation() const
+{
+	return mRenderCabinOrientation;
+}
+
 /**
  * Retrieve the relative amount of fuel remaining.
  * @return The fuel level, where 1.0 or higher is full and
@@ -1126,7 +1182,22 @@ void MainCharacter::Finish()
 {
 	if (!finished) {
 		finished = true;
-		finishedSignal(this);
+		Emit([this]{ finishedSignal(this); });
+	}
+}
+
+/**
+ * Fire a signal, or add it to the signal queue if one is set.
+ * @param fn The function that fires the signal.
+ * @see SetSignalQueue()
+ */
+void MainCharacter::Emit(std::function<void()> fn)
+{
+	if (signalQueue) {
+		signalQueue->emplace_back(std::move(fn));
+	}
+	else {
+		fn();
 	}
 }
 
@@ -129,6 +129,11 @@ private:
 
 	BOOL mOnFloor;
 	MR_Angle mCabinOrientation;
+	MR_Angle mPrevCabinOrientation;
+	MR_Angle mSimCabinOrientation;
+	MR_Angle mRenderCabinOrientation;  ///< Saved by SaveRenderState().
+	BOOL mRenderMotorOn;
+	unsigned int mRenderHoverModel;
 	MR_SimulationTime mOutOfControlDuration;  // Countdown
 
 	BOOL mFireDone;
@@ -187,6 +192,7 @@ public:
 	void AddRenderer() override;
 	void Render(VideoServices::Viewport3D *pDest,
 		MR_SimulationTime pTime) override;
+	void GetRenderBounds(MR_3DCoordinate &pCenter, MR_Int32 &pRay) override;
 
 	Model::ElementNetState GetNetState() const override;
 	void SetNetState(int pDataLen, const MR_UInt8 * pData) override;
@@ -204,6 +210,7 @@ public:
 
 	// State interogation functions
 	MR_Angle GetCabinOrientation() const;
+	MR_Angle GetRenderCabinOrientation() const;
 
 	double GetFuelLevel() const;
 	double GetAbsoluteSpeed() const;
@@ -234,6 +241,14 @@ protected:
 
 	const Model::ShapeInterface *GetObstacleShape() override;
 
+public:
+	void SaveRenderState(int pRoom) override;
+	void SavePrevState(int pRoom) override;
+	void BeginInterpolation(double pAlpha, int pRoom) override;
+	void EndInterpolation() override;
+
+protected:
+
 	// ContactEffectShapeInterface
 	void ApplyEffect(const Model::ContactEffect *pEffect,
 		MR_SimulationTime pTime, MR_SimulationTime pDuration,
@@ -263,9 +278,23 @@ public:
 	using finishLineSignal_t = boost::signals2::signal<void(MainCharacter*)>;
 	finishLineSignal_t &GetFinishLineSignal() { return finishLineSignal; }
 
+	using signalQueue_t = std::vector<std::function<void()>>;
+
+	/**
+	 * Queue the signals instead of firing them.
+	 * This is used when the character is simulated off the main thread,
+	 * since the signal handlers call into scripts and the HUD.
+	 * @param queue The queue, or @c nullptr to fire signals immediately.
+	 */
+	void SetSignalQueue(signalQueue_t *queue) { signalQueue = queue; }
+
+private:
+	void Emit(std::function<void()> fn);
+
 private:
 	bool started;
 	bool finished;
+	signalQueue_t *signalQueue;
 	startedSignal_t startedSignal;
 	finishedSignal_t finishedSignal;
 	checkpointSignal_t checkpointSignal;
@@ -52,6 +52,13 @@ public:
 		const MR_3DCoordinate &pPosition, MR_Angle pOrientation,
 		BOOL pMotorOn, int pHoverId, unsigned int pModel) = 0;
 
+	/**
+	 * Get the ray of the mesh drawn by Render() around the position.
+	 * @param pModel The hovercraft model.
+	 * @return The ray (mm).
+	 */
+	virtual MR_Int32 GetRay(unsigned int pModel) const = 0;
+
 	// Sound list
 	virtual VideoServices::ShortSound *GetLineCrossingSound() = 0;
 	virtual VideoServices::ShortSound *GetStartSound() = 0;
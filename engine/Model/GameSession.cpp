@@ -38,7 +38,8 @@ GameSession::GameSession(bool pAllowRendering) :
 	mAllowRendering(pAllowRendering),
 	mCurrentLevelNumber(-1),
 	mSimulationTime(-3000),  // 3 sec countdown
-	mLastSimulateCallTime(Util::OS::Time())
+	mLastSimulateCallTime(Util::OS::Time()),
+	mFixedSlice(0), mSliceCount(0), mLateElementCount(0)
 {
 }
 
@@ -87,6 +88,27 @@ MR_SimulationTime GameSession::GetSimulationTime() const
 	return mSimulationTime;
 }
 
+/**
+ * Select how the time between two calls to Simulate() is divided.
+ *
+ * By default, the time is simulated in slices of up to 15 ms, and whatever
+ * is left (if long enough) is simulated in a last, shorter slice, so the
+ * simulation always catches up with the clock.  With a fixed slice, only
+ * whole slices are simulated and the rest is carried over to the next call;
+ * the rendering can then make up for the difference with
+ * GetInterpolationAlpha() (see RenderSnapshot::Capture()).
+ *
+ * @param pSlice The slice length in ms (at least 10), or @c 0 for the
+ *               default behavior.
+ */
+void GameSession::SetFixedSlice(MR_SimulationTime pSlice)
+{
+	if (pSlice != 0 && pSlice < MR_MINIMUM_SIMULATION_SLICE) {
+		pSlice = MR_MINIMUM_SIMULATION_SLICE;
+	}
+	mFixedSlice = pSlice;
+}
+
 void GameSession::Simulate()
 {
 	Util::OS::timestamp_t lSimulateCallTime = Util::OS::Time();
@@ -111,16 +133,29 @@ void GameSession::Simulate()
 	   }
 	 */
 
-	while(lTimeToSimulate >= MR_SIMULATION_SLICE) {
-		SimulateFreeElems(mSimulationTime < 0 ? 0 : MR_SIMULATION_SLICE);
-		lTimeToSimulate -= MR_SIMULATION_SLICE;
-		mSimulationTime += MR_SIMULATION_SLICE;
+	if(mFixedSlice > 0) {
+		// Only whole slices; the rest is left for the next call
+		while(lTimeToSimulate >= mFixedSlice) {
+			SimulateFreeElems(mSimulationTime < 0 ? 0 : mFixedSlice);
+			mSliceCount++;
+			lTimeToSimulate -= mFixedSlice;
+			mSimulationTime += mFixedSlice;
+		}
 	}
+	else {
+		while(lTimeToSimulate >= MR_SIMULATION_SLICE) {
+			SimulateFreeElems(mSimulationTime < 0 ? 0 : MR_SIMULATION_SLICE);
+			mSliceCount++;
+			lTimeToSimulate -= MR_SIMULATION_SLICE;
+			mSimulationTime += MR_SIMULATION_SLICE;
+		}
 
-	if(lTimeToSimulate >= MR_MINIMUM_SIMULATION_SLICE) {
-		SimulateFreeElems(mSimulationTime < 0 ? 0 : lTimeToSimulate);
-		mSimulationTime += lTimeToSimulate;
-		lTimeToSimulate = 0;
+		if(lTimeToSimulate >= MR_MINIMUM_SIMULATION_SLICE) {
+			SimulateFreeElems(mSimulationTime < 0 ? 0 : lTimeToSimulate);
+			mSliceCount++;
+			mSimulationTime += lTimeToSimulate;
+			lTimeToSimulate = 0;
+		}
 	}
 
 	SimulateSurfaceElems(static_cast<MR_SimulationTime>(
@@ -129,6 +164,20 @@ void GameSession::Simulate()
 	mLastSimulateCallTime = lSimulateCallTime - lTimeToSimulate;
 }
 
+/**
+ * Determine how far the clock is past the last simulated state.
+ * @return The fraction of a slice, from @c 0.0 to @c 1.0 (always @c 1.0 if
+ *         the slice is not fixed; the simulation is then up to date).
+ */
+double GameSession::GetInterpolationAlpha() const
+{
+	if (mFixedSlice <= 0) return 1.0;
+
+	double lAlpha = static_cast<double>(
+		Util::OS::Time() - mLastSimulateCallTime) / mFixedSlice;
+	return lAlpha < 0.0 ? 0.0 : (lAlpha > 1.0 ? 1.0 : lAlpha);
+}
+
 void GameSession::SimulateLateElement(MR_FreeElementHandle pElement,
 	MR_SimulationTime pDuration, int pRoom)
 {
@@ -142,6 +191,8 @@ void GameSession::SimulateLateElement(MR_FreeElementHandle pElement,
 		// can't backtrack below 0
 		return;
 	}
+	mLateElementCount++;
+
 	// clock back
 	MR_SimulationTime lOriginalTime = mSimulationTime;
 	mSimulationTime -= lTimeToSimulate;
@@ -223,6 +274,7 @@ void GameSession::SimulateFreeElems(MR_SimulationTime pTimeToSimulate)
 
 		while(lElementHandle != NULL) {
 			MR_FreeElementHandle lNext = Level::GetNextFreeElement(lElementHandle);
+			Level::GetFreeElement(lElementHandle)->SavePrevState(lRoomIndex);
 			SimulateOneFreeElem(pTimeToSimulate, lElementHandle, lRoomIndex);
 			lElementHandle = lNext;
 		}
@@ -62,13 +62,21 @@ public:
 
 	void SetSimulationTime(MR_SimulationTime);
 	MR_SimulationTime GetSimulationTime() const;
+	void SetFixedSlice(MR_SimulationTime pSlice);
 	void Simulate();
 	void SimulateLateElement(MR_FreeElementHandle pElement,
 		MR_SimulationTime pDuration, int pRoom);
 
+	/// Retrieve the number of slices simulated since the session was created.
+	MR_UInt64 GetSliceCount() const { return mSliceCount; }
+	/// Retrieve the number of late (network) elements that were caught up.
+	MR_UInt64 GetLateElementCount() const { return mLateElementCount; }
+
 	Level *GetCurrentLevel() const;
 	const char *GetTitle() const;
 
+	double GetInterpolationAlpha() const;
+
 private:
 	bool LoadLevel(const Model::GameOptions &gameOpts);
 	void Clean();  // Clean up before destruction or clean-up
@@ -93,6 +101,9 @@ private:
 
 	MR_SimulationTime mSimulationTime;  ///< Time simulated since the session start
 	Util::OS::timestamp_t mLastSimulateCallTime;  ///< Time in ms obtained by timeGetTime
+	MR_SimulationTime mFixedSlice;  ///< Slice length if only whole slices are simulated, or 0.
+	MR_UInt64 mSliceCount;
+	MR_UInt64 mLateElementCount;
 };
 
 }  // namespace Model
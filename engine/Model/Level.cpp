@@ -505,10 +505,18 @@ void Level::Room::AudibleRoom::Serialize(ObjStream & pArchive)
 	if(pArchive.IsWriting()) {
 		pArchive << mNbVertexSources;
 
+		// Each vertex (4 bytes, little-endian) is followed by its coefficient.
+		std::vector<MR_UInt8> lBuf;
+		lBuf.reserve(static_cast<size_t>(mNbVertexSources) * 5);
 		for(lCounter = 0; lCounter < mNbVertexSources; lCounter++) {
-			pArchive << mVertexList[lCounter]
-				<< mSoundCoefficient[lCounter];
+			auto lVertex = static_cast<MR_UInt32>(mVertexList[lCounter]);
+			lBuf.push_back(static_cast<MR_UInt8>(lVertex));
+			lBuf.push_back(static_cast<MR_UInt8>(lVertex >> 8));
+			lBuf.push_back(static_cast<MR_UInt8>(lVertex >> 16));
+			lBuf.push_back(static_cast<MR_UInt8>(lVertex >> 24));
+			lBuf.push_back(mSoundCoefficient[lCounter]);
 		}
+		pArchive.WriteArray(lBuf.data(), lBuf.size());
 	}
 	else {
 		ASSERT(mVertexList == NULL);			  // Serialisation permited only once
@@ -519,9 +527,15 @@ void Level::Room::AudibleRoom::Serialize(ObjStream & pArchive)
 		mVertexList = new int[mNbVertexSources];
 		mSoundCoefficient = new BYTE[mNbVertexSources];
 
-		for(lCounter = 0; lCounter < mNbVertexSources; lCounter++) {
-			pArchive >> mVertexList[lCounter]
-				>> mSoundCoefficient[lCounter];
+		std::vector<MR_UInt8> lBuf(static_cast<size_t>(mNbVertexSources) * 5);
+		pArchive.ReadArray(lBuf.data(), lBuf.size());
+
+		const MR_UInt8 *lPtr = lBuf.data();
+		for(lCounter = 0; lCounter < mNbVertexSources; lCounter++, lPtr += 5) {
+			mVertexList[lCounter] = static_cast<MR_Int32>(
+				lPtr[0] | (lPtr[1] << 8) | (lPtr[2] << 16) |
+				(static_cast<MR_UInt32>(lPtr[3]) << 24));
+			mSoundCoefficient[lCounter] = lPtr[4];
 		}
 	}
 
@@ -598,11 +612,15 @@ void Level::Section::SerializeStructure(ObjStream & pArchive)
 		mMin.Serialize(pArchive);
 		mMax.Serialize(pArchive);
 
-		// Arrays
+		// Arrays (each vertex is followed by the length of its wall)
+		std::vector<MR_Int32> lVerts;
+		lVerts.reserve(static_cast<size_t>(mNbVertex) * 3);
 		for(lCounter = 0; lCounter < mNbVertex; lCounter++) {
-			mVertexList[lCounter].Serialize(pArchive);
-			pArchive << mWallLen[lCounter];
+			lVerts.push_back(mVertexList[lCounter].mX);
+			lVerts.push_back(mVertexList[lCounter].mY);
+			lVerts.push_back(mWallLen[lCounter]);
 		}
+		pArchive.WriteArray(lVerts.data(), lVerts.size());
 
 	}
 	else {
@@ -619,9 +637,13 @@ void Level::Section::SerializeStructure(ObjStream & pArchive)
 		mVertexList = new MR_2DCoordinate[mNbVertex];
 		mWallLen = new MR_Int32[mNbVertex];
 
+		std::vector<MR_Int32> lVerts(static_cast<size_t>(mNbVertex) * 3);
+		pArchive.ReadArray(lVerts.data(), lVerts.size());
+
 		for(lCounter = 0; lCounter < mNbVertex; lCounter++) {
-			mVertexList[lCounter].Serialize(pArchive);
-			pArchive >> mWallLen[lCounter];
+			mVertexList[lCounter].mX = lVerts[lCounter * 3];
+			mVertexList[lCounter].mY = lVerts[lCounter * 3 + 1];
+			mWallLen[lCounter] = lVerts[lCounter * 3 + 2];
 		}
 	}
 
@@ -678,23 +700,21 @@ void Level::Room::SerializeStructure(ObjStream & pArchive)
 		pArchive << mNbVisibleSurface;
 		pArchive << mNbAudibleRoom;
 
-		for(lCounter = 0; lCounter < mNbVertex; lCounter++) {
-			pArchive << mNeighborList[lCounter];
-		}
-
-		for(lCounter = 0; lCounter < mNbChild; lCounter++) {
-			pArchive << mChildList[lCounter];
-		}
-
-		for(lCounter = 0; lCounter < mNbVisibleRoom; lCounter++) {
-												  // List of the room that are visible from the current room
-			pArchive << mVisibleRoomList[lCounter];
-		}
+		pArchive.WriteArray(mNeighborList, static_cast<size_t>(mNbVertex));
+		pArchive.WriteArray(mChildList, static_cast<size_t>(mNbChild));
+		// List of the room that are visible from the current room
+		pArchive.WriteArray(mVisibleRoomList, static_cast<size_t>(mNbVisibleRoom));
 
+		// Each floor is followed by its ceiling; see SectionId::Serialize().
+		std::vector<MR_Int32> lSurfaces;
+		lSurfaces.reserve(static_cast<size_t>(mNbVisibleSurface) * 4);
 		for(lCounter = 0; lCounter < mNbVisibleSurface; lCounter++) {
-			mVisibleFloorList[lCounter].Serialize(pArchive);
-			mVisibleCeilingList[lCounter].Serialize(pArchive);
+			lSurfaces.push_back(mVisibleFloorList[lCounter].mType);
+			lSurfaces.push_back(mVisibleFloorList[lCounter].mId);
+			lSurfaces.push_back(mVisibleCeilingList[lCounter].mType);
+			lSurfaces.push_back(mVisibleCeilingList[lCounter].mId);
 		}
+		pArchive.WriteArray(lSurfaces.data(), lSurfaces.size());
 
 		for(lCounter = 0; lCounter < mNbAudibleRoom; lCounter++) {
 			mAudibleRoomList[lCounter].Serialize(pArchive);
@@ -727,22 +747,20 @@ void Level::Room::SerializeStructure(ObjStream & pArchive)
 			mAudibleRoomList = new AudibleRoom[mNbAudibleRoom];
 		}
 
-		for(lCounter = 0; lCounter < mNbVertex; lCounter++) {
-			pArchive >> mNeighborList[lCounter];
-		}
-
-		for(lCounter = 0; lCounter < mNbChild; lCounter++) {
-			pArchive >> mChildList[lCounter];
-		}
+		pArchive.ReadArray(mNeighborList, static_cast<size_t>(mNbVertex));
+		pArchive.ReadArray(mChildList, static_cast<size_t>(mNbChild));
+		// List of the room that are visible from the current room
+		pArchive.ReadArray(mVisibleRoomList, static_cast<size_t>(mNbVisibleRoom));
 
-		for(lCounter = 0; lCounter < mNbVisibleRoom; lCounter++) {
-												  // List of the room that are visible from the current room
-			pArchive >> mVisibleRoomList[lCounter];
-		}
+		std::vector<MR_Int32> lSurfaces(static_cast<size_t>(mNbVisibleSurface) * 4);
+		pArchive.ReadArray(lSurfaces.data(), lSurfaces.size());
 
-		for(lCounter = 0; lCounter < mNbVisibleSurface; lCounter++) {
-			mVisibleFloorList[lCounter].Serialize(pArchive);
-			mVisibleCeilingList[lCounter].Serialize(pArchive);
+		const MR_Int32 *lPtr = lSurfaces.data();
+		for(lCounter = 0; lCounter < mNbVisibleSurface; lCounter++, lPtr += 4) {
+			mVisibleFloorList[lCounter].mType = static_cast<SectionId::eSectionType>(lPtr[0]);
+			mVisibleFloorList[lCounter].mId = lPtr[1];
+			mVisibleCeilingList[lCounter].mType = static_cast<SectionId::eSectionType>(lPtr[2]);
+			mVisibleCeilingList[lCounter].mId = lPtr[3];
 		}
 
 		for(lCounter = 0; lCounter < mNbAudibleRoom; lCounter++) {
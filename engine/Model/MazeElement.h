@@ -156,7 +156,9 @@ class MR_DllDeclare FreeElement :
 
 public:
 	//HACK: Temporary default value for scripting.
-	FreeElement(const Util::ObjectFromFactoryId &id = { 0, 0 }) : SUPER(id)
+	FreeElement(const Util::ObjectFromFactoryId &id = { 0, 0 }) : SUPER(id),
+		mRenderOrientation(0), mRenderRoom(-1),
+		mPrevRoom(-1), mPrevStateValid(false)
 	{
 	}
 	virtual ~FreeElement() { }
@@ -216,6 +218,182 @@ public:
 	 */
 	virtual const ShapeInterface *GetGivingContactEffectShape() { return nullptr; }
 
+	/// Smallest render bounds ray, the object ray assumed by the renderers.
+	static const MR_Int32 MIN_RENDER_RAY = 1000;
+
+	/**
+	 * Get a sphere that contains everything Render() draws, for culling.
+	 * The default covers all of the element's shapes, with a ray of at
+	 * least MIN_RENDER_RAY; elements that draw a mesh override this to
+	 * cover it too (see ExtendRenderBounds).
+	 * @param[out] pCenter The center of the sphere.
+	 * @param[out] pRay The ray of the sphere.
+	 */
+	virtual void GetRenderBounds(MR_3DCoordinate &pCenter, MR_Int32 &pRay)
+	{
+		MR_Int32 lXMin = mPosition.mX, lXMax = mPosition.mX;
+		MR_Int32 lYMin = mPosition.mY, lYMax = mPosition.mY;
+		MR_Int32 lZMin = mPosition.mZ, lZMax = mPosition.mZ;
+
+		const ShapeInterface *lShapes[3] = {
+			GetObstacleShape(),
+			GetReceivingContactEffectShape(),
+			GetGivingContactEffectShape(),
+		};
+		for (const ShapeInterface *lShape : lShapes) {
+			if (lShape) {
+				lXMin = std::min(lXMin, lShape->XMin());
+				lXMax = std::max(lXMax, lShape->XMax());
+				lYMin = std::min(lYMin, lShape->YMin());
+				lYMax = std::max(lYMax, lShape->YMax());
+				lZMin = std::min(lZMin, lShape->ZMin());
+				lZMax = std::max(lZMax, lShape->ZMax());
+			}
+		}
+
+		pCenter.mX = lXMin + (lXMax - lXMin) / 2;
+		pCenter.mY = lYMin + (lYMax - lYMin) / 2;
+		pCenter.mZ = lZMin + (lZMax - lZMin) / 2;
+
+		// Half the diagonal of the bounding box, rounded up.
+		double lDiag = sqrt(
+			static_cast<double>(lXMax - lXMin) * (lXMax - lXMin) +
+			static_cast<double>(lYMax - lYMin) * (lYMax - lYMin) +
+			static_cast<double>(lZMax - lZMin) * (lZMax - lZMin));
+		pRay = static_cast<MR_Int32>(lDiag / 2) + 1;
+		if (pRay < MIN_RENDER_RAY) {
+			pRay = MIN_RENDER_RAY;
+		}
+	}
+
+protected:
+	/**
+	 * Grow render bounds to also hold a mesh drawn around the position.
+	 * @param[in,out] pCenter The center of the sphere.
+	 * @param[in,out] pRay The ray of the sphere.
+	 * @param pMeshRay The ray of the mesh around the element's position
+	 *                 (see ObjFacTools::ResActor::GetRay).
+	 */
+	void ExtendRenderBounds(const MR_3DCoordinate &pCenter, MR_Int32 &pRay,
+		MR_Int32 pMeshRay) const
+	{
+		double lDist = sqrt(
+			static_cast<double>(mPosition.mX - pCenter.mX) * (mPosition.mX - pCenter.mX) +
+			static_cast<double>(mPosition.mY - pCenter.mY) * (mPosition.mY - pCenter.mY) +
+			static_cast<double>(mPosition.mZ - pCenter.mZ) * (mPosition.mZ - pCenter.mZ));
+		MR_Int32 lRay = static_cast<MR_Int32>(lDist) + 1 + pMeshRay;
+		if (lRay > pRay) {
+			pRay = lRay;
+		}
+	}
+
+public:
+
+	// Render state
+
+	/**
+	 * Save what Render() needs to draw the element as it is now.
+	 * Render() only reads the saved state, so that the element can be drawn
+	 * while the simulation moves it (see RenderSnapshot).
+	 * Subclasses that draw more than the position and orientation must
+	 * save the rest here too.
+	 * @param pRoom The room the element is in.
+	 */
+	virtual void SaveRenderState(int pRoom)
+	{
+		mRenderPosition = mPosition;
+		mRenderOrientation = mOrientation;
+		mRenderRoom = pRoom;
+	}
+
+	const MR_3DCoordinate &GetRenderPosition() const { return mRenderPosition; }
+	MR_Angle GetRenderOrientation() const { return mRenderOrientation; }
+
+	/**
+	 * Retrieve the room the element was in when the render state was saved.
+	 * @return The room, or @c -1 if the render state was never saved.
+	 */
+	int GetRenderRoom() const { return mRenderRoom; }
+
+	// Render interpolation
+
+	/// Moves longer than this between two slices are not interpolated.
+	static const MR_Int32 MAX_INTERPOLATION_DIST = 4000;
+
+	/**
+	 * Remember the state that the next simulation slice starts from.
+	 * This is called by the session before each slice.
+	 * @param pRoom The room the element is in.
+	 */
+	virtual void SavePrevState(int pRoom)
+	{
+		mPrevPosition = mPosition;
+		mPrevOrientation = mOrientation;
+		mPrevRoom = pRoom;
+		mPrevStateValid = true;
+	}
+
+	/**
+	 * Temporarily move the element between its last two simulated states,
+	 * so that it can be rendered at a time that falls between slices.
+	 * Elements that have just been created, that moved too far (they were
+	 * probably teleported) or that changed rooms are left where they are,
+	 * so that the position always lies in the room the level has them in.
+	 * Must be followed by EndInterpolation() before the next slice.
+	 * @param pAlpha Where to put the element, from @c 0.0 (the state before
+	 *               the last slice) to @c 1.0 (the current state).
+	 * @param pRoom The room the element is in.
+	 */
+	virtual void BeginInterpolation(double pAlpha, int pRoom)
+	{
+		mSimPosition = mPosition;
+		mSimOrientation = mOrientation;
+
+		if (!CanInterpolate(pAlpha, pRoom)) return;
+
+		mPosition.mX = Interpolate(mPrevPosition.mX, mPosition.mX, pAlpha);
+		mPosition.mY = Interpolate(mPrevPosition.mY, mPosition.mY, pAlpha);
+		mPosition.mZ = Interpolate(mPrevPosition.mZ, mPosition.mZ, pAlpha);
+		mOrientation = InterpolateAngle(mPrevOrientation, mOrientation, pAlpha);
+	}
+
+	/**
+	 * Put the element back in its current simulated state.
+	 */
+	virtual void EndInterpolation()
+	{
+		mPosition = mSimPosition;
+		mOrientation = mSimOrientation;
+	}
+
+protected:
+	bool CanInterpolate(double pAlpha, int pRoom) const
+	{
+		return mPrevStateValid && pAlpha < 1.0 && pRoom == mPrevRoom &&
+			abs(mPosition.mX - mPrevPosition.mX) <= MAX_INTERPOLATION_DIST &&
+			abs(mPosition.mY - mPrevPosition.mY) <= MAX_INTERPOLATION_DIST &&
+			abs(mPosition.mZ - mPrevPosition.mZ) <= MAX_INTERPOLATION_DIST;
+	}
+
+	static MR_Int32 Interpolate(MR_Int32 pFrom, MR_Int32 pTo, double pAlpha)
+	{
+		return pFrom + static_cast<MR_Int32>((pTo - pFrom) * pAlpha);
+	}
+
+	static MR_Angle InterpolateAngle(MR_Angle pFrom, MR_Angle pTo, double pAlpha)
+	{
+		// Turn the short way around.
+		int lDiff = static_cast<int>(pTo) - static_cast<int>(pFrom);
+		if (lDiff > MR_PI) {
+			lDiff -= MR_2PI;
+		}
+		else if (lDiff < -MR_PI) {
+			lDiff += MR_2PI;
+		}
+		return MR_NORMALIZE_ANGLE(pFrom + static_cast<int>(lDiff * pAlpha));
+	}
+
+public:
 	// Perm state hook
 
 	/**
@@ -234,6 +412,17 @@ public:
 public:
 	MR_3DCoordinate mPosition;
 	MR_Angle mOrientation;
+
+protected:
+	MR_3DCoordinate mRenderPosition;  ///< Saved by SaveRenderState().
+	MR_Angle mRenderOrientation;
+	int mRenderRoom;
+	MR_3DCoordinate mPrevPosition;  ///< Before the last simulation slice.
+	MR_Angle mPrevOrientation;
+	int mPrevRoom;
+	bool mPrevStateValid;
+	MR_3DCoordinate mSimPosition;  ///< Saved by BeginInterpolation().
+	MR_Angle mSimOrientation;
 };
 
 }  // namespace Model
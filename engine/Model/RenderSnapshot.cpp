@@ -0,0 +1,89 @@
+// RenderSnapshot.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "Level.h"
+
+#include "RenderSnapshot.h"
+
+namespace HoverRace {
+namespace Model {
+
+/**
+ * Save the render state of every free element in a level.
+ *
+ * This must not be called while the level is being simulated.
+ *
+ * @param level The level.
+ * @param alpha Where to draw the elements between their last two simulated
+ *              states (see FreeElement::BeginInterpolation()), from
+ *              @c 0.0 to @c 1.0 (the current state).
+ */
+void RenderSnapshot::Capture(const Level &level, double alpha)
+{
+	const int numRooms = level.GetRoomCount();
+
+	// Keep the lists (and their capacity) from the last frame.
+	rooms.resize(static_cast<size_t>(numRooms + 1));
+
+	for (int room = -1; room < numRooms; room++) {
+		entries_t &entries = rooms[static_cast<size_t>(room + 1)];
+		entries.clear();
+
+		for (MR_FreeElementHandle handle = level.GetFirstFreeElement(room);
+			handle != NULL; handle = Level::GetNextFreeElement(handle))
+		{
+			FreeElement *elem = Level::GetFreeElement(handle);
+
+			elem->BeginInterpolation(alpha, room);
+			elem->SaveRenderState(room);
+
+			entries.emplace_back();
+			Entry &entry = entries.back();
+			entry.element = elem->shared_from_this();
+			elem->GetRenderBounds(entry.center, entry.ray);
+
+			elem->EndInterpolation();
+		}
+	}
+}
+
+/**
+ * Release the elements.
+ */
+void RenderSnapshot::Clear()
+{
+	rooms.clear();
+}
+
+/**
+ * Retrieve the elements that were in a room.
+ * @param room The room, or @c -1 for the elements that aren't in one.
+ * @return The elements (empty if nothing was captured for the room).
+ */
+const RenderSnapshot::entries_t &RenderSnapshot::GetElements(int room) const
+{
+	static const entries_t empty;
+
+	size_t idx = static_cast<size_t>(room + 1);
+	return idx < rooms.size() ? rooms[idx] : empty;
+}
+
+}  // namespace Model
+}  // namespace HoverRace
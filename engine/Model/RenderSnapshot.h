@@ -0,0 +1,84 @@
+// RenderSnapshot.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include "../Util/MR_Types.h"
+#include "../Util/WorldCoordinates.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+	namespace Model {
+		class FreeElement;
+		class Level;
+	}
+}
+
+namespace HoverRace {
+namespace Model {
+
+/**
+ * The free elements of a level, as they are to be drawn for one frame.
+ *
+ * Capture() saves the render state of every free element (see
+ * FreeElement::SaveRenderState()) along with the room it is in.  The
+ * elements can then be drawn from the snapshot while the simulation moves
+ * on: the simulation never touches the render state, and the snapshot
+ * keeps the elements alive until the next capture even if they are deleted
+ * in the meantime.
+ *
+ * @author Michael Imamura
+ */
+class MR_DllDeclare RenderSnapshot
+{
+public:
+	RenderSnapshot() { }
+
+	struct Entry
+	{
+		std::shared_ptr<FreeElement> element;
+		MR_3DCoordinate center;  ///< Center of the render bounds.
+		MR_Int32 ray;  ///< Ray of the render bounds.
+	};
+	using entries_t = std::vector<Entry>;
+
+public:
+	void Capture(const Level &level, double alpha = 1.0);
+	void Clear();
+
+	const entries_t &GetElements(int room) const;
+
+private:
+	std::vector<entries_t> rooms;  ///< Indexed by room + 1 (0 is unclassified).
+};
+
+}  // namespace Model
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
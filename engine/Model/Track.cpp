@@ -23,6 +23,7 @@
 #include "../Parcel/RecordFile.h"
 #include "../Util/InspectMapNode.h"
 #include "../Util/Log.h"
+#include "../Util/Str.h"
 #include "GameOptions.h"
 #include "Level.h"
 
@@ -43,11 +44,14 @@ Track::Physics::Physics() :
  * @param name The name of the track.
  * @param recFile The record file to load the track from
  *                (may be @c nullptr if in-memory only).
+ * @param path The track file that @p recFile was opened from
+ *             (may be empty if in-memory only).
  * @throw Parcel::ObjStreamExn
  */
 Track::Track(const std::string &name,
-	std::shared_ptr<Parcel::RecordFile> recFile) :
-	SUPER(), recFile(std::move(recFile)), offset(0, 0), size(0, 0), map(),
+	std::shared_ptr<Parcel::RecordFile> recFile, const OS::path_t &path) :
+	SUPER(), recFile(std::move(recFile)), path(path),
+	offset(0, 0), size(0, 0), map(),
 	physics()
 {
 	LoadHeader();
@@ -118,8 +122,13 @@ void Track::LoadMap()
 	size.x = static_cast<double>(x1) - offset.x;
 	size.y = static_cast<double>(y1) - offset.y;
 
+	// The texture is shared by ID, so it's keyed on the file when there is
+	// one; the same name may be in more than one bundle.
 	map = std::make_shared<Display::SpriteTextureRes>(
-		"map:" + header.name, archive);
+		path.empty() ?
+			"map:" + header.name :
+			"map:" + std::string((const char*)Str::PU(path)),
+		archive);
 }
 
 void Track::Load(bool allowRendering, const GameOptions &gameOpts)
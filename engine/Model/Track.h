@@ -62,7 +62,8 @@ private:
 	Track() = delete;
 public:
 	Track(const std::string &name,
-		std::shared_ptr<Parcel::RecordFile> recFile = {});
+		std::shared_ptr<Parcel::RecordFile> recFile = {},
+		const Util::OS::path_t &path = {});
 	virtual ~Track();
 
 	Parcel::RecordFile *GetRecordFile() const { return recFile.get(); }
@@ -118,6 +119,7 @@ public:
 
 private:
 	std::shared_ptr<Parcel::RecordFile> recFile;
+	Util::OS::path_t path;
 	TrackEntry header;
 	std::unique_ptr<Level> level;
 	Vec2 offset;
@@ -0,0 +1,236 @@
+
+// TrackIndex.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <ctime>
+
+#include "../Parcel/ClassicObjStream.h"
+#include "../Util/Log.h"
+#include "../Util/Str.h"
+
+#include "TrackIndex.h"
+
+namespace fs = boost::filesystem;
+
+using namespace HoverRace::Parcel;
+using namespace HoverRace::Util;
+
+namespace HoverRace {
+namespace Model {
+
+namespace {
+
+// ObjStream has no 64-bit fields, so these are stored as two halves.
+
+void Write64(ObjStream &os, MR_UInt64 i)
+{
+	os << static_cast<MR_UInt32>(i) << static_cast<MR_UInt32>(i >> 32);
+}
+
+MR_UInt64 Read64(ObjStream &os)
+{
+	MR_UInt32 lo, hi;
+	os >> lo >> hi;
+	return (static_cast<MR_UInt64>(hi) << 32) | lo;
+}
+
+}  // namespace
+
+/**
+ * Constructor.
+ * The index starts out empty; call Load() to read it from disk.
+ * @param filename The path to the index file (does not need to exist).
+ */
+TrackIndex::TrackIndex(const OS::path_t &filename) :
+	filename(filename)
+{
+}
+
+/**
+ * Read the index from disk, replacing any entries already in the index.
+ * If the file is missing, out of date, or corrupt, then the index is left
+ * empty so that every track will be read from its own file.
+ * @return @c true if the index was loaded, @c false otherwise.
+ */
+bool TrackIndex::Load()
+{
+	Clear();
+
+	FILE *file = OS::FOpen(filename, "rb");
+	if (!file) return false;
+
+	try {
+		ClassicObjStream os(file, filename, false);
+
+		MR_UInt32 magic, version, count;
+		os >> magic >> version;
+		if (magic != FILE_MAGIC || version != FILE_VERSION) {
+			HR_LOG(info) << "Ignoring out-of-date track index: " <<
+				(const char*)Str::PU(filename);
+			fclose(file);
+			return false;
+		}
+
+		os >> count;
+		for (MR_UInt32 i = 0; i < count; i++) {
+			std::string path;
+			Ent ent;
+
+			os >> path;
+			ent.size = Read64(os);
+			ent.mtime = static_cast<MR_Int64>(Read64(os));
+
+			TrackEntry &entry = ent.entry;
+			os >> entry.name >> entry.description >>
+				entry.regMinor >> entry.regMajor >>
+				entry.registrationMode >> entry.sortingIndex;
+
+			entries.emplace(std::move(path), std::move(ent));
+		}
+	}
+	catch (ObjStreamExn &ex) {
+		HR_LOG(warning) << "Ignoring invalid track index: " << ex.what();
+		Clear();
+		fclose(file);
+		return false;
+	}
+
+	fclose(file);
+	return true;
+}
+
+/**
+ * Write the index to disk.
+ * The index is written to a temporary file first, so an interrupted save
+ * will not leave behind a truncated index.
+ * @return @c true if saved, @c false otherwise.
+ */
+bool TrackIndex::Save() const
+{
+	OS::path_t tmpFilename = filename;
+	tmpFilename += Str::UP(".tmp");
+
+	try {
+		fs::create_directories(filename.parent_path());
+	}
+	catch (fs::filesystem_error &ex) {
+		HR_LOG(warning) << "Unable to save track index: " << ex.what();
+		return false;
+	}
+
+	FILE *file = OS::FOpen(tmpFilename, "wb");
+	if (!file) {
+		HR_LOG(warning) << "Unable to save track index: " <<
+			(const char*)Str::PU(tmpFilename) << ": " << OS::StrError(errno);
+		return false;
+	}
+
+	try {
+		ClassicObjStream os(file, tmpFilename, true);
+
+		os << FILE_MAGIC << FILE_VERSION <<
+			static_cast<MR_UInt32>(entries.size());
+
+		for (const auto &kv : entries) {
+			const Ent &ent = kv.second;
+			const TrackEntry &entry = ent.entry;
+
+			os << kv.first;
+			Write64(os, ent.size);
+			Write64(os, static_cast<MR_UInt64>(ent.mtime));
+			os << entry.name << entry.description <<
+				entry.regMinor << entry.regMajor <<
+				entry.registrationMode << entry.sortingIndex;
+		}
+	}
+	catch (ObjStreamExn &ex) {
+		HR_LOG(warning) << "Unable to save track index: " << ex.what();
+		fclose(file);
+		fs::remove(tmpFilename);
+		return false;
+	}
+
+	if (fclose(file) != 0) {
+		HR_LOG(warning) << "Unable to save track index: " <<
+			(const char*)Str::PU(tmpFilename) << ": " << OS::StrError(errno);
+		fs::remove(tmpFilename);
+		return false;
+	}
+
+	boost::system::error_code ec;
+	fs::rename(tmpFilename, filename, ec);
+	if (ec) {
+		HR_LOG(warning) << "Unable to save track index: " << ec.message();
+		fs::remove(tmpFilename, ec);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Look up the cached header for a track file.
+ * @param path The path to the track file.
+ * @param size The current size of the track file.
+ * @param mtime The current modification time of the track file.
+ * @return A copy of the header, or @c nullptr if the track is not in the
+ *         index or has changed since it was indexed.
+ */
+std::shared_ptr<TrackEntry> TrackIndex::Find(const OS::path_t &path,
+	MR_UInt64 size, MR_Int64 mtime) const
+{
+	auto iter = entries.find((const char*)Str::PU(path));
+	if (iter == entries.end() ||
+		iter->second.size != size || iter->second.mtime != mtime)
+	{
+		return std::shared_ptr<TrackEntry>();
+	}
+	return std::make_shared<TrackEntry>(iter->second.entry);
+}
+
+/**
+ * Add or replace the cached header for a track file.
+ *
+ * This must be called right after the header was read.  Modification times
+ * only have a resolution of one second, so a track which was modified in
+ * the current second could be rewritten again without its size or
+ * modification time changing; such tracks are left out of the index until
+ * a later reload.
+ *
+ * @param path The path to the track file.
+ * @param size The size of the track file.
+ * @param mtime The modification time of the track file.
+ * @param entry The header.
+ */
+void TrackIndex::Put(const OS::path_t &path, MR_UInt64 size, MR_Int64 mtime,
+	const TrackEntry &entry)
+{
+	std::string key((const char*)Str::PU(path));
+
+	if (mtime >= static_cast<MR_Int64>(time(nullptr))) {
+		entries.erase(key);
+		return;
+	}
+
+	entries[key] = Ent{ size, mtime, entry };
+}
+
+}  // namespace Model
+}  // namespace HoverRace
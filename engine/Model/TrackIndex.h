@@ -0,0 +1,87 @@
+
+// TrackIndex.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <map>
+
+#include "../Util/MR_Types.h"
+#include "../Util/OS.h"
+#include "TrackEntry.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+namespace Model {
+
+/**
+ * On-disk cache of track headers.
+ *
+ * Each header is keyed by the path, size, and modification time of the
+ * track file it was read from, so that TrackList::Reload() only needs to
+ * open the tracks which are new or have changed.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare TrackIndex
+{
+public:
+	TrackIndex(const Util::OS::path_t &filename);
+
+public:
+	bool Load();
+	bool Save() const;
+
+	std::shared_ptr<TrackEntry> Find(const Util::OS::path_t &path,
+		MR_UInt64 size, MR_Int64 mtime) const;
+	void Put(const Util::OS::path_t &path, MR_UInt64 size, MR_Int64 mtime,
+		const TrackEntry &entry);
+
+	/** Remove all cached headers. */
+	void Clear() { entries.clear(); }
+	size_t GetCount() const { return entries.size(); }
+
+private:
+	struct Ent
+	{
+		MR_UInt64 size;
+		MR_Int64 mtime;
+		TrackEntry entry;
+	};
+
+	Util::OS::path_t filename;
+	std::map<std::string, Ent> entries;
+
+	static const MR_UInt32 FILE_MAGIC = 0x5844494b;  // "KIDX"
+	static const MR_UInt32 FILE_VERSION = 1;
+};
+
+}  // namespace Model
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
@@ -19,16 +19,22 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "../Parcel/ObjStream.h"
 #include "../Parcel/TrackBundle.h"
+#include "../Util/Config.h"
 #include "../Util/Str.h"
 #include "../Util/Log.h"
 #include "../Util/OS.h"
 
+#include "TrackIndex.h"
+
 #include "TrackList.h"
 
+namespace fs = boost::filesystem;
+
 using namespace HoverRace::Parcel;
 using namespace HoverRace::Util;
 
@@ -66,22 +72,69 @@ TrackList::TrackList()
 /**
  * Load the list of available tracks from the track bundle.
  * Any previously-loaded list is cleared.
+ *
+ * Unless disabled in the runtime config, the track headers are cached in
+ * the track index (see Config::GetTrackIndexFilename()), so only the tracks
+ * which are new or have changed since the last reload are actually opened.
+ *
  * @param trackBundle The track bundle.
  */
 void TrackList::Reload(const Parcel::TrackBundle &trackBundle)
+{
+	Reload(trackBundle, Config::GetInstance()->GetTrackIndexFilename());
+}
+
+/**
+ * Load the list of available tracks from the track bundle, using a
+ * specific track index file.
+ * @param trackBundle The track bundle.
+ * @param indexFilename The track index file (does not need to exist).
+ */
+void TrackList::Reload(const Parcel::TrackBundle &trackBundle,
+	const OS::path_t &indexFilename)
 {
 	Clear();
 
+	const Config *cfg = Config::GetInstance();
+	const bool useIndex = cfg->runtime.trackIndex;
+
+	// The old index is only consulted; the new one is built from scratch so
+	// that deleted tracks are dropped from it.
+	TrackIndex oldIndex(indexFilename);
+	TrackIndex newIndex(indexFilename);
+	if (useIndex) {
+		oldIndex.Load();
+	}
+	size_t numOpened = 0;
+
 	for (const auto &ent : trackBundle) {
-		std::string name((const char*)Str::PU(ent.path().filename()));
+		const OS::path_t &path = ent.path();
+		std::string name((const char*)Str::PU(path.filename()));
+		// Only ".trk" in lowercase, as with the lookup by name.
+		if (!boost::ends_with(name, Config::TRACK_EXT)) continue;
+
 		try {
-			auto trackEnt = trackBundle.OpenTrackEntry(name);
-			if (trackEnt) {
-				tracks.emplace_back(trackEnt);
-#				ifdef _DEBUG
-					tracks.back()->path = ent.path();
-#				endif
+			std::shared_ptr<TrackEntry> trackEnt;
+
+			boost::system::error_code ec;
+			MR_UInt64 size = fs::file_size(path, ec);
+			MR_Int64 mtime = ec ? 0 : fs::last_write_time(path, ec);
+
+			if (useIndex && !ec) {
+				trackEnt = oldIndex.Find(path, size, mtime);
+			}
+			if (!trackEnt) {
+				trackEnt = Parcel::TrackBundle::OpenTrackEntryFile(path);
+				numOpened++;
 			}
+			if (useIndex && !ec) {
+				newIndex.Put(path, size, mtime, *trackEnt);
+			}
+
+			tracks.emplace_back(trackEnt);
+#			ifdef _DEBUG
+				tracks.back()->path = path;
+#			endif
 		}
 		catch (Parcel::ObjStreamExn &ex) {
 			// Ignore this bad track and continue.
@@ -90,6 +143,12 @@ void TrackList::Reload(const Parcel::TrackBundle &trackBundle)
 		}
 	}
 
+	if (useIndex &&
+		(numOpened > 0 || newIndex.GetCount() != oldIndex.GetCount()))
+	{
+		newIndex.Save();
+	}
+
 	// Use a stable sort so that if there are multiple entries with the
 	// same name, then the bundle priority order will be preserved.
 	// Then, when we remove duplicates, the lower-priority entries will be
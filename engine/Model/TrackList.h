@@ -53,6 +53,8 @@ public:
 
 public:
 	void Reload(const Parcel::TrackBundle &trackBundle);
+	void Reload(const Parcel::TrackBundle &trackBundle,
+		const Util::OS::path_t &indexFilename);
 
 	/** Clear the list of available tracks. */
 	void Clear() { tracks.clear(); }
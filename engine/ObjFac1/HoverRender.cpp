@@ -100,6 +100,16 @@ void HoverRender::Render(VideoServices::Viewport3D *pDest,
 	}
 }
 
+MR_Int32 HoverRender::GetRay(unsigned int pModel) const
+{
+	switch (pModel) {
+		case 1: return mActor1->GetRay();
+		case 2: return mActor2->GetRay();
+		case 3: return mActor3->GetRay();
+		default: return mActor0->GetRay();
+	}
+}
+
 ShortSound *HoverRender::GetLineCrossingSound()
 {
 	return mLineCrossingSound;
@@ -164,28 +174,19 @@ void ResActorFriend::Draw(const ObjFacTools::ResActor *pActor,
 	Viewport3D *pDest, const PositionMatrix &pMatrix, int pSequence,
 	int pFrame, const VideoServices::Bitmap *pCockpitBitmap)
 {
+	static const int lCockpitIds[] = {
+		MR_CAR_COCKPIT, MR_CAR2_COCKPIT, MR_EON_COCKPIT };
+
 	ObjFacTools::ResActor::Frame *lFrame =
 		&(pActor->mSequenceList[pSequence].mFrameList[pFrame]);
 
 	ASSERT(lFrame != NULL);
 
-	for(int lCounter = 0; lCounter < lFrame->mNbComponent; lCounter++) {
-		ObjFacTools::ResActor::Patch *lPatch =
-			static_cast<ObjFacTools::ResActor::Patch*>(
-				lFrame->mComponentList[lCounter]);
+	ObjFacTools::ResActor::BitmapSubst lSubst = {
+		lCockpitIds, sizeof(lCockpitIds) / sizeof(lCockpitIds[0]),
+		pCockpitBitmap };
 
-		int lBitmapResId = lPatch->mBitmap->GetResourceId();
-
-		if ((lBitmapResId == MR_CAR_COCKPIT) ||
-			(lBitmapResId == MR_CAR2_COCKPIT) ||
-			(lBitmapResId == MR_EON_COCKPIT))
-		{
-			pDest->RenderPatch(*lPatch, pMatrix, pCockpitBitmap);
-		}
-		else {
-			pDest->RenderPatch(*lPatch, pMatrix, lPatch->mBitmap);
-		}
-	}
+	lFrame->Draw(pDest, pMatrix, &lSubst);
 }
 
 }  // namespace ObjFac1
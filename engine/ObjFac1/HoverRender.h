@@ -74,6 +74,7 @@ public:
 	void Render(VideoServices::Viewport3D *pDest,
 		const MR_3DCoordinate &pPosition, MR_Angle pOrientation,
 		BOOL pMotorOn, int pHoverId, unsigned int pModel) override;
+	MR_Int32 GetRay(unsigned int pModel) const override;
 
 	VideoServices::ShortSound *GetLineCrossingSound() override;
 	VideoServices::ShortSound *GetStartSound() override;
@@ -150,7 +150,7 @@ int Mine::Simulate(MR_SimulationTime pDuration, Model::Track &track, int pRoom)
 
 void Mine::Render(VideoServices::Viewport3D *pDest, MR_SimulationTime pTime)
 {
-	mCurrentFrame = (pTime >> 9) & 1;
+	mRenderFrame = (pTime >> 9) & 1;
 	SUPER::Render(pDest, pTime);
 }
 
@@ -31,10 +31,27 @@ void FreeElementBase::Render(VideoServices::Viewport3D *pDest, MR_SimulationTime
 	// Compute the required rotation matrix
 	VideoServices::PositionMatrix lMatrix;
 
-	if (pDest->ComputePositionMatrix(lMatrix, mPosition, mOrientation, 1000)) {
-		mActor->Draw(pDest, lMatrix, mCurrentSequence, mCurrentFrame);
+	if (pDest->ComputePositionMatrix(lMatrix, mRenderPosition, mRenderOrientation, 1000)) {
+		mActor->Draw(pDest, lMatrix, mRenderSequence, mRenderFrame);
 	}
 }
 
+void FreeElementBase::GetRenderBounds(MR_3DCoordinate &pCenter, MR_Int32 &pRay)
+{
+	SUPER::GetRenderBounds(pCenter, pRay);
+
+	if (mActor) {
+		ExtendRenderBounds(pCenter, pRay, mActor->GetRay());
+	}
+}
+
+void FreeElementBase::SaveRenderState(int pRoom)
+{
+	SUPER::SaveRenderState(pRoom);
+
+	mRenderSequence = mCurrentSequence;
+	mRenderFrame = mCurrentFrame;
+}
+
 }  // namespace ObjFacTools
 }  // namespace HoverRace
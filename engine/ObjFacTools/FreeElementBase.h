@@ -51,17 +51,22 @@ class MR_DllDeclare FreeElementBase : public Model::FreeElement
 
 public:
 	FreeElementBase(const Util::ObjectFromFactoryId &id) :
-		SUPER(id), mActor(nullptr), mCurrentSequence(0), mCurrentFrame(0) { }
+		SUPER(id), mActor(nullptr), mCurrentSequence(0), mCurrentFrame(0),
+		mRenderSequence(0), mRenderFrame(0) { }
 	~FreeElementBase() { }
 
 	// Rendering stuff
 	void Render(VideoServices::Viewport3D *pDest,
 		MR_SimulationTime pTime) override;
+	void GetRenderBounds(MR_3DCoordinate &pCenter, MR_Int32 &pRay) override;
+	void SaveRenderState(int pRoom) override;
 
 protected:
 	const ResActor *mActor;
 	int mCurrentSequence;
 	int mCurrentFrame;
+	int mRenderSequence;  ///< Saved by SaveRenderState().
+	int mRenderFrame;
 };
 
 }  // namespace ObjFacTools
@@ -35,6 +35,7 @@ ResActor::ResActor(int pResourceId)
 	mResourceId = pResourceId;
 	mNbSequence = 0;
 	mSequenceList = NULL;
+	mRay = 0;
 }
 
 ResActor::~ResActor()
@@ -57,6 +58,41 @@ int ResActor::GetFrameCount(int pSequence) const
 	return mSequenceList[pSequence].mNbFrame;
 } 
 
+/**
+ * Get the distance from the actor origin to its farthest node.
+ * This covers every frame of every sequence, whatever the orientation,
+ * so a sphere of this ray around the position contains what Draw() draws.
+ * @return The ray (mm).
+ */
+MR_Int32 ResActor::GetRay() const
+{
+	return mRay;
+}
+
+void ResActor::ComputeRay()
+{
+	double lMaxSq = 0;
+
+	for(int lSeq = 0; lSeq < mNbSequence; lSeq++) {
+		const Sequence &lSequence = mSequenceList[lSeq];
+
+		for(int lFrame = 0; lFrame < lSequence.mNbFrame; lFrame++) {
+			const Frame &lFrameRef = lSequence.mFrameList[lFrame];
+
+			for(int lNode = 0; lNode < lFrameRef.mNbVertex; lNode++) {
+				const MR_3DCoordinate &lCoord = lFrameRef.mVertexList[lNode];
+				double lSq =
+					static_cast<double>(lCoord.mX) * lCoord.mX +
+					static_cast<double>(lCoord.mY) * lCoord.mY +
+					static_cast<double>(lCoord.mZ) * lCoord.mZ;
+				lMaxSq = std::max(lMaxSq, lSq);
+			}
+		}
+	}
+
+	mRay = static_cast<MR_Int32>(sqrt(lMaxSq)) + 1;
+}
+
 void ResActor::Serialize(ObjStream &pArchive, ResourceLib *pLib)
 {
 
@@ -78,6 +114,52 @@ void ResActor::Serialize(ObjStream &pArchive, ResourceLib *pLib)
 		mSequenceList[lCounter].Serialize(pArchive, pLib);
 	}
 
+	if(!pArchive.IsWriting()) {
+		ComputeRay();
+	}
+}
+
+/**
+ * Advance the stream past a serialized actor without loading it.
+ * Unlike Serialize(), this does not resolve the patch bitmaps.
+ * @param pArchive The archive to read from.
+ */
+void ResActor::Skip(ObjStream &pArchive)
+{
+	int lNbSequence;
+	pArchive >> lNbSequence;
+
+	for (int lSeq = 0; lSeq < lNbSequence; lSeq++) {
+		int lNbFrame;
+		pArchive >> lNbFrame;
+
+		for (int lFrame = 0; lFrame < lNbFrame; lFrame++) {
+			int lNbComponent;
+			pArchive >> lNbComponent;
+
+			for (int lComp = 0; lComp < lNbComponent; lComp++) {
+				int lType;
+				pArchive >> lType;
+
+				if ((eComponentType)lType != ePatch) {
+					throw ObjStreamExn(pArchive.GetName(),
+						boost::str(boost::format("%s: %d") % _("Unhandled component type") % lType));
+				}
+
+				int lURes, lVRes, lBitmapId;
+				pArchive >> lURes;
+				pArchive >> lVRes;
+				pArchive >> lBitmapId;
+
+				if (lURes < 0 || lVRes < 0) {
+					throw ObjStreamExn(pArchive.GetName(),
+						boost::str(boost::format("Invalid patch size: %dx%d") % lURes % lVRes));
+				}
+
+				pArchive.Skip(static_cast<size_t>(lURes * lVRes) * 3 * sizeof(MR_Int32));
+			}
+		}
+	}
 }
 
 void ResActor::Draw(VideoServices::Viewport3D * pDest, const VideoServices::PositionMatrix & pMatrix, int pSequence, int pFrame) const
@@ -132,7 +214,8 @@ ResActor::Frame::Frame()
 {
 	mNbComponent = 0;
 	mComponentList = NULL;
-
+	mNbVertex = 0;
+	mVertexList = NULL;
 }
 
 ResActor::Frame::~Frame()
@@ -150,6 +233,52 @@ void ResActor::Frame::Clean()
 		delete[]mComponentList;
 		mComponentList = NULL;
 	}
+
+	delete[]mVertexList;
+	mVertexList = NULL;
+	mNbVertex = 0;
+}
+
+/**
+ * Merge the nodes of all the patches of the frame in a single list.
+ * Patches that share edges (most of them) share their nodes, so the frame
+ * can be transformed once (see Viewport3D::TransformVertices) and each
+ * patch only has to look up its nodes (see Patch::mNodeIndex).
+ */
+void ResActor::Frame::BuildVertexList()
+{
+	int lCounter;
+	int lNbNodes = 0;
+
+	for(lCounter = 0; lCounter < mNbComponent; lCounter++) {
+		const Patch *lPatch = static_cast<const Patch*>(mComponentList[lCounter]);
+		lNbNodes += lPatch->mURes * lPatch->mVRes;
+	}
+
+	delete[]mVertexList;
+	mVertexList = new MR_3DCoordinate[std::max(lNbNodes, 1)];
+	mNbVertex = 0;
+
+	std::map<std::tuple<MR_Int32, MR_Int32, MR_Int32>, int> lNodeMap;
+
+	for(lCounter = 0; lCounter < mNbComponent; lCounter++) {
+		Patch *lPatch = static_cast<Patch*>(mComponentList[lCounter]);
+		int lPatchNodes = lPatch->mURes * lPatch->mVRes;
+
+		delete[]lPatch->mNodeIndex;
+		lPatch->mNodeIndex = new int[lPatchNodes];
+
+		for(int lNode = 0; lNode < lPatchNodes; lNode++) {
+			const MR_3DCoordinate &lCoord = lPatch->mVertexList[lNode];
+			auto lInsert = lNodeMap.insert(std::make_pair(
+				std::make_tuple(lCoord.mX, lCoord.mY, lCoord.mZ), mNbVertex));
+
+			if(lInsert.second) {
+				mVertexList[mNbVertex++] = lCoord;
+			}
+			lPatch->mNodeIndex[lNode] = lInsert.first->second;
+		}
+	}
 }
 
 void ResActor::Frame::Serialize(ObjStream &pArchive, ResourceLib *pLib)
@@ -191,17 +320,51 @@ void ResActor::Frame::Serialize(ObjStream &pArchive, ResourceLib *pLib)
 				mComponentList[lCounter]->Serialize(pArchive, pLib);
 			}
 		}
+
+		BuildVertexList();
 	}
 }
 
-void ResActor::Frame::Draw(VideoServices::Viewport3D * pDest, const VideoServices::PositionMatrix & pMatrix) const
+/**
+ * Draw the frame.
+ * With actor batching, the shared nodes are transformed once and the
+ * viewport culls each patch before drawing it.
+ * @param pDest The viewport.
+ * @param pMatrix The position of the actor.
+ * @param pSubst Bitmaps to draw instead of some of the actor's own
+ *               (may be @c NULL).
+ */
+void ResActor::Frame::Draw(VideoServices::Viewport3D * pDest, const VideoServices::PositionMatrix & pMatrix, const BitmapSubst *pSubst) const
 {
-	// Draw each component of the frame
-	for(int lCounter = 0; lCounter < mNbComponent; lCounter++) {
-		mComponentList[lCounter]->Draw(pDest, pMatrix);
+	if(pDest->GetActorBatching()) {
+		// Transform the shared nodes once for all the components
+		pDest->TransformVertices(pMatrix, mVertexList, mNbVertex);
+
+		for(int lCounter = 0; lCounter < mNbComponent; lCounter++) {
+			mComponentList[lCounter]->DrawTransformed(pDest, pSubst);
+		}
+	}
+	else {
+		// Draw each component of the frame
+		for(int lCounter = 0; lCounter < mNbComponent; lCounter++) {
+			mComponentList[lCounter]->Draw(pDest, pMatrix, pSubst);
+		}
 	}
 }
 
+// BitmapSubst
+const VideoServices::Bitmap *ResActor::BitmapSubst::Select(const ResBitmap *pBitmap) const
+{
+	int lResId = pBitmap->GetResourceId();
+
+	for(int lCounter = 0; lCounter < mNbResIds; lCounter++) {
+		if(mResIds[lCounter] == lResId) {
+			return mBitmap;
+		}
+	}
+	return pBitmap;
+}
+
 // class ActorComponent 
 ResActor::ActorComponent::~ActorComponent()
 {
@@ -214,11 +377,13 @@ ResActor::Patch::Patch()
 {
 	mBitmap = NULL;
 	mVertexList = NULL;
+	mNodeIndex = NULL;
 }
 
 ResActor::Patch::~Patch()
 {
 	delete[]mVertexList;
+	delete[]mNodeIndex;
 }
 
 ResActor::eComponentType ResActor::Patch::GetType() const
@@ -235,9 +400,14 @@ void ResActor::Patch::Serialize(ObjStream &pArchive, ResourceLib *pLib)
 		pArchive << mVRes;
 		pArchive << mBitmap->GetResourceId();	  //bitmaptype is serialize using the Id of the bitmap
 
+		std::vector<MR_Int32> lCoords;
+		lCoords.reserve(static_cast<size_t>(mURes * mVRes) * 3);
 		for(lCounter = 0; lCounter < mURes * mVRes; lCounter++) {
-			mVertexList[lCounter].Serialize(pArchive);
+			lCoords.push_back(mVertexList[lCounter].mX);
+			lCoords.push_back(mVertexList[lCounter].mY);
+			lCoords.push_back(mVertexList[lCounter].mZ);
 		}
+		pArchive.WriteArray(lCoords.data(), lCoords.size());
 	}
 	else {
 		int lBitmapId;
@@ -252,15 +422,24 @@ void ResActor::Patch::Serialize(ObjStream &pArchive, ResourceLib *pLib)
 
 		mVertexList = new MR_3DCoordinate[mURes * mVRes];
 
-		for(lCounter = 0; lCounter < mURes * mVRes; lCounter++) {
-			mVertexList[lCounter].Serialize(pArchive);
+		std::vector<MR_Int32> lCoords(static_cast<size_t>(mURes * mVRes) * 3);
+		pArchive.ReadArray(lCoords.data(), lCoords.size());
+
+		const MR_Int32 *lPtr = lCoords.data();
+		for(lCounter = 0; lCounter < mURes * mVRes; lCounter++, lPtr += 3) {
+			mVertexList[lCounter] = MR_3DCoordinate(lPtr[0], lPtr[1], lPtr[2]);
 		}
 	}
 }
 
-void ResActor::Patch::Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix) const
+void ResActor::Patch::Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix, const BitmapSubst *pSubst) const
+{
+	pDest->RenderPatch(*this, pMatrix, (pSubst == NULL) ? mBitmap : pSubst->Select(mBitmap));
+}
+
+void ResActor::Patch::DrawTransformed(VideoServices::Viewport3D *pDest, const BitmapSubst *pSubst) const
 {
-	pDest->RenderPatch(*this, pMatrix, mBitmap);
+	pDest->RenderTransformedPatch(mURes, mVRes, mNodeIndex, (pSubst == NULL) ? mBitmap : pSubst->Select(mBitmap));
 }
 
 int ResActor::Patch::GetURes() const
@@ -58,6 +58,17 @@ class ResActor
 
 	protected:
 
+		// Bitmap drawn instead of the actor's own bitmaps with the given ids
+		class MR_DllDeclare BitmapSubst
+		{
+			public:
+				const int *mResIds;
+				int mNbResIds;
+				const VideoServices::Bitmap *mBitmap;
+
+				const VideoServices::Bitmap *Select(const ResBitmap *pBitmap) const;
+		};
+
 		class MR_DllDeclare ActorComponent
 		{
 			public:
@@ -65,7 +76,8 @@ class ResActor
 				virtual ~ ActorComponent();
 				virtual eComponentType GetType() const = 0;
 				virtual void Serialize(Parcel::ObjStream &pArchive, ResourceLib *pLib) = 0;
-				virtual void Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix) const = 0;
+				virtual void Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix, const BitmapSubst *pSubst) const = 0;
+				virtual void DrawTransformed(VideoServices::Viewport3D *pDest, const BitmapSubst *pSubst) const = 0;
 
 		};
 
@@ -76,13 +88,15 @@ class ResActor
 				int mVRes;
 				const ResBitmap *mBitmap;
 				MR_3DCoordinate *mVertexList;
+				int *mNodeIndex;				  // Index of each node in the frame vertex list
 
 				Patch();
 				~Patch();
 
 				eComponentType GetType() const;
 				void Serialize(Parcel::ObjStream &pArchive, ResourceLib *pLib);
-				void Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix) const;
+				void Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix, const BitmapSubst *pSubst) const;
+				void DrawTransformed(VideoServices::Viewport3D *pDest, const BitmapSubst *pSubst) const;
 
 				int GetURes() const;
 				int GetVRes() const;
@@ -95,12 +109,15 @@ class ResActor
 			public:
 				int mNbComponent;
 				ActorComponent **mComponentList;
+				int mNbVertex;
+				MR_3DCoordinate *mVertexList;	  // Distinct nodes of all the patches
 
 				Frame();
 				~Frame();
 				void Clean();
+				void BuildVertexList();
 				void Serialize(Parcel::ObjStream &pArchive, ResourceLib *pLib);
-				void Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix) const;
+				void Draw(VideoServices::Viewport3D *pDest, const VideoServices::PositionMatrix & pMatrix, const BitmapSubst *pSubst = NULL) const;
 
 		};
 
@@ -120,6 +137,9 @@ class ResActor
 		int mResourceId;
 		int mNbSequence;
 		Sequence *mSequenceList;
+		MR_Int32 mRay;							  // Farthest node of any frame from the origin
+
+		void ComputeRay();
 
 	public:
 												  // Only availlable for resourceLib and construction
@@ -130,8 +150,10 @@ class ResActor
 
 		MR_DllDeclare int GetSequenceCount() const;
 		MR_DllDeclare int GetFrameCount(int pSequence) const;
+		MR_DllDeclare MR_Int32 GetRay() const;
 
 		MR_DllDeclare void Serialize(Parcel::ObjStream &pArchive, ResourceLib *pLib = NULL);
+		MR_DllDeclare static void Skip(Parcel::ObjStream &pArchive);
 		MR_DllDeclare void Draw(VideoServices::Viewport3D * pDest, const VideoServices::PositionMatrix & pMatrix, int pSequence, int pFrame) const;
 
 };
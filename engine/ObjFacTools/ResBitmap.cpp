@@ -98,6 +98,47 @@ void ResBitmap::Serialize(Parcel::ObjStream &pArchive)
 
 }
 
+/**
+ * Advance the stream past a serialized bitmap without loading it.
+ * Only the headers are parsed; the texels are skipped.
+ * @param pArchive The archive to read from.
+ */
+void ResBitmap::Skip(Parcel::ObjStream &pArchive)
+{
+	int lWidth, lHeight, lXRes, lYRes, lSubBitmapCount;
+	MR_UInt8 lPlainColor;
+
+	pArchive >> lWidth;
+	pArchive >> lHeight;
+	pArchive >> lXRes;
+	pArchive >> lYRes;
+	pArchive >> lSubBitmapCount;
+	pArchive >> lPlainColor;
+
+	for (int i = 0; i < lSubBitmapCount; i++) {
+		int lSubXRes, lSubYRes, lXShift, lYShift;
+		BOOL lHaveTransparent;
+
+		pArchive >> lSubXRes;
+		pArchive >> lSubYRes;
+		pArchive >> lXShift;
+		pArchive >> lYShift;
+		pArchive >> lHaveTransparent;
+
+		if (lSubXRes < 0 || lSubXRes > MAX_BITMAP_WIDTH ||
+			lSubYRes < 0 || lSubYRes > MAX_BITMAP_HEIGHT)
+		{
+			throw Parcel::ObjStreamExn(
+				pArchive.GetName(),
+				boost::str(boost::format(
+					"Skipping invalid ResBitmap size: %dx%d") %
+						lSubXRes % lSubYRes));
+		}
+
+		pArchive.Skip(static_cast<size_t>(lSubXRes * lSubYRes));
+	}
+}
+
 void ResBitmap::SetWidthHeight(int pWidth, int pHeight)
 {
 	mWidth = pWidth;
@@ -170,16 +211,55 @@ MR_UInt8 **ResBitmap::GetColumnBufferTable(int pSubBitmap) const
 	return mSubBitmapList[pSubBitmap].mColumnPtr;
 } 
 
+MR_UInt8 *ResBitmap::GetTiledBuffer(int pSubBitmap) const
+{
+	return mSubBitmapList[pSubBitmap].GetTiledBuffer();
+}
+
 ResBitmap::SubBitmap::SubBitmap()
 {
 	mBuffer = NULL;
 	mColumnPtr = NULL;
+	mTiledBuffer = NULL;
 }
 
 ResBitmap::SubBitmap::~SubBitmap()
 {
 	delete[] mBuffer;
 	delete[] mColumnPtr;
+	delete[] mTiledBuffer;
+}
+
+/**
+ * Retrieve the tiled copy of the texels (see Bitmap::GetTiledBuffer).
+ * The copy is only built the first time it is requested, so bitmaps cost
+ * no extra memory unless the tiled layout is in use.  The column-major
+ * buffer is kept since sprites and patches still use it.
+ * @return The tiled buffer.
+ */
+MR_UInt8 *ResBitmap::SubBitmap::GetTiledBuffer() const
+{
+	if(mTiledBuffer != NULL) {
+		return mTiledBuffer;
+	}
+
+	// Pad the width to a whole number of tiles.
+	int lStrips = (mXRes + VideoServices::Bitmap::TILE_MASK) >> VideoServices::Bitmap::TILE_SHIFT;
+	auto sz = static_cast<size_t>(lStrips * VideoServices::Bitmap::TILE_SIZE * mYRes);
+
+	mTiledBuffer = new MR_UInt8[sz];
+	memset(mTiledBuffer, 0, sz);
+
+	for(int lColumn = 0; lColumn < mXRes; lColumn++) {
+		const MR_UInt8 *lSrc = mColumnPtr[lColumn];
+		MR_UInt8 *lDest = mTiledBuffer + VideoServices::Bitmap::GetTiledColumnOffset(lColumn, mYRes);
+
+		for(int lRow = 0; lRow < mYRes; lRow++) {
+			lDest[VideoServices::Bitmap::GetTiledRowOffset(lRow)] = lSrc[lRow];
+		}
+	}
+
+	return mTiledBuffer;
 }
 
 void ResBitmap::SubBitmap::Serialize(Parcel::ObjStream &pArchive)
@@ -202,11 +282,13 @@ void ResBitmap::SubBitmap::Serialize(Parcel::ObjStream &pArchive)
 						mXRes % mYRes));
 		}
 
-		pArchive.Write(mBuffer, static_cast<size_t>(mXRes * mYRes));
+		pArchive.WriteArray(mBuffer, static_cast<size_t>(mXRes * mYRes));
 	}
 	else {
 		delete[] mBuffer;
 		delete[] mColumnPtr;
+		delete[] mTiledBuffer;
+		mTiledBuffer = NULL;
 
 		pArchive >> mXRes;
 		pArchive >> mYRes;
@@ -234,7 +316,7 @@ void ResBitmap::SubBitmap::Serialize(Parcel::ObjStream &pArchive)
 			mColumnPtr[lCounter] = lPtr;
 			lPtr += mYRes;
 		}
-		pArchive.Read(mBuffer, sz);
+		pArchive.ReadArray(mBuffer, sz);
 	}
 }
 
@@ -58,11 +58,13 @@ class ResBitmap : public VideoServices::Bitmap
 
 				MR_UInt8 *mBuffer;
 				MR_UInt8 **mColumnPtr;
+				mutable MR_UInt8 *mTiledBuffer;  // Same texels, tiled layout (built on first use)
 
 				MR_DllDeclare SubBitmap();
 				MR_DllDeclare ~ SubBitmap();
 
 				void Serialize(Parcel::ObjStream &pArchive);
+				MR_UInt8 *GetTiledBuffer() const;
 
 		};
 
@@ -83,6 +85,7 @@ class ResBitmap : public VideoServices::Bitmap
 
 		MR_DllDeclare int GetResourceId() const;
 		MR_DllDeclare void Serialize(Parcel::ObjStream &pArchive);
+		MR_DllDeclare static void Skip(Parcel::ObjStream &pArchive);
 
 		MR_DllDeclare int GetWidth() const;
 		MR_DllDeclare int GetHeight() const;
@@ -101,6 +104,7 @@ class ResBitmap : public VideoServices::Bitmap
 		MR_DllDeclare MR_UInt8 *GetBuffer(int pSubBitmap) const;
 		MR_DllDeclare MR_UInt8 *GetColumnBuffer(int pSubBitmap, int pColumn) const;
 		MR_DllDeclare MR_UInt8 **GetColumnBufferTable(int pSubBitmap) const;
+		MR_DllDeclare MR_UInt8 *GetTiledBuffer(int pSubBitmap) const;
 };
 
 }  // namespace ObjFacTools
@@ -20,7 +20,9 @@
 // and limitations under the License.
 
 #include "../Parcel/ClassicRecordFile.h"
+#include "../Parcel/MappedRecordFile.h"
 #include "../Parcel/ObjStream.h"
+#include "../Util/Config.h"
 
 #include "ResourceLib.h"
 
@@ -59,6 +61,76 @@ void LoadRes(ObjStream &os, std::map<int, std::unique_ptr<T>> &res, ResourceLib
 	}
 }
 
+/**
+ * Record where each resource in a section starts, without loading it.
+ * @param os The stream, positioned at the start of the section.
+ * @param offsets The map to fill with the offset of each resource.
+ */
+template<class T>
+void IndexRes(ObjStream &os, std::map<int, MR_UInt64> &offsets)
+{
+	MR_UInt32 num;
+	os >> num;
+	for (MR_UInt32 i = 0; i < num; ++i) {
+		MR_Int32 key;
+		os >> key;
+
+		offsets.emplace(key, os.GetPosition());
+		T::Skip(os);
+	}
+}
+
+/**
+ * Puts a stream back at its current position when going out of scope.
+ */
+class PositionGuard
+{
+public:
+	PositionGuard(ObjStream &os) : os(os), pos(os.GetPosition()) { }
+	~PositionGuard() { os.SetPosition(pos); }
+
+private:
+	ObjStream &os;
+	MR_UInt64 pos;
+};
+
+/**
+ * Look up a resource, loading it first if it has only been indexed.
+ * A resource that fails to load is not indexed anymore, so it is only
+ * attempted once.
+ * @param id The resource ID.
+ * @param res The loaded resources.
+ * @param offsets The indexed (not yet loaded) resources.
+ * @param os The stream to load from (may be @c nullptr if not lazy).
+ * @param self The owning library.
+ * @return The resource, or @c nullptr if not found.
+ * @throws ObjStreamExn The resource failed to load.
+ */
+template<class T>
+T *FindRes(int id, std::map<int, std::unique_ptr<T>> &res,
+	std::map<int, MR_UInt64> &offsets, ObjStream *os, ResourceLib *self)
+{
+	auto iter = res.find(id);
+	if (iter != res.end()) return iter->second.get();
+	if (!os) return nullptr;
+
+	auto offIter = offsets.find(id);
+	if (offIter == offsets.end()) return nullptr;
+
+	MR_UInt64 pos = offIter->second;
+	offsets.erase(offIter);
+
+	// Loading an actor may load its bitmaps from the same stream, so
+	// put the stream back where we found it when we're done.
+	PositionGuard guard(*os);
+	os->SetPosition(pos);
+
+	std::unique_ptr<T> val(new T(id));
+	NewRes(val.get(), *os, self);
+
+	return res.emplace(id, std::move(val)).first->second.get();
+}
+
 }  // namespace
 
 /**
@@ -72,11 +144,19 @@ ResourceLib::ResourceLib()
  * Constructor for loaded library.
  * @param filename The resource data file.
  */
-ResourceLib::ResourceLib(const Util::OS::path_t &filename) :
-	recordFile(new ClassicRecordFile())
+ResourceLib::ResourceLib(const Util::OS::path_t &filename)
 {
-	if (!recordFile->OpenForRead(filename)) {
-		throw ObjStreamExn(filename, "File not found or not readable");
+	if (Util::Config::GetInstance()->runtime.mappedParcels) {
+		recordFile.reset(new MappedRecordFile());
+		if (!recordFile->OpenForRead(filename)) {
+			recordFile.reset();
+		}
+	}
+	if (!recordFile) {
+		recordFile.reset(new ClassicRecordFile());
+		if (!recordFile->OpenForRead(filename)) {
+			throw ObjStreamExn(filename, "File not found or not readable");
+		}
 	}
 
 	recordFile->SelectRecord(0);
@@ -94,11 +174,23 @@ ResourceLib::ResourceLib(const Util::OS::path_t &filename) :
 				expectedMagic % magic));
 	}
 
-	LoadRes(os, bitmaps, this);
-	LoadRes(os, actors, this);
-	LoadRes(os, sprites, this);
-	LoadRes(os, shortSounds, this);
-	LoadRes(os, continuousSounds, this);
+	if (Util::Config::GetInstance()->runtime.lazyResources) {
+		IndexRes<ResBitmap>(os, bitmapOffsets);
+		IndexRes<ResActor>(os, actorOffsets);
+		IndexRes<ResSprite>(os, spriteOffsets);
+		// Sounds are registered with the sound server as they are loaded,
+		// which must stay on this thread.
+		LoadRes(os, shortSounds, this);
+		LoadRes(os, continuousSounds, this);
+		lazyStream = osPtr;
+	}
+	else {
+		LoadRes(os, bitmaps, this);
+		LoadRes(os, actors, this);
+		LoadRes(os, sprites, this);
+		LoadRes(os, shortSounds, this);
+		LoadRes(os, continuousSounds, this);
+	}
 }
 
 ResourceLib::~ResourceLib()
@@ -107,20 +199,20 @@ ResourceLib::~ResourceLib()
 
 ResBitmap *ResourceLib::GetBitmap(int id)
 {
-	auto iter = bitmaps.find(id);
-	return (iter == bitmaps.end()) ? nullptr : iter->second.get();
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+	return FindRes(id, bitmaps, bitmapOffsets, lazyStream.get(), this);
 }
 
 const ResActor *ResourceLib::GetActor(int id)
 {
-	auto iter = actors.find(id);
-	return (iter == actors.end()) ? nullptr : iter->second.get();
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+	return FindRes(id, actors, actorOffsets, lazyStream.get(), this);
 }
 
 const ResSprite *ResourceLib::GetSprite(int id)
 {
-	auto iter = sprites.find(id);
-	return (iter == sprites.end()) ? nullptr : iter->second.get();
+	std::lock_guard<std::recursive_mutex> lock(mutex);
+	return FindRes(id, sprites, spriteOffsets, lazyStream.get(), this);
 }
 
 const ResShortSound *ResourceLib::GetShortSound(int id)
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 
 #include "../Util/OS.h"
 #include "ResActor.h"
@@ -50,6 +51,11 @@ namespace ObjFacTools {
 
 /**
  * Legacy resource manager for ObjFac1.dat resources.
+ *
+ * When Config::runtime_t::lazyResources is set, the constructor only records
+ * where each bitmap, actor and sprite starts; the resource itself is loaded
+ * on first use.  Sounds are always loaded by the constructor, so that they
+ * are created on the same thread as the sound server.
  * @author Michael Imamura
  */
 class MR_DllDeclare ResourceLib
@@ -69,6 +75,12 @@ public:
 
 protected:
 	std::unique_ptr<Parcel::RecordFile> recordFile;
+	std::shared_ptr<Parcel::ObjStream> lazyStream;  ///< Set only in lazy mode.
+	std::recursive_mutex mutex;
+
+	std::map<int, MR_UInt64> bitmapOffsets;
+	std::map<int, MR_UInt64> actorOffsets;
+	std::map<int, MR_UInt64> spriteOffsets;
 
 	std::map<int, std::unique_ptr<ResBitmap>> bitmaps;
 	std::map<int, std::unique_ptr<ResActor>> actors;
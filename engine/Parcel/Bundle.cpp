@@ -19,8 +19,10 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include "../Util/Config.h"
 #include "../Util/Str.h"
 #include "ClassicRecordFile.h"
+#include "MappedRecordFile.h"
 
 #include "Bundle.h"
 
@@ -53,29 +55,67 @@ Bundle::Bundle(const OS::path_t &dir, std::shared_ptr<Bundle> subBundle) :
  */
 std::shared_ptr<RecordFile> Bundle::OpenParcel(
 	const std::string &name, bool writing) const
+{
+	OS::path_t pt = FindParcel(name);
+	return pt.empty() ?
+		std::shared_ptr<RecordFile>() :
+		OpenParcelFile(pt, writing);
+}
+
+/**
+ * Find the file of an existing parcel.
+ * All parcels, including sub-bundles, will be searched.
+ * @param name The name of the parcel.
+ * @return The path to the parcel file (empty if parcel does not exist).
+ */
+OS::path_t Bundle::FindParcel(const std::string &name) const
 {
 	OS::path_t pt = dir / Str::UP(name.c_str());
 
 	if (fs::exists(pt)) {
-		RecordFile *rec = new ClassicRecordFile();
-		if (writing) {
-			rec->OpenForWrite(pt);
-		}
-		else {
-			rec->OpenForRead(pt);
-		}
-		return std::shared_ptr<RecordFile>(rec);
+		return pt;
 	}
 	else {
 		if (!subBundle) {
-			return std::shared_ptr<RecordFile>();
+			return OS::path_t();
 		}
 		else {
-			return subBundle->OpenParcel(name, writing);
+			return subBundle->FindParcel(name);
 		}
 	}
 }
 
+/**
+ * Open a specific parcel file, bypassing the bundle search.
+ *
+ * Read-only parcels are memory-mapped unless disabled in the runtime config;
+ * if the file cannot be mapped, then it is read as a stream instead.
+ *
+ * @param path The path to the parcel file (must exist).
+ * @param writing @c true if the parcel will be written to,
+ *                @c false if read-only.
+ * @return The parcel (never @c nullptr).
+ */
+std::shared_ptr<RecordFile> Bundle::OpenParcelFile(
+	const OS::path_t &path, bool writing)
+{
+	if (!writing && Config::GetInstance()->runtime.mappedParcels) {
+		auto mapped = std::make_shared<MappedRecordFile>();
+		if (mapped->OpenForRead(path)) {
+			return mapped;
+		}
+	}
+
+	RecordFile *rec = new ClassicRecordFile();
+	if (writing) {
+		rec->OpenForWrite(path);
+	}
+	else {
+		rec->OpenForRead(path);
+	}
+	return std::shared_ptr<RecordFile>(rec);
+}
+
 // class Iterator
 
 const OS::dirIter_t Bundle::Iterator::END;
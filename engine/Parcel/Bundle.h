@@ -49,9 +49,13 @@ public:
 		std::shared_ptr<Bundle> subBundle = std::shared_ptr<Bundle>());
 	virtual ~Bundle() { }
 
+	Util::OS::path_t FindParcel(const std::string &name) const;
 	virtual std::shared_ptr<RecordFile> OpenParcel(
 		const std::string &name, bool writing = false) const;
 
+	static std::shared_ptr<RecordFile> OpenParcelFile(
+		const Util::OS::path_t &path, bool writing = false);
+
 private:
 	class MR_DllDeclare Iterator :
 		public std::iterator<std::input_iterator_tag, Util::OS::dirEnt_t>
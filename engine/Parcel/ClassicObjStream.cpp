@@ -179,5 +179,28 @@ MR_UInt32 ClassicObjStream::ReadStringLength()
 	}
 }
 
+void ClassicObjStream::Skip(size_t ct)
+{
+	if (fseek(stream, static_cast<long>(ct), SEEK_CUR) != 0) {
+		throw ObjStreamExn(GetName(), _("Seek failed"));
+	}
+}
+
+MR_UInt64 ClassicObjStream::GetPosition() const
+{
+	long pos = ftell(stream);
+	if (pos < 0) {
+		throw ObjStreamExn(GetName(), Util::OS::StrError(errno));
+	}
+	return static_cast<MR_UInt64>(pos);
+}
+
+void ClassicObjStream::SetPosition(MR_UInt64 pos)
+{
+	if (fseek(stream, static_cast<long>(pos), SEEK_SET) != 0) {
+		throw ObjStreamExn(GetName(), _("Seek failed"));
+	}
+}
+
 }  // namespace Parcel
 }  // namespace HoverRace
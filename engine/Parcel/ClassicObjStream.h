@@ -95,6 +95,11 @@ class MR_DllDeclare ClassicObjStream : public ObjStream
 	private:
 		MR_UInt32 ReadStringLength();
 
+	public:
+		void Skip(size_t ct) override;
+		MR_UInt64 GetPosition() const override;
+		void SetPosition(MR_UInt64 pos) override;
+
 	private:
 		FILE *stream;
 };
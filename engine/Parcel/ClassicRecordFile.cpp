@@ -23,6 +23,7 @@
 #include "../Util/Log.h"
 #include "../Util/Str.h"
 #include "ClassicObjStream.h"
+#include "ClassicRecordFileHeader.h"
 
 #include "ClassicRecordFile.h"
 
@@ -33,44 +34,7 @@ using namespace HoverRace::Util;
 namespace HoverRace {
 namespace Parcel {
 
-namespace {
-
-/**
- * Used internally to signal errors in ClassicRecordFileHeader.
- */
-class ClassicRecordFileExn : public Exception
-{
-	using SUPER = Exception;
-
-public:
-	ClassicRecordFileExn() : SUPER() { }
-	ClassicRecordFileExn(const std::string &msg) : SUPER(msg) { }
-	virtual ~ClassicRecordFileExn() noexcept { }
-};
-
-}  // namespace
-
-class ClassicRecordFileHeader : public Util::Inspectable /*{{{*/
-{
-	using SUPER = Util::Inspectable;
-
-public:
-	ClassicRecordFileHeader();
-	ClassicRecordFileHeader(MR_UInt32 numRecords);
-	virtual ~ClassicRecordFileHeader();
-
-	void Serialize(ObjStream &os);
-
-	void Inspect(Util::InspectMapNode &node) const override;
-
-public:
-	std::string title;
-	bool sumValid;
-	MR_UInt32 checksum;
-	MR_UInt32 recordsUsed;
-	MR_UInt32 recordsMax;
-	MR_UInt32 *recordList;
-};
+//{{{ ClassicRecordFileHeader
 
 ClassicRecordFileHeader::ClassicRecordFileHeader() :
 	SUPER(), sumValid(false), checksum(0),
@@ -106,9 +70,7 @@ void ClassicRecordFileHeader::Serialize(ObjStream &os)
 			(MR_Int32) 0 << (MR_Int32) 0;
 
 		if (recordsMax > 0) {
-			for (unsigned int i = 0; i < recordsMax; ++i) {
-				os << recordList[i];
-			}
+			os.WriteArray(recordList, recordsMax);
 		}
 	}
 	else {
@@ -133,9 +95,7 @@ void ClassicRecordFileHeader::Serialize(ObjStream &os)
 		else {
 			if (recordsMax > 0) {
 				recordList = new MR_UInt32[recordsMax];
-				for (unsigned int i = 0; i < recordsMax; ++i) {
-					os >> recordList[i];
-				}
+				os.ReadArray(recordList, recordsMax);
 			}
 		}
 	}
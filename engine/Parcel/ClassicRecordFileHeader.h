@@ -0,0 +1,74 @@
+
+// ClassicRecordFileHeader.h
+//
+// Copyright (c) 2010, 2012, 2015, 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include "../Exception.h"
+#include "../Util/Inspectable.h"
+#include "../Util/MR_Types.h"
+
+namespace HoverRace {
+namespace Parcel {
+
+class ObjStream;
+
+/**
+ * Used internally to signal errors in ClassicRecordFileHeader.
+ */
+class ClassicRecordFileExn : public Exception
+{
+	using SUPER = Exception;
+
+public:
+	ClassicRecordFileExn() : SUPER() { }
+	ClassicRecordFileExn(const std::string &msg) : SUPER(msg) { }
+	virtual ~ClassicRecordFileExn() noexcept { }
+};
+
+/**
+ * The header (title and record table) of a HoverRace 1.x parcel.
+ * Shared by the parcel readers; not part of the public API.
+ * @author Michael Imamura
+ */
+class ClassicRecordFileHeader : public Util::Inspectable
+{
+	using SUPER = Util::Inspectable;
+
+public:
+	ClassicRecordFileHeader();
+	ClassicRecordFileHeader(MR_UInt32 numRecords);
+	virtual ~ClassicRecordFileHeader();
+
+	void Serialize(ObjStream &os);
+
+	void Inspect(Util::InspectMapNode &node) const override;
+
+public:
+	std::string title;
+	bool sumValid;
+	MR_UInt32 checksum;
+	MR_UInt32 recordsUsed;
+	MR_UInt32 recordsMax;
+	MR_UInt32 *recordList;
+};
+
+}  // namespace Parcel
+}  // namespace HoverRace
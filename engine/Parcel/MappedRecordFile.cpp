@@ -0,0 +1,187 @@
+
+// MappedRecordFile.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "../Util/InspectMapNode.h"
+#include "../Util/Log.h"
+#include "ClassicRecordFileHeader.h"
+#include "MemObjStream.h"
+
+#include "MappedRecordFile.h"
+
+using namespace HoverRace::Util;
+
+namespace HoverRace {
+namespace Parcel {
+
+MappedRecordFile::MappedRecordFile() :
+	SUPER(), curRecord(0), curOffset(0)
+{
+}
+
+MappedRecordFile::~MappedRecordFile()
+{
+}
+
+bool MappedRecordFile::CreateForWrite(const Util::OS::path_t &filename,
+	MR_UInt32, const char*)
+{
+	HR_LOG(error) << "" << filename << ": Cannot create (read-only parcel).";
+	return false;
+}
+
+bool MappedRecordFile::OpenForWrite(const Util::OS::path_t &filename)
+{
+	HR_LOG(error) << "" << filename << ": Cannot open for writing "
+		"(read-only parcel).";
+	return false;
+}
+
+bool MappedRecordFile::OpenForRead(const Util::OS::path_t &filename, bool)
+{
+	if (header) {
+		HR_LOG(error) << "" << filename << ": Cannot open (already open).";
+		return false;
+	}
+
+	this->filename = filename;
+
+	try {
+		file.open(filename);
+	}
+	catch (std::exception &ex) {
+		HR_LOG(error) << "" << filename << ": Failed to map: " << ex.what();
+		return false;
+	}
+
+	MemObjStream objStream(file.data(), file.data() + file.size(), filename);
+	std::unique_ptr<ClassicRecordFileHeader> newHeader{
+		new ClassicRecordFileHeader() };
+	try {
+		newHeader->Serialize(objStream);
+	}
+	catch (Exception &ex) {
+		HR_LOG(error) << "" << filename << ": " << ex.what();
+		file.close();
+		return false;
+	}
+
+	if (!newHeader->recordList) {
+		HR_LOG(error) << "" << filename << ": Failed to read header or no records.";
+		file.close();
+		return false;
+	}
+
+	// Check the record table up front so that SelectRecord() never points
+	// outside of the mapping.
+	if (newHeader->recordsUsed > newHeader->recordsMax) {
+		HR_LOG(error) << "" << filename << ": Corrupt record table.";
+		file.close();
+		return false;
+	}
+	for (MR_UInt32 i = 0; i < newHeader->recordsUsed; ++i) {
+		if (newHeader->recordList[i] > file.size()) {
+			HR_LOG(error) << "" << filename << ": Record " << i <<
+				" is past the end of the file.";
+			file.close();
+			return false;
+		}
+	}
+
+	header = std::move(newHeader);
+	curRecord = 0;
+	curOffset = 0;
+
+	//TODO: Validate checksum;
+	return true;
+}
+
+bool MappedRecordFile::ApplyChecksum(const OS::path_t &filename)
+{
+	HR_LOG(error) << "" << filename << ": Cannot apply checksum "
+		"(read-only parcel).";
+	return false;
+}
+
+DWORD MappedRecordFile::GetAlignMode()
+{
+	return header ? header->checksum : 0;
+}
+
+MR_UInt32 MappedRecordFile::GetNbRecords() const
+{
+	return header ? header->recordsUsed : 0;
+}
+
+void MappedRecordFile::SelectRecord(MR_UInt32 i)
+{
+	if (header) {
+		if (i < header->recordsUsed) {
+			curRecord = i;
+			curOffset = header->recordList[i];
+		}
+		else {
+			HR_LOG(error) << "" << filename << "Invalid record (" << i << ") out of "
+				"allocated records (" << header->recordsUsed << ").";
+		}
+	}
+}
+
+bool MappedRecordFile::BeginANewRecord()
+{
+	HR_LOG(error) << "" << filename << ": Not initialized for writing.";
+	return false;
+}
+
+void MappedRecordFile::Inspect(Util::InspectMapNode &node) const
+{
+	node.
+		AddField("curRecord", curRecord).
+		AddField("mappedSize", static_cast<MR_UInt64>(file.size())).
+		AddSubobject("header", header.get());
+}
+
+/**
+ * Open an object stream for reading at the current record.
+ * The stream may read up to the end of the file; it reads from the mapping,
+ * so it must not outlive this parcel.
+ * @return The stream (never @c nullptr).
+ * @throw ObjStreamExn The parcel is not open.
+ */
+ObjStreamPtr MappedRecordFile::StreamIn()
+{
+	if (!header) {
+		throw ObjStreamExn(filename, "Parcel is not open");
+	}
+	return std::make_shared<MemObjStream>(
+		file.data() + curOffset, file.data() + file.size(), filename);
+}
+
+/**
+ * Writing is not supported by this parcel implementation.
+ * @throw ObjStreamExn Always.
+ */
+ObjStreamPtr MappedRecordFile::StreamOut()
+{
+	throw ObjStreamExn(filename, "Cannot write to a read-only parcel");
+}
+
+}  // namespace Parcel
+}  // namespace HoverRace
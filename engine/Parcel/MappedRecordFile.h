@@ -0,0 +1,92 @@
+
+// MappedRecordFile.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "RecordFile.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+namespace Parcel {
+
+class ClassicRecordFileHeader;
+
+/**
+ * Read-only reader for the standard HoverRace 1.x parcel format.
+ *
+ * The whole file is memory-mapped when it is opened, and each record is
+ * read with a MemObjStream directly from the mapping, so there is no
+ * stdio call per value read.
+ *
+ * Use ClassicRecordFile to create or modify parcels.
+ *
+ * @author Michael Imamura
+ */
+class MR_DllDeclare MappedRecordFile : public RecordFile
+{
+	using SUPER = RecordFile;
+
+public:
+	MappedRecordFile();
+	virtual ~MappedRecordFile();
+
+	bool CreateForWrite(const Util::OS::path_t &filename, MR_UInt32 numRecords,
+		const char *title = nullptr) override;
+	bool OpenForWrite(const Util::OS::path_t &filename) override;
+	bool OpenForRead(const Util::OS::path_t &filename,
+		bool validateChecksum = false) override;
+
+	bool ApplyChecksum(const Util::OS::path_t &filename) override;
+
+	DWORD GetAlignMode() override;
+
+	MR_UInt32 GetNbRecords() const override;
+	void SelectRecord(MR_UInt32 i) override;
+	bool BeginANewRecord() override;
+
+	void Inspect(Util::InspectMapNode &node) const override;
+
+	ObjStreamPtr StreamIn() override;
+	ObjStreamPtr StreamOut() override;
+
+private:
+	MR_UInt32 curRecord;
+	size_t curOffset;
+	std::unique_ptr<ClassicRecordFileHeader> header;
+	boost::iostreams::mapped_file_source file;
+	Util::OS::path_t filename;
+};
+
+}  // namespace Parcel
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
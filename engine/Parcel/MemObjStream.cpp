@@ -0,0 +1,166 @@
+
+// MemObjStream.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "../Util/Log.h"
+#include "../Exception.h"
+
+#include "MemObjStream.h"
+
+namespace HoverRace {
+namespace Parcel {
+
+namespace {
+const size_t MAX_STRING_LEN = 16 * 1024;  ///< Maximum length of a string.
+}
+
+/**
+ * Constructor.
+ * @param begin The start of the data.
+ * @param end One past the end of the data.
+ * @param name The name of the stream (for error messages).
+ */
+MemObjStream::MemObjStream(const char *begin, const char *end,
+	const Util::OS::path_t &name) :
+	SUPER(name, 1, false),
+	begin(begin), pos(begin), end(end)
+{
+	// Version is always 1, same as ClassicObjStream.
+}
+
+void MemObjStream::SetPosition(MR_UInt64 newPos)
+{
+	if (newPos > static_cast<MR_UInt64>(end - begin)) {
+		throw ObjStreamExn(GetName(), _("Seek past end of record"));
+	}
+	pos = begin + newPos;
+}
+
+void MemObjStream::ThrowReadOnly() const
+{
+	throw ObjStreamExn(GetName(), _("Stream is read-only"));
+}
+
+void MemObjStream::WriteUInt8(MR_UInt8)
+{
+	ThrowReadOnly();
+}
+
+void MemObjStream::WriteInt16(MR_Int16)
+{
+	ThrowReadOnly();
+}
+
+void MemObjStream::WriteUInt16(MR_UInt16)
+{
+	ThrowReadOnly();
+}
+
+void MemObjStream::WriteInt32(MR_Int32)
+{
+	ThrowReadOnly();
+}
+
+void MemObjStream::WriteUInt32(MR_UInt32)
+{
+	ThrowReadOnly();
+}
+
+void MemObjStream::WriteString(const std::string&)
+{
+	ThrowReadOnly();
+}
+
+void MemObjStream::ReadUInt8(MR_UInt8 &i)
+{
+	ReadBuf(&i, 1);
+}
+
+void MemObjStream::ReadInt16(MR_Int16 &i)
+{
+	ReadBuf(&i, 2);
+	//TODO: Big-endian conversion.
+}
+
+void MemObjStream::ReadUInt16(MR_UInt16 &i)
+{
+	ReadBuf(&i, 2);
+	//TODO: Big-endian conversion.
+}
+
+void MemObjStream::ReadInt32(MR_Int32 &i)
+{
+	ReadBuf(&i, 4);
+	//TODO: Big-endian conversion.
+}
+
+void MemObjStream::ReadUInt32(MR_UInt32 &i)
+{
+	ReadBuf(&i, 4);
+	//TODO: Big-endian conversion.
+}
+
+void MemObjStream::ReadString(std::string &s)
+{
+	MR_UInt32 len = ReadStringLength();
+	MR_UInt32 remaining = 0;
+	if (len > MAX_STRING_LEN) {
+		HR_LOG(warning) << "String length (" << len << ") exceeds max (" <<
+			MAX_STRING_LEN << "); truncating.";
+		remaining = len - static_cast<MR_Int32>(MAX_STRING_LEN);
+		len = MAX_STRING_LEN;
+	}
+
+	// No intermediate buffer; the string is copied straight from the block.
+	CheckAvail(len);
+	s.assign(pos, len);
+	pos += len;
+
+	// Skip excess.
+	if (remaining > 0) {
+		CheckAvail(remaining);
+		pos += remaining;
+	}
+}
+
+MR_UInt32 MemObjStream::ReadStringLength()
+{
+	MR_UInt8 b;
+	ReadUInt8(b);
+	if (b < 0xff) return b;
+
+	MR_UInt16 w;
+	ReadUInt16(w);
+	if (w == 0xfffe) {
+		// Unicode (length follows).
+		throw UnimplementedExn("MemObjStream::ReadStringLength for unicode strings");
+	}
+	else if (w == 0xffff) {
+		MR_UInt32 dw;
+		ReadUInt32(dw);
+		return dw;
+	}
+	else {
+		return w;
+	}
+}
+
+}  // namespace Parcel
+}  // namespace HoverRace
@@ -0,0 +1,129 @@
+
+// MemObjStream.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <string.h>
+
+#include "ObjStream.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+namespace Parcel {
+
+/**
+ * Read-only parcel data stream over a block of memory.
+ *
+ * The data uses the same layout as ClassicObjStream, but is read directly
+ * from memory (usually a memory-mapped file) instead of through stdio.
+ * Every read is checked against the end of the block; reading past the end
+ * throws ObjStreamExn instead of reading outside of the block.
+ *
+ * The memory must outlive the stream.
+ *
+ * @author Michael Imamura
+ * @todo Handle big-endian platforms.
+ */
+class MR_DllDeclare MemObjStream : public ObjStream
+{
+	using SUPER = ObjStream;
+
+public:
+	MemObjStream(const char *begin, const char *end,
+		const Util::OS::path_t &name);
+	virtual ~MemObjStream() { }
+
+private:
+	void ThrowReadOnly() const;
+
+public:
+	void Write(const void*, size_t) override { ThrowReadOnly(); }
+
+	void WriteUInt8(MR_UInt8 i) override;
+	void WriteInt16(MR_Int16 i) override;
+	void WriteUInt16(MR_UInt16 i) override;
+	void WriteInt32(MR_Int32 i) override;
+	void WriteUInt32(MR_UInt32 i) override;
+	void WriteString(const std::string &s) override;
+#	if defined(_WIN32) && !defined(WITH_OBJSTREAM)
+		void WriteCString(const CString&) override { ThrowReadOnly(); }
+#	endif
+
+private:
+	void CheckAvail(size_t ct) const
+	{
+		if (ct > static_cast<size_t>(end - pos)) {
+			throw ObjStreamExn(GetName(), _("Read past end of record"));
+		}
+	}
+
+	void ReadBuf(void *buf, size_t ct)
+	{
+		CheckAvail(ct);
+		memcpy(buf, pos, ct);
+		pos += ct;
+	}
+
+public:
+	void Read(void *buf, size_t ct) override { ReadBuf(buf, ct); }
+
+	void ReadUInt8(MR_UInt8 &i) override;
+	void ReadInt16(MR_Int16 &i) override;
+	void ReadUInt16(MR_UInt16 &i) override;
+	void ReadInt32(MR_Int32 &i) override;
+	void ReadUInt32(MR_UInt32 &i) override;
+	void ReadString(std::string &s) override;
+#	if defined(_WIN32) && !defined(WITH_OBJSTREAM)
+		void ReadCString(CString &s) override { std::string ss; ReadString(ss); s = ss.c_str(); }
+#	endif
+
+	/**
+	 * Retrieve the number of bytes remaining in the block.
+	 * @return The number of bytes.
+	 */
+	size_t GetRemaining() const { return static_cast<size_t>(end - pos); }
+
+	void Skip(size_t ct) override { CheckAvail(ct); pos += ct; }
+	MR_UInt64 GetPosition() const override { return static_cast<MR_UInt64>(pos - begin); }
+	void SetPosition(MR_UInt64 newPos) override;
+
+private:
+	MR_UInt32 ReadStringLength();
+
+private:
+	const char *begin;
+	const char *pos;
+	const char *end;
+};
+
+}  // namespace Parcel
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
@@ -19,6 +19,8 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <SDL2/SDL_endian.h>
+
 #include "../Util/Str.h"
 
 #include "ObjStream.h"
@@ -28,6 +30,52 @@ namespace Str = HoverRace::Util::Str;
 namespace HoverRace {
 namespace Parcel {
 
+namespace {
+
+// Parcels are always little-endian.
+// On little-endian platforms the array functions compile down to a single
+// Read/Write, so the swaps are only needed on big-endian platforms.
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+MR_UInt8 SwapLE(MR_UInt8 i) { return i; }
+MR_UInt16 SwapLE(MR_UInt16 i) { return SDL_SwapLE16(i); }
+MR_Int16 SwapLE(MR_Int16 i) { return static_cast<MR_Int16>(SDL_SwapLE16(static_cast<MR_UInt16>(i))); }
+MR_UInt32 SwapLE(MR_UInt32 i) { return SDL_SwapLE32(i); }
+MR_Int32 SwapLE(MR_Int32 i) { return static_cast<MR_Int32>(SDL_SwapLE32(static_cast<MR_UInt32>(i))); }
+#endif
+
+template<class T>
+void WriteArrayImpl(ObjStream &os, const T *buf, size_t ct)
+{
+	// Empty arrays may not even be allocated.
+	if (ct == 0) return;
+
+#	if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		std::vector<T> swapped(buf, buf + ct);
+		for (auto &i : swapped) {
+			i = SwapLE(i);
+		}
+		os.Write(swapped.data(), ct * sizeof(T));
+#	else
+		os.Write(buf, ct * sizeof(T));
+#	endif
+}
+
+template<class T>
+void ReadArrayImpl(ObjStream &os, T *buf, size_t ct)
+{
+	if (ct == 0) return;
+
+	os.Read(buf, ct * sizeof(T));
+#	if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		for (size_t i = 0; i < ct; i++) {
+			buf[i] = SwapLE(buf[i]);
+		}
+#	endif
+}
+
+}  // namespace
+
 ObjStreamExn::ObjStreamExn(const Util::OS::path_t &path,
 	const std::string &details) :
 	SUPER((const char*)Str::PU(path))
@@ -37,5 +85,55 @@ ObjStreamExn::ObjStreamExn(const Util::OS::path_t &path,
 	msg += details;
 }
 
+void ObjStream::WriteArray(const MR_UInt8 *buf, size_t ct)
+{
+	WriteArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::WriteArray(const MR_Int16 *buf, size_t ct)
+{
+	WriteArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::WriteArray(const MR_UInt16 *buf, size_t ct)
+{
+	WriteArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::WriteArray(const MR_Int32 *buf, size_t ct)
+{
+	WriteArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::WriteArray(const MR_UInt32 *buf, size_t ct)
+{
+	WriteArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::ReadArray(MR_UInt8 *buf, size_t ct)
+{
+	ReadArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::ReadArray(MR_Int16 *buf, size_t ct)
+{
+	ReadArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::ReadArray(MR_UInt16 *buf, size_t ct)
+{
+	ReadArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::ReadArray(MR_Int32 *buf, size_t ct)
+{
+	ReadArrayImpl(*this, buf, ct);
+}
+
+void ObjStream::ReadArray(MR_UInt32 *buf, size_t ct)
+{
+	ReadArrayImpl(*this, buf, ct);
+}
+
 }  // namespace Parcel
 }  // namespace HoverRace
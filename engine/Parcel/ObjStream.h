@@ -96,6 +96,18 @@ public:
 		friend ObjStream &operator<<(ObjStream &os, const CString &s) { os.WriteCString(s); return os; }
 #	endif
 
+	/**
+	 * Write an array of values with a single write.
+	 * The result is the same as writing each value in turn.
+	 * @param buf The values.
+	 * @param ct The number of values (not bytes).
+	 */
+	void WriteArray(const MR_UInt8 *buf, size_t ct);
+	void WriteArray(const MR_Int16 *buf, size_t ct);
+	void WriteArray(const MR_UInt16 *buf, size_t ct);
+	void WriteArray(const MR_Int32 *buf, size_t ct);
+	void WriteArray(const MR_UInt32 *buf, size_t ct);
+
 	virtual void Read(void *buf, size_t ct) = 0;
 
 	virtual void ReadUInt8(MR_UInt8 &i) = 0;
@@ -121,6 +133,36 @@ public:
 		friend ObjStream &operator>>(ObjStream &os, CString &s) { os.ReadCString(s); return os; }
 #	endif
 
+	/**
+	 * Read an array of values with a single read.
+	 * The result is the same as reading each value in turn.
+	 * @param[out] buf The destination for the values.
+	 * @param ct The number of values (not bytes).
+	 */
+	void ReadArray(MR_UInt8 *buf, size_t ct);
+	void ReadArray(MR_Int16 *buf, size_t ct);
+	void ReadArray(MR_UInt16 *buf, size_t ct);
+	void ReadArray(MR_Int32 *buf, size_t ct);
+	void ReadArray(MR_UInt32 *buf, size_t ct);
+
+	/**
+	 * Skip over data without reading it.
+	 * @param ct The number of bytes to skip.
+	 */
+	virtual void Skip(size_t ct) = 0;
+
+	/**
+	 * Retrieve the current position in the stream.
+	 * @return The position, only meaningful to SetPosition().
+	 */
+	virtual MR_UInt64 GetPosition() const = 0;
+
+	/**
+	 * Move to a position previously returned by GetPosition().
+	 * @param pos The position.
+	 */
+	virtual void SetPosition(MR_UInt64 pos) = 0;
+
 private:
 	Util::OS::path_t name;
 	int version;
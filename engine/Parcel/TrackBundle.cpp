@@ -19,6 +19,8 @@
 // See the License for the specific language governing permissions
 // and limitations under the License.
 
+#include <mutex>
+
 #include <boost/algorithm/string.hpp>
 
 #include "../Display/SpriteTextureRes.h"
@@ -28,6 +30,7 @@
 #include "../Parcel/RecordFile.h"
 #include "../Util/Config.h"
 #include "../Util/InspectMapNode.h"
+#include "../Util/Str.h"
 #include "ObjStream.h"
 
 #include "TrackBundle.h"
@@ -37,6 +40,100 @@ using namespace HoverRace::Util;
 namespace HoverRace {
 namespace Parcel {
 
+namespace {
+
+/**
+ * Track map texture that is only read from the track file when needed.
+ */
+class TrackMapRes : public Display::Res<Display::Texture>
+{
+	using SUPER = Display::Res<Display::Texture>;
+
+public:
+	TrackMapRes(const std::string &name, const OS::path_t &path,
+		std::shared_ptr<RecordFile> recFile) :
+		SUPER(), name(name),
+		id("spriteTexture:map:" + std::string((const char*)Str::PU(path))),
+		recFile(std::move(recFile)) { }
+	virtual ~TrackMapRes() { }
+
+public:
+	std::string GetId() const override { return id; }
+
+	std::unique_ptr<std::istream> Open() const override
+	{
+		throw Display::ResLoadExn("Attempted to open internal texture.");
+	}
+
+	bool IsGenerated() const override { return true; }
+
+	const ImageData *GetImageData() override
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (!sprite && recFile) {
+			//TODO: Refactor into shared code with Track::LoadMap().
+
+			recFile->SelectRecord(3);
+			ObjStreamPtr archivePtr(recFile->StreamIn());
+			ObjStream &archive = *archivePtr;
+
+			// Ignore track bounds.
+			MR_Int32 i;
+			archive >> i >> i >> i >> i;
+
+			sprite.reset(new Display::SpriteTextureRes("map:" + name, archive));
+			recFile.reset();
+		}
+
+		return sprite ? sprite->GetImageData() : nullptr;
+	}
+
+private:
+	std::string name;
+	std::string id;
+	std::mutex mutex;
+	std::shared_ptr<RecordFile> recFile;
+	std::unique_ptr<Display::SpriteTextureRes> sprite;
+};
+
+/**
+ * Add the ".trk" suffix to a track name if it doesn't already have it.
+ * @param name The name of the track.
+ * @return The name of the track parcel.
+ */
+std::string ParcelName(const std::string &name)
+{
+	return boost::ends_with(name, Config::TRACK_EXT) ?
+		name :
+		name + Config::TRACK_EXT;
+}
+
+/**
+ * Read the track header from an open track parcel.
+ * @param recFile The track parcel.
+ * @param name The name of the track.  The ".trk" suffix may be omitted.
+ * @return The track header (never @c nullptr).
+ * @throws ObjStreamExn The track failed to load.
+ */
+std::shared_ptr<Model::TrackEntry> ReadTrackEntry(RecordFile &recFile,
+	const std::string &name)
+{
+	recFile.SelectRecord(0);
+	auto retv = std::make_shared<Model::TrackEntry>();
+	if (boost::ends_with(name, Config::TRACK_EXT)) {
+		// Trim off ".trk".
+		retv->name.assign(name, 0, name.length() - Config::TRACK_EXT.length());
+	}
+	else {
+		retv->name = name;
+	}
+	retv->Serialize(*recFile.StreamIn());
+	return retv;
+}
+
+}  // namespace
+
 TrackBundle::TrackBundle(const OS::path_t &dir,
 	std::shared_ptr<Bundle> subBundle) :
 	SUPER(dir, subBundle)
@@ -46,11 +143,7 @@ TrackBundle::TrackBundle(const OS::path_t &dir,
 std::shared_ptr<RecordFile> TrackBundle::OpenParcel(
 	const std::string &name, bool writing) const
 {
-	return SUPER::OpenParcel(
-		boost::ends_with(name, Config::TRACK_EXT) ?
-			name :
-			name + Config::TRACK_EXT,
-		writing);
+	return SUPER::OpenParcel(ParcelName(name), writing);
 }
 
 /**
@@ -62,10 +155,10 @@ std::shared_ptr<RecordFile> TrackBundle::OpenParcel(
 std::shared_ptr<Model::Track> TrackBundle::OpenTrack(
 	const std::string &name) const
 {
-	auto recFile = OpenParcel(name);
-	return !recFile ?
+	auto path = FindParcel(ParcelName(name));
+	return path.empty() ?
 		std::shared_ptr<Model::Track>() :
-		std::make_shared<Model::Track>(name, recFile);
+		std::make_shared<Model::Track>(name, OpenParcelFile(path), path);
 }
 
 /**
@@ -81,26 +174,31 @@ std::shared_ptr<Model::Track> TrackBundle::OpenTrack(
 	return OpenTrack(entry->name);
 }
 
+/**
+ * Load the map texture of a track.
+ *
+ * Only the track header is read here; the map itself is read the first
+ * time the image data is requested, which may happen on a loader thread.
+ *
+ * @param entry The entry for the track (may not be @c nullptr).
+ * @return The map texture or @c nullptr if the track has no map.
+ */
 std::shared_ptr<Display::Res<Display::Texture>> TrackBundle::LoadMap(
 	std::shared_ptr<const Model::TrackEntry> entry) const
 {
-	auto recFile = OpenParcel(entry->name);
-	if (!recFile || recFile->GetNbRecords() < 4) {
+	// The texture is shared by ID, so it's keyed on the file instead of the
+	// name; the same name may be in more than one bundle.
+	auto path = FindParcel(ParcelName(entry->name));
+	if (path.empty()) {
 		return std::shared_ptr<Display::Res<Display::Texture>>();
 	}
 
-	//TODO: Refactor into shared code with Track::LoadMap().
-
-	recFile->SelectRecord(3);
-	ObjStreamPtr archivePtr(recFile->StreamIn());
-	ObjStream &archive = *archivePtr;
-
-	// Ignore track bounds.
-	MR_Int32 i;
-	archive >> i >> i >> i >> i;
+	auto recFile = OpenParcelFile(path);
+	if (recFile->GetNbRecords() < 4) {
+		return std::shared_ptr<Display::Res<Display::Texture>>();
+	}
 
-	return std::make_shared<Display::SpriteTextureRes>(
-		"map:" + entry->name, archive);
+	return std::make_shared<TrackMapRes>(entry->name, path, recFile);
 }
 
 
@@ -114,22 +212,24 @@ std::shared_ptr<Model::TrackEntry> TrackBundle::OpenTrackEntry(
 	const std::string &name) const
 {
 	auto recFile = OpenParcel(name);
-	if (!recFile) {
-		return std::shared_ptr<Model::TrackEntry>();
-	}
-	else {
-		recFile->SelectRecord(0);
-		auto retv = std::make_shared<Model::TrackEntry>();
-		if (boost::ends_with(name, Config::TRACK_EXT)) {
-			// Trim off ".trk".
-			retv->name.assign(name, 0, name.length() - Config::TRACK_EXT.length());
-		}
-		else {
-			retv->name = name;
-		}
-		retv->Serialize(*recFile->StreamIn());
-		return retv;
-	}
+	return !recFile ?
+		std::shared_ptr<Model::TrackEntry>() :
+		ReadTrackEntry(*recFile, name);
+}
+
+/**
+ * Load the track header from a specific track file.
+ * Unlike OpenTrackEntry(), this does not search the bundle, so a track
+ * file that is shadowed by a higher-priority bundle can still be read.
+ * @param path The path to the track file (must exist).
+ * @return The track header (never @c nullptr).
+ * @throws ObjStreamExn The track failed to load.
+ */
+std::shared_ptr<Model::TrackEntry> TrackBundle::OpenTrackEntryFile(
+	const OS::path_t &path)
+{
+	return ReadTrackEntry(*OpenParcelFile(path),
+		(const char*)Str::PU(path.filename()));
 }
 
 /**
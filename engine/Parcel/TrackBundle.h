@@ -73,6 +73,8 @@ public:
 		std::shared_ptr<const Model::TrackEntry> entry) const;
 	std::shared_ptr<Model::TrackEntry> OpenTrackEntry(
 		const std::string &name) const;
+	static std::shared_ptr<Model::TrackEntry> OpenTrackEntryFile(
+		const Util::OS::path_t &path);
 
 	MR_TrackAvail CheckAvail(const std::string &name) const;
 };
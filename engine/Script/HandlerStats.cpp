@@ -0,0 +1,169 @@
+
+// HandlerStats.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "Lua.h"
+
+#include "HandlerStats.h"
+
+using boost::format;
+
+namespace HoverRace {
+namespace Script {
+
+namespace {
+
+// Map nodes are never moved, so the keys can be used as trace zone names.
+std::map<std::string, HandlerStats::Entry> entries;
+MR_UInt64 frames = 0;
+
+}  // namespace
+
+bool HandlerStats::enabled = false;
+
+/**
+ * Constructor.
+ * @param L The Lua state the handler will run in.
+ * @param label The label for the handler.
+ */
+HandlerStats::Sampler::Sampler(lua_State *L, const std::string &label) :
+	L(L), label(nullptr), entry(nullptr), start(0), mem(0)
+{
+	if (IsActive()) {
+		auto iter = entries.emplace(label, Entry()).first;
+		this->label = &iter->first;
+		entry = &iter->second;
+		mem = GetLuaMemory(L);
+		start = Util::Tracer::Now();
+	}
+}
+
+HandlerStats::Sampler::~Sampler()
+{
+	if (!entry) return;
+
+	MR_UInt64 dur = Util::Tracer::Now() - start;
+
+	if (enabled) {
+		entry->calls++;
+		entry->total += dur;
+		entry->max = std::max(entry->max, dur);
+		entry->memDelta += GetLuaMemory(L) - mem;
+	}
+	if (Util::Tracer::IsEnabled()) {
+		Util::Tracer::Record(label->c_str(), start, dur);
+	}
+}
+
+/**
+ * Enable or disable collecting stats.
+ * Enabling does not reset previously-collected stats.
+ * @param enabled @c true to enable, @c false to disable.
+ */
+void HandlerStats::SetEnabled(bool enabled)
+{
+	HandlerStats::enabled = enabled;
+}
+
+/**
+ * Mark the end of a frame, so the per-frame times can be calculated.
+ */
+void HandlerStats::CountFrame()
+{
+	if (enabled) {
+		frames++;
+	}
+}
+
+/**
+ * Clear all collected stats.
+ */
+void HandlerStats::Reset()
+{
+	for (auto &ent : entries) {
+		ent.second = Entry();
+	}
+	frames = 0;
+}
+
+/**
+ * Retrieve the current size of the Lua heap.
+ * @param L The Lua state.
+ * @return The size, in bytes.
+ */
+MR_Int64 HandlerStats::GetLuaMemory(lua_State *L)
+{
+	return static_cast<MR_Int64>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 +
+		lua_gc(L, LUA_GCCOUNTB, 0);
+}
+
+/**
+ * Write the collected stats as a table, most expensive handlers first.
+ * @param os The output stream.
+ * @param L The Lua state (for the heap size).
+ * @return The output stream.
+ */
+std::ostream &HandlerStats::Output(std::ostream &os, lua_State *L)
+{
+	os << format("Lua heap: %0.1f KB, %d frame(s) sampled%s\n") %
+		(static_cast<double>(GetLuaMemory(L)) / 1024.0) % frames %
+		(enabled ? "" : " (stopped)");
+
+	using ent_t = const decltype(entries)::value_type*;
+	std::vector<ent_t> sorted;
+	for (auto &ent : entries) {
+		if (ent.second.calls > 0) {
+			sorted.push_back(&ent);
+		}
+	}
+	std::sort(sorted.begin(), sorted.end(), [](ent_t a, ent_t b) {
+		return a->second.total > b->second.total;
+	});
+
+	if (sorted.empty()) {
+		return os << "No handler calls recorded.\n";
+	}
+
+	os << format("%-32s %8s %10s %10s %10s %10s\n") %
+		"handler" % "calls" % "ms/frame" % "ms/call" % "max ms" % "KB/call";
+	for (auto ent : sorted) {
+		const Entry &e = ent->second;
+		double total = static_cast<double>(e.total) / 1000000.0;
+		double calls = static_cast<double>(e.calls);
+		os << format("%-32s %8d %10.3f %10.3f %10.3f %10.2f\n") %
+			ent->first % e.calls %
+			(frames > 0 ? total / static_cast<double>(frames) : 0.0) %
+			(total / calls) %
+			(static_cast<double>(e.max) / 1000000.0) %
+			(static_cast<double>(e.memDelta) / 1024.0 / calls);
+	}
+
+	return os;
+}
+
+}  // namespace Script
+}  // namespace HoverRace
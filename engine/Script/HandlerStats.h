@@ -0,0 +1,116 @@
+
+// HandlerStats.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+
+#include "../Util/MR_Types.h"
+#include "../Util/Tracer.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+struct lua_State;
+
+namespace HoverRace {
+namespace Script {
+
+/**
+ * Collects timing and memory usage of script event handlers.
+ *
+ * Each handler is identified by a label built from the name of its handler
+ * set and the name it was registered with (e.g. @c "game.on_init:my_mod").
+ * When tracing is enabled, each call is also recorded as a trace zone.
+ *
+ * Handlers only run on the main thread, like the Lua state itself (session
+ * events are fired there even when the simulation is pipelined), so the
+ * collected stats are not locked.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare HandlerStats
+{
+public:
+	HandlerStats() = delete;
+
+public:
+	struct Entry
+	{
+		Entry() : calls(0), total(0), max(0), memDelta(0) { }
+
+		MR_UInt64 calls;
+		MR_UInt64 total;  ///< Total time, in nanoseconds.
+		MR_UInt64 max;  ///< Longest single call, in nanoseconds.
+		MR_Int64 memDelta;  ///< Net change in the Lua heap, in bytes.
+	};
+
+	/**
+	 * Measures a single handler call for the lifetime of the object.
+	 */
+	class MR_DllDeclare Sampler
+	{
+	public:
+		Sampler(lua_State *L, const std::string &label);
+		~Sampler();
+
+		Sampler(const Sampler&) = delete;
+		Sampler &operator=(const Sampler&) = delete;
+
+	private:
+		lua_State *L;
+		const std::string *label;
+		Entry *entry;
+		MR_UInt64 start;
+		MR_Int64 mem;
+	};
+
+public:
+	/**
+	 * Check if handler calls are currently being measured.
+	 * @return @c true if either stats or tracing are enabled.
+	 */
+	static bool IsActive() { return enabled || Util::Tracer::IsEnabled(); }
+	static bool IsEnabled() { return enabled; }
+	static void SetEnabled(bool enabled);
+
+	static void CountFrame();
+	static void Reset();
+
+	static MR_Int64 GetLuaMemory(lua_State *L);
+
+	static std::ostream &Output(std::ostream &os, lua_State *L);
+
+private:
+	static bool enabled;
+};
+
+}  // namespace Script
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
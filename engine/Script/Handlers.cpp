@@ -23,6 +23,7 @@
 #include <luabind/object.hpp>
 
 #include "Core.h"
+#include "HandlerStats.h"
 
 #include "Handlers.h"
 
@@ -32,9 +33,10 @@ namespace Script {
 /**
  * Constructor.
  * @param scripting The scripting core.
+ * @param name Optional name for the set of handlers (used for profiling).
  */
-Handlers::Handlers(Core &scripting) :
-	scripting(&scripting), seq(1), ref(scripting)
+Handlers::Handlers(Core &scripting, const std::string &name) :
+	scripting(&scripting), name(name), seq(1), ref(scripting)
 {
 	lua_State *L = scripting.GetState();
 	lua_newtable(L);
@@ -55,11 +57,21 @@ void Handlers::Call(int numParams) const
 
 	int functionsToCall = 0;
 
+	// Labels are only needed when profiling.
+	std::vector<std::string> labels;
+	bool profiling = HandlerStats::IsActive();
+
 	// First, gather the list of handler functions to call.
 	// We do this so that the handlers can add/remove handlers.
 	lua_pushnil(L);  // (params...) table nil
 	while (lua_next(L, -2) != 0) {
 		// (params...) (fns...) table key fn
+		if (profiling) {
+			std::string key = lua_type(L, -2) == LUA_TSTRING ?
+				lua_tostring(L, -2) :
+				("#" + std::to_string(lua_tointeger(L, -2)));
+			labels.emplace_back(name.empty() ? key : (name + ":" + key));
+		}
 		lua_insert(L, -3);  // (params...) (fns...fn) table key
 		++functionsToCall;
 	}
@@ -67,13 +79,22 @@ void Handlers::Call(int numParams) const
 	lua_pop(L, 1);  // (params...) (fns...)
 
 	// Call the handlers, one by one.
+	// The handlers are called from the top of the stack, so the last one
+	// gathered is the first one called.
 	for (int i = 0; i < functionsToCall; ++i) {
 		try {
 			for (int j = 0; j < numParams; ++j) {
 				lua_pushvalue(L, paramsStart + j);
 			}
 			// (params...) (fns...) (params...)
-			scripting->Invoke(numParams);
+			if (profiling) {
+				HandlerStats::Sampler sampler(L,
+					labels[functionsToCall - i - 1]);
+				scripting->Invoke(numParams);
+			}
+			else {
+				scripting->Invoke(numParams);
+			}
 		}
 		catch (Script::ScriptExn &ex) {
 			scripting->Print(ex.what());
@@ -47,7 +47,7 @@ class Core;
 class MR_DllDeclare Handlers
 {
 public:
-	Handlers(Core &scripting);
+	Handlers(Core &scripting, const std::string &name = "");
 	Handlers(const Handlers&) = default;
 	Handlers(Handlers&&) = default;
 	virtual ~Handlers() { }
@@ -55,6 +55,8 @@ public:
 	Handlers &operator=(const Handlers&) = default;
 	Handlers &operator=(Handlers&&) = default;
 
+	const std::string &GetName() const { return name; }
+
 protected:
 	void Call(int numParams) const;
 public:
@@ -68,6 +70,7 @@ public:
 
 private:
 	Core *scripting;
+	std::string name;
 	int seq;
 	RegistryRef ref;
 };
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../Util/Log.h"
+#include "HandlerStats.h"
 
 namespace HoverRace {
 namespace Script {
@@ -52,10 +53,18 @@ class Wrapper : public luabind::wrap_base
 
 		//TODO: Support other returns than void.
 		template<class Ret, class... Params>
-		void pcall(Params&&... params)
+		void pcall(const char *name, Params&&... params)
 		{
 			try {
-				call<void>(std::forward<Params>(params)...);
+				if (HandlerStats::IsActive()) {
+					HandlerStats::Sampler sampler(
+						luabind::detail::wrap_access::ref(*this).state(),
+						std::string("meta:") + name);
+					call<void>(name, std::forward<Params>(params)...);
+				}
+				else {
+					call<void>(name, std::forward<Params>(params)...);
+				}
 			}
 			catch (luabind::error &ex) {
 				HandleError(ex);
@@ -0,0 +1,259 @@
+
+// AllocTracker.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <cstdlib>
+#include <new>
+
+#include "Profiler.h"
+
+#include "AllocTracker.h"
+
+namespace HoverRace {
+namespace Util {
+
+namespace {
+
+// Nothing here may allocate from the heap, since it is called from
+// operator new.
+
+/**
+ * Counters for a thread.
+ *
+ * When a thread exits, its slot is handed to the next new thread.  The
+ * counters carry on from where they were, so the totals never go backwards;
+ * only the difference between two reads is meaningful for a single thread.
+ */
+struct ThreadStats
+{
+	std::atomic<MR_UInt64> count;
+	std::atomic<MR_UInt64> bytes;
+	std::atomic<bool> inUse;
+};
+
+/// Threads beyond this (at the same time) share the last slot.
+const size_t MAX_THREADS = 64;
+const size_t SHARED_SLOT = MAX_THREADS - 1;
+
+ThreadStats threadSlots[MAX_THREADS];
+std::atomic<size_t> numThreads{0};  ///< Number of slots ever handed out.
+
+thread_local ThreadStats *threadStats = nullptr;
+thread_local Profiler *threadTag = nullptr;
+
+/// Gives the thread's slot back when the thread exits.
+struct SlotRelease
+{
+	~SlotRelease()
+	{
+		// Anything the thread allocates from here on goes to the shared slot.
+		threadStats = &threadSlots[SHARED_SLOT];
+		if (slot) {
+			slot->inUse.store(false, std::memory_order_release);
+		}
+	}
+
+	ThreadStats *slot;
+};
+
+thread_local SlotRelease slotRelease;
+
+ThreadStats *ClaimSlot()
+{
+	for (;;) {
+		// Prefer a slot given back by a thread that has exited.
+		size_t n = std::min(numThreads.load(std::memory_order_acquire),
+			SHARED_SLOT);
+		for (size_t i = 0; i < n; i++) {
+			bool expected = false;
+			if (threadSlots[i].inUse.compare_exchange_strong(expected, true,
+				std::memory_order_acquire))
+			{
+				return &threadSlots[i];
+			}
+		}
+
+		size_t idx = numThreads.fetch_add(1, std::memory_order_acq_rel);
+		if (idx >= SHARED_SLOT) {
+			return &threadSlots[SHARED_SLOT];
+		}
+
+		// Another thread may have found the new slot while scanning.
+		bool expected = false;
+		if (threadSlots[idx].inUse.compare_exchange_strong(expected, true,
+			std::memory_order_acquire))
+		{
+			return &threadSlots[idx];
+		}
+	}
+}
+
+ThreadStats &GetThreadSlot()
+{
+	if (!threadStats) {
+		threadStats = ClaimSlot();
+		if (threadStats != &threadSlots[SHARED_SLOT]) {
+			slotRelease.slot = threadStats;
+		}
+	}
+	return *threadStats;
+}
+
+void Inc(std::atomic<MR_UInt64> &counter, MR_UInt64 amt)
+{
+	counter.fetch_add(amt, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+std::atomic<bool> AllocTracker::enabled{false};
+
+/**
+ * Check if the allocation hook was compiled in.
+ * @return @c true if allocations can be counted, @c false if enabling
+ *         the tracker will have no effect.
+ */
+bool AllocTracker::IsAvailable()
+{
+#	ifdef HR_ALLOC_TRACKING
+		return true;
+#	else
+		return false;
+#	endif
+}
+
+/**
+ * Start or stop counting allocations.
+ * @param enabled @c true to start, @c false to stop.
+ */
+void AllocTracker::SetEnabled(bool enabled)
+{
+	AllocTracker::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+Profiler *AllocTracker::SetThreadTag(Profiler *tag)
+{
+	Profiler *retv = threadTag;
+	threadTag = tag;
+	return retv;
+}
+
+/**
+ * Count an allocation made by the current thread.
+ * @param size The size of the allocation, in bytes.
+ */
+void AllocTracker::OnAlloc(size_t size)
+{
+	if (!IsEnabled()) return;
+
+	auto &slot = GetThreadSlot();
+	Inc(slot.count, 1);
+	Inc(slot.bytes, size);
+
+	if (threadTag) {
+		threadTag->CountAlloc(size);
+	}
+}
+
+/**
+ * Retrieve the number of allocations made by the current thread.
+ *
+ * The slot may have been used by a thread that has since exited, so
+ * compare two reads instead of using the counters directly.
+ * @return The counters.
+ */
+AllocTracker::Stats AllocTracker::GetThreadStats()
+{
+	Stats retv;
+	auto &slot = GetThreadSlot();
+	retv.count = slot.count.load(std::memory_order_relaxed);
+	retv.bytes = slot.bytes.load(std::memory_order_relaxed);
+	return retv;
+}
+
+/**
+ * Retrieve the number of allocations made by all threads.
+ * @return The counters.
+ */
+AllocTracker::Stats AllocTracker::GetTotalStats()
+{
+	Stats retv;
+	size_t n = std::min(numThreads.load(std::memory_order_relaxed),
+		MAX_THREADS);
+	for (size_t i = 0; i < n; i++) {
+		retv.count += threadSlots[i].count.load(std::memory_order_relaxed);
+		retv.bytes += threadSlots[i].bytes.load(std::memory_order_relaxed);
+	}
+	return retv;
+}
+
+}  // namespace Util
+}  // namespace HoverRace
+
+#ifdef HR_ALLOC_TRACKING
+
+// Replacements for the global allocation functions.
+// The standard library's sized forms of delete forward to these.
+
+void *operator new(std::size_t size)
+{
+	HoverRace::Util::AllocTracker::OnAlloc(size);
+	void *retv = std::malloc(size == 0 ? 1 : size);
+	if (!retv) throw std::bad_alloc();
+	return retv;
+}
+
+void *operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	HoverRace::Util::AllocTracker::OnAlloc(size);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &nt) noexcept
+{
+	return operator new(size, nt);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept
+{
+	std::free(ptr);
+}
+
+#endif  // HR_ALLOC_TRACKING
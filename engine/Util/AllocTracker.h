@@ -0,0 +1,133 @@
+
+// AllocTracker.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+
+#include "MR_Types.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+	namespace Util {
+		class Profiler;
+	}
+}
+
+namespace HoverRace {
+namespace Util {
+
+/**
+ * Counts heap allocations per thread and per profiler.
+ *
+ * The counting is done by replacing the global operator new, which is only
+ * compiled in when the build is configured with @c HR_ALLOC_TRACKING.
+ * Even then, allocations are only counted while tracking is enabled.
+ *
+ * Allocations made while a Profiler::Sampler is active are attributed to
+ * the innermost profiler on that thread (see Scope).
+ * @author Michael Imamura
+ */
+class MR_DllDeclare AllocTracker
+{
+public:
+	AllocTracker() = delete;
+
+public:
+	/**
+	 * Attribute the allocations made by the current thread to a profiler
+	 * for the lifetime of the scope object.
+	 */
+	class Scope
+	{
+	public:
+		Scope() = delete;
+		Scope(Profiler &profiler) : prevTag(SetTag(&profiler)) { }
+		~Scope() { SetTag(prevTag); }
+
+		Scope(const Scope&) = delete;
+		Scope &operator=(const Scope&) = delete;
+
+	private:
+		Profiler *prevTag;
+	};
+
+	/// Allocation counters.
+	struct Stats
+	{
+		Stats() : count(0), bytes(0) { }
+
+		MR_UInt64 count;
+		MR_UInt64 bytes;
+	};
+
+public:
+	static bool IsAvailable();
+
+	/**
+	 * Check if allocations are currently being counted.
+	 * @return @c true if enabled, @c false if not.
+	 */
+	static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+	static void SetEnabled(bool enabled);
+
+	/**
+	 * Set the profiler that the current thread's allocations are attributed
+	 * to.  This is a no-op unless the build is configured with
+	 * @c HR_ALLOC_TRACKING, so samplers don't pay for it otherwise.
+	 * @param tag The profiler (may be @c nullptr).
+	 * @return The previous profiler.
+	 */
+	static Profiler *SetTag(Profiler *tag)
+	{
+#		ifdef HR_ALLOC_TRACKING
+			return SetThreadTag(tag);
+#		else
+			(void)tag;
+			return nullptr;
+#		endif
+	}
+
+	static void OnAlloc(size_t size);
+
+	static Stats GetThreadStats();
+	static Stats GetTotalStats();
+
+private:
+	static Profiler *SetThreadTag(Profiler *tag);
+
+private:
+	static std::atomic<bool> enabled;
+};
+
+}  // namespace Util
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
@@ -73,6 +73,7 @@ using HoverRace::Control::InputEventController;
 #endif
 #define CONFIG_FILENAME			"config.yml"
 #define PREREL_CONFIG_FILENAME	"config-testing.yml"
+#define TRACK_INDEX_FILENAME	"TrackIndex.dat"
 
 #define DEFAULT_MAIN_SERVER		"www.hoverrace.com/imr/rl.php"
 #define DEFAULT_UPDATE_SERVER	"www.hoverrace.com/updates/updates.php"
@@ -462,6 +463,16 @@ OS::path_t Config::GetConfigFilename() const
 	return retv;
 }
 
+/**
+ * Retrieve the path to the cache of track headers.
+ * @return The path (may not exist yet).
+ * @see Model::TrackIndex
+ */
+OS::path_t Config::GetTrackIndexFilename() const
+{
+	return dataPath / Str::UP(TRACK_INDEX_FILENAME);
+}
+
 /**
  * Retrieve the OS-specific default media path.
  * First, we look for a config file in the current directory, then in the
@@ -675,6 +686,20 @@ OS::path_t Config::GetDefaultScreenshotPath()
 	return retv;
 }
 
+/**
+ * Retrieve the default path for session telemetry logs.
+ * @return The fully-qualified path (may be empty if base path could not
+ *         be retrieved from the system).
+ */
+OS::path_t Config::GetDefaultTelemetryPath()
+{
+	OS::path_t retv = FindPersonalDir();
+	if (!retv.empty()) {
+		retv /= L"HoverRace Telemetry";
+	}
+	return retv;
+}
+
 /**
  * Retrieve the default UI font name.
  * @return The font name (never empty).
@@ -784,6 +809,50 @@ void Config::ResetToDefaults()
 	runtime.enableHud = true;
 	runtime.skipStartupWarning = false;
 	runtime.profiling = false;
+	runtime.pipelineSim = false;
+	runtime.tracing = false;
+	runtime.allocTracking = false;
+	runtime.handlerProfiling = false;
+	for (const auto &flag : GetRuntimeFlags()) {
+		runtime.*flag.field = flag.defaultValue;
+	}
+}
+
+/**
+ * Retrieve the experimental code paths that can be toggled at runtime.
+ * @return The flags, sorted by name.
+ */
+const std::vector<Config::RuntimeFlag> &Config::GetRuntimeFlags()
+{
+	static const std::vector<RuntimeFlag> flags{
+		{ "actor_batching", &runtime_t::actorBatching, false },
+		{ "background_cache", &runtime_t::backgroundCache, false },
+		{ "element_culling", &runtime_t::elementCulling, false },
+		{ "lazy_resources", &runtime_t::lazyResources, true },
+		{ "mapped_parcels", &runtime_t::mappedParcels, true },
+		{ "overdraw_view", &runtime_t::showOverdraw, false },
+		{ "portal_culling", &runtime_t::portalCulling, false },
+		{ "tiled_textures", &runtime_t::tiledTextures, false },
+		{ "track_index", &runtime_t::trackIndex, true },
+		{ "wall_coverage", &runtime_t::wallCoverage, false },
+		{ "z_generations", &runtime_t::zGenerations, true },
+	};
+	return flags;
+}
+
+/**
+ * Look up a runtime flag by name.
+ * @param name The name of the flag (see GetRuntimeFlags()).
+ * @return The flag's current value, or @c nullptr if there is no such flag.
+ */
+bool *Config::FindRuntimeFlag(const std::string &name)
+{
+	for (const auto &flag : GetRuntimeFlags()) {
+		if (name == flag.name) {
+			return &(runtime.*flag.field);
+		}
+	}
+	return nullptr;
 }
 
 void Config::LoadSystem()
@@ -982,6 +1051,17 @@ void Config::video_t::ResetToDefaults()
 	fullscreenRefreshRate = 0;
 
 	stackedSplitscreen = true;
+
+	dynamicRes = false;
+	dynamicResMinScale = 0.5;
+	dynamicResMaxScale = 1.0;
+	dynamicResTargetFps = 60;
+
+	motionInterpolation = false;
+	simulationSlice = 15;
+
+	textureCacheSize = 64;
+	glyphCacheTextures = 48;
 }
 
 void Config::video_t::Load(yaml::MapNode *root)
@@ -1005,6 +1085,17 @@ void Config::video_t::Load(yaml::MapNode *root)
 	READ_INT(root, fullscreenRefreshRate, 0, 32768);
 
 	READ_BOOL(root, stackedSplitscreen);
+
+	READ_BOOL(root, dynamicRes);
+	READ_DOUBLE(root, dynamicResMinScale, 0.25, 1.0);
+	READ_DOUBLE(root, dynamicResMaxScale, 0.25, 1.0);
+	READ_INT(root, dynamicResTargetFps, 10, 1000);
+
+	READ_BOOL(root, motionInterpolation);
+	READ_INT(root, simulationSlice, 10, 50);
+
+	READ_INT(root, textureCacheSize, 0, 4096);
+	READ_INT(root, glyphCacheTextures, 0, 1024);
 }
 
 void Config::video_t::Save(yaml::Emitter &emitter) const
@@ -1030,6 +1121,17 @@ void Config::video_t::Save(yaml::Emitter &emitter) const
 
 	EMIT_VAR(emitter, stackedSplitscreen);
 
+	EMIT_VAR(emitter, dynamicRes);
+	EMIT_VAR(emitter, dynamicResMinScale);
+	EMIT_VAR(emitter, dynamicResMaxScale);
+	EMIT_VAR(emitter, dynamicResTargetFps);
+
+	EMIT_VAR(emitter, motionInterpolation);
+	EMIT_VAR(emitter, simulationSlice);
+
+	EMIT_VAR(emitter, textureCacheSize);
+	EMIT_VAR(emitter, glyphCacheTextures);
+
 	emitter.EndMap();
 }
 
@@ -1086,6 +1188,8 @@ void Config::i18n_t::Save(yaml::Emitter &emitter) const
 void Config::misc_t::ResetToDefaults()
 {
 	screenshotPath = GetDefaultScreenshotPath();
+	sessionTelemetry = false;
+	telemetryPath = GetDefaultTelemetryPath();
 }
 
 void Config::misc_t::Load(yaml::MapNode *root)
@@ -1093,6 +1197,8 @@ void Config::misc_t::Load(yaml::MapNode *root)
 	if (root == NULL) return;
 
 	READ_PATH(root, screenshotPath);
+	READ_BOOL(root, sessionTelemetry);
+	READ_PATH(root, telemetryPath);
 }
 
 void Config::misc_t::Save(yaml::Emitter &emitter) const
@@ -1101,6 +1207,8 @@ void Config::misc_t::Save(yaml::Emitter &emitter) const
 	emitter.StartMap();
 
 	EMIT_VAR(emitter, screenshotPath);
+	EMIT_VAR(emitter, sessionTelemetry);
+	EMIT_VAR(emitter, telemetryPath);
 
 	emitter.EndMap();
 }
@@ -110,6 +110,7 @@ public:
 	OS::path_t GetBaseDataPath() const;
 	OS::path_t GetBaseConfigPath() const;
 	OS::path_t GetConfigFilename() const;
+	OS::path_t GetTrackIndexFilename() const;
 
 	OS::path_t GetDefaultMediaPath();
 	const OS::path_t &GetMediaPath() const;
@@ -142,6 +143,7 @@ public:
 	static std::string GetDefaultUpdateServerUrl();
 	static OS::path_t GetDefaultChatLogPath();
 	static OS::path_t GetDefaultScreenshotPath();
+	static OS::path_t GetDefaultTelemetryPath();
 
 	const std::string &GetDefaultFontName() const;
 	const std::string &GetDefaultMonospaceFontName() const;
@@ -223,6 +225,17 @@ public:
 
 		bool stackedSplitscreen;
 
+		bool dynamicRes;  ///< Scale the 3D view resolution to keep the frame rate.
+		double dynamicResMinScale;
+		double dynamicResMaxScale;
+		int dynamicResTargetFps;
+
+		bool motionInterpolation;  ///< Simulate in fixed slices and interpolate the rendering.
+		int simulationSlice;  ///< Slice length in ms when interpolating.
+
+		int textureCacheSize;  ///< Budget in MB for unused cached UI textures.
+		int glyphCacheTextures;  ///< Budget in textures for unused cached fonts.
+
 		void ResetToDefaults();
 		void Load(yaml::MapNode*);
 		void Save(yaml::Emitter&) const;
@@ -249,6 +262,8 @@ public:
 	struct misc_t
 	{
 		OS::path_t screenshotPath;
+		bool sessionTelemetry;  ///< Record performance stats for each session.
+		OS::path_t telemetryPath;
 
 		void ResetToDefaults();
 		void Load(yaml::MapNode*);
@@ -350,8 +365,38 @@ public:
 		bool noAccel;  ///< Disable accelerated (OpenGL) rendering.
 		bool skipStartupWarning;
 		bool profiling;
+		bool pipelineSim;  ///< Simulate the next tick while the frame is presented.
+		bool portalCulling;  ///< Cull rooms hidden behind portals.
+		bool wallCoverage;  ///< Skip wall columns hidden by nearer walls.
+		bool showOverdraw;  ///< Replace the 3D view with the wall overdraw.
+		bool zGenerations;  ///< Clear the Z buffer by starting a new generation.
+		bool tiledTextures;  ///< Sample walls and floors from tiled bitmaps.
+		bool elementCulling;  ///< Skip free elements outside the view frustum.
+		bool actorBatching;  ///< Transform actor meshes once per frame and cull their patches.
+		bool backgroundCache;  ///< Draw the background from a cached row-major panorama.
+		bool tracing;  ///< Record trace zones for debug::dump_trace().
+		bool allocTracking;  ///< Count heap allocations (requires HR_ALLOC_TRACKING).
+		bool handlerProfiling;  ///< Collect stats for debug::handler_stats().
+		bool mappedParcels;  ///< Read parcels through a memory mapping.
+		bool lazyResources;  ///< Load ObjFac1.dat resources on first use.
+		bool trackIndex;  ///< Cache track headers between track list reloads.
 		std::vector<OS::path_t> initScripts;
 	} runtime;
+
+public:
+	/**
+	 * An experimental code path that can be switched on and off at runtime.
+	 * These are listed in a single table so that the defaults and the
+	 * debug:toggle() script method stay in sync.
+	 */
+	struct RuntimeFlag
+	{
+		const char *name;  ///< Name used by debug:toggle().
+		bool runtime_t::*field;
+		bool defaultValue;
+	};
+	static const std::vector<RuntimeFlag> &GetRuntimeFlags();
+	bool *FindRuntimeFlag(const std::string &name);
 };
 
 }  // namespace Util
@@ -30,7 +30,10 @@
 
 #ifdef _WIN32
 #	include <lmcons.h>
+#	include <psapi.h>
 #	include <shellapi.h>
+#elif defined(__linux__)
+#	include <unistd.h>
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -443,5 +446,35 @@ std::string OS::GetUsername()
 	return retv;
 }
 
+/**
+ * Get the amount of physical memory currently used by this process.
+ * @return The resident size, in bytes, or @c 0 if it could not be retrieved
+ *         on this platform.
+ */
+size_t OS::GetProcessMemory()
+{
+#	ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+			sizeof(counters)))
+		{
+			return counters.WorkingSetSize;
+		}
+		return 0;
+#	elif defined(__linux__)
+		// The second field is the resident set size, in pages.
+		FILE *statm = fopen("/proc/self/statm", "r");
+		if (!statm) return 0;
+		unsigned long size = 0, resident = 0;
+		int ct = fscanf(statm, "%lu %lu", &size, &resident);
+		fclose(statm);
+		if (ct != 2) return 0;
+		return static_cast<size_t>(resident) *
+			static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#	else
+		return 0;
+#	endif
+}
+
 }  // namespace Util
 }  // namespace HoverRace
@@ -101,6 +101,8 @@ OS::path_t FindExePath();
 
 std::string GetUsername();
 
+size_t GetProcessMemory();
+
 }  // namespace OS
 
 }  // namespace Util
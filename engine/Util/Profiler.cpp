@@ -25,7 +25,8 @@ namespace HoverRace {
 namespace Util {
 
 Profiler::Profiler(const std::string &name) :
-	dur(dur_t::zero()), name(name), sampling(0)
+	dur(dur_t::zero()), total(dur_t::zero()), samples(0),
+	lapSamples(0), name(name), sampling(0)
 {
 }
 
@@ -52,6 +53,16 @@ void Profiler::Reset()
 const Profiler::LapTime &Profiler::Lap(const Profiler *parent)
 {
 	lap.time = dur;
+	lap.samples = samples - lapSamples;
+	lapSamples = samples;
+
+	// Allocations are only attributed to the innermost profiler, so the
+	// allocations of the subsets are added below.
+	AllocTracker::Stats ownAllocs;
+	ownAllocs.count = allocs.count - lapAllocs.count;
+	ownAllocs.bytes = allocs.bytes - lapAllocs.bytes;
+	lapAllocs = allocs;
+	lap.allocs = ownAllocs;
 	if (parent) {
 		auto parentDur = parent->GetDuration().count();
 		if (parentDur == 0) {
@@ -69,10 +80,14 @@ const Profiler::LapTime &Profiler::Lap(const Profiler *parent)
 
 	otherTime.time = dur;
 	otherTime.pctParent = 100.0;
+	otherTime.samples = lap.samples;
+	otherTime.allocs = ownAllocs;
 	for (auto &ent : subs) {
 		auto &subLap = ent->Lap(this);
 		otherTime.time -= subLap.time;
 		otherTime.pctParent -= subLap.pctParent;
+		lap.allocs.count += subLap.allocs.count;
+		lap.allocs.bytes += subLap.allocs.bytes;
 	}
 
 	dur = dur_t::zero();
@@ -91,5 +106,18 @@ std::shared_ptr<Profiler> Profiler::AddSub(const std::string &name)
 	return subs.back();
 }
 
+/**
+ * Find an immediate subset by name.
+ * @param name The name of the subset.
+ * @return The subset, or @c nullptr if there is no subset with that name.
+ */
+std::shared_ptr<Profiler> Profiler::FindSub(const std::string &name) const
+{
+	for (const auto &ent : subs) {
+		if (ent->GetName() == name) return ent;
+	}
+	return std::shared_ptr<Profiler>();
+}
+
 }  // namespace Util
 }  // namespace HoverRace
@@ -23,6 +23,9 @@
 
 #include <chrono>
 
+#include "MR_Types.h"
+#include "AllocTracker.h"
+
 #if defined(_WIN32) && defined(HR_ENGINE_SHARED)
 #	ifdef MR_ENGINE
 #		define MR_DllDeclare   __declspec( dllexport )
@@ -56,7 +59,7 @@ public:
 		Sampler() = delete;
 
 		Sampler(Profiler &profiler) :
-			profiler(profiler)
+			profiler(profiler), prevTag(AllocTracker::SetTag(&profiler))
 		{
 			if ((++(profiler.sampling)) == 1) {
 				profiler.sampleStart = clock_t::now();
@@ -66,8 +69,9 @@ public:
 		~Sampler()
 		{
 			if ((--(profiler.sampling)) == 0) {
-				profiler.dur += (clock_t::now() - profiler.sampleStart);
+				profiler.AddSample(clock_t::now() - profiler.sampleStart);
 			}
+			AllocTracker::SetTag(prevTag);
 		}
 
 		Sampler(const Sampler&) = delete;
@@ -78,21 +82,67 @@ public:
 
 	private:
 		Profiler &profiler;
+		Profiler *prevTag;
 	};
 
 	struct LapTime
 	{
 		LapTime() :
 			time(dur_t::zero()),
-			pctParent(std::numeric_limits<double>::quiet_NaN()) { }
+			pctParent(std::numeric_limits<double>::quiet_NaN()),
+			samples(0) { }
 
 		dur_t time;
 		double pctParent;
+		MR_UInt64 samples;  ///< Number of samples in the lap.
+		AllocTracker::Stats allocs;  ///< Allocations in the lap (including subsets).
 	};
 
 public:
 	const std::string &GetName() const { return name; }
 	dur_t GetDuration() const { return dur; }
+
+	/**
+	 * Retrieve the total time sampled since the profiler was created.
+	 * Unlike GetDuration(), this is never reset by Lap() or Reset(), so
+	 * the difference between two calls is the time sampled in between.
+	 * @return The total time.
+	 */
+	dur_t GetTotalDuration() const { return total; }
+
+	/**
+	 * Retrieve the number of samples taken since the profiler was created.
+	 * @return The number of samples.
+	 */
+	MR_UInt64 GetSampleCount() const { return samples; }
+
+	/**
+	 * Retrieve the allocations attributed to this profiler since it was
+	 * created (not including the subsets).
+	 * @return The allocation counters (always zero unless the
+	 *         AllocTracker is enabled).
+	 */
+	const AllocTracker::Stats &GetAllocStats() const { return allocs; }
+
+	/**
+	 * Count an allocation made while this profiler was being sampled.
+	 * @param size The size of the allocation, in bytes.
+	 */
+	void CountAlloc(size_t size)
+	{
+		allocs.count++;
+		allocs.bytes += size;
+	}
+
+	/**
+	 * Add allocations that were counted separately (e.g. on another thread).
+	 * @param stats The allocations to add.
+	 */
+	void AddAllocs(const AllocTracker::Stats &stats)
+	{
+		allocs.count += stats.count;
+		allocs.bytes += stats.bytes;
+	}
 	const LapTime &GetLastLap() const { return lap; }
 
 	/**
@@ -103,13 +153,30 @@ public:
 
 	void Reset();
 
+	/**
+	 * Add time that was measured separately (e.g. on another thread).
+	 * @param sample The time to add.
+	 */
+	void AddSample(dur_t sample)
+	{
+		dur += sample;
+		total += sample;
+		samples++;
+	}
+
 	const LapTime &Lap(const Profiler *parent = nullptr);
 
 public:
 	std::shared_ptr<Profiler> AddSub(const std::string &name);
+	std::shared_ptr<Profiler> FindSub(const std::string &name) const;
 
 private:
 	dur_t dur;
+	dur_t total;
+	MR_UInt64 samples;
+	AllocTracker::Stats allocs;
+	MR_UInt64 lapSamples;  ///< Sample count at the last lap.
+	AllocTracker::Stats lapAllocs;  ///< Allocations at the last lap.
 	std::string name;
 	std::vector<std::shared_ptr<Profiler>> subs;
 	int sampling;
@@ -130,6 +197,13 @@ MR_DllDeclare inline std::ostream &operator<<(std::ostream &os,
 {
 	static boost::format fmt("%0.2f%% (%d)");
 	os << fmt % lp.pctParent % lp.time.count();
+	if (AllocTracker::IsEnabled() && lp.samples > 0) {
+		static boost::format allocFmt("  allocs/sample: %0.1f (%0.1f KB)");
+		double samples = static_cast<double>(lp.samples);
+		os << allocFmt %
+			(static_cast<double>(lp.allocs.count) / samples) %
+			(static_cast<double>(lp.allocs.bytes) / samples / 1024.0);
+	}
 	return os;
 }
 
@@ -0,0 +1,297 @@
+
+// Tracer.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+
+#include "Tracer.h"
+
+namespace HoverRace {
+namespace Util {
+
+namespace {
+
+/// Number of events kept per thread (must be a power of two).
+const MR_UInt64 RING_SIZE = 1 << 16;
+
+/// Events recorded by a single thread.
+struct ThreadBuffer
+{
+	ThreadBuffer() :
+		tid(0), inUse(false), base(0), head(0),
+		events(static_cast<size_t>(RING_SIZE)) { }
+
+	// The owner fields are guarded by registryMutex.
+	unsigned int tid;  ///< Trace thread number of the owner.
+	std::string name;  ///< Name of the owner.
+	bool inUse;  ///< @c false once the owner has exited.
+	MR_UInt64 base;  ///< Index of the owner's first event.
+
+	std::atomic<MR_UInt64> head;  ///< Total number of events written.
+	std::vector<Tracer::Event> events;
+};
+
+const Tracer::clock_t::time_point epoch = Tracer::clock_t::now();
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+unsigned int nextTid = 1;  ///< Guarded by registryMutex.
+
+thread_local std::string threadName;
+thread_local ThreadBuffer *threadBuf = nullptr;
+thread_local bool threadExited = false;
+
+/// Gives the thread's buffer back when the thread exits.
+struct BufferRelease
+{
+	~BufferRelease()
+	{
+		// Events recorded from here on are dropped.
+		threadExited = true;
+		threadBuf = nullptr;
+		if (buf) {
+			std::lock_guard<std::mutex> lock(registryMutex);
+			buf->inUse = false;
+		}
+	}
+
+	std::shared_ptr<ThreadBuffer> buf;
+};
+
+thread_local BufferRelease bufferRelease;
+
+ThreadBuffer *GetThreadBuffer()
+{
+	// The buffer is only claimed when the thread records its first event,
+	// so threads don't pay for one while tracing is disabled.
+	// A buffer given back by an exited thread keeps its events until it is
+	// claimed by a new thread, so they can still be dumped.
+	if (!threadBuf && !threadExited) {
+		std::lock_guard<std::mutex> lock(registryMutex);
+
+		auto iter = std::find_if(registry.begin(), registry.end(),
+			[](const std::shared_ptr<ThreadBuffer> &buf) {
+				return !buf->inUse;
+			});
+		std::shared_ptr<ThreadBuffer> buf;
+		if (iter == registry.end()) {
+			buf = std::make_shared<ThreadBuffer>();
+			registry.push_back(buf);
+		}
+		else {
+			buf = *iter;
+		}
+
+		buf->tid = nextTid++;
+		buf->name = threadName;
+		buf->inUse = true;
+		buf->base = buf->head.load(std::memory_order_relaxed);
+
+		bufferRelease.buf = buf;
+		threadBuf = buf.get();
+	}
+	return threadBuf;
+}
+
+void OutputJsonString(std::ostream &os, const char *s)
+{
+	os << '"';
+	for (; *s; ++s) {
+		char c = *s;
+		if (c == '"' || c == '\\') os << '\\' << c;
+		else if (static_cast<unsigned char>(c) < 0x20) os << ' ';
+		else os << c;
+	}
+	os << '"';
+}
+
+}  // namespace
+
+std::atomic<bool> Tracer::enabled{false};
+
+/**
+ * Start or stop recording zones.
+ * Events already in the buffers are kept.
+ * @param enabled @c true to start, @c false to stop.
+ */
+void Tracer::SetEnabled(bool enabled)
+{
+	Tracer::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * Set the name of the calling thread, as shown in the dumped trace.
+ * This does not allocate the thread's buffer.
+ * @param name The thread name.
+ */
+void Tracer::SetThreadName(const std::string &name)
+{
+	threadName = name;
+	if (threadBuf) {
+		std::lock_guard<std::mutex> lock(registryMutex);
+		threadBuf->name = name;
+	}
+}
+
+/**
+ * Retrieve the current trace timestamp.
+ * @return The time, in nanoseconds since the epoch.
+ */
+MR_UInt64 Tracer::Now()
+{
+	return static_cast<MR_UInt64>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			clock_t::now() - epoch).count());
+}
+
+/**
+ * Add an event to the calling thread's buffer.
+ * The oldest event is overwritten if the buffer is full.
+ * Events recorded while the thread is exiting are dropped.
+ * @param name The zone name.
+ * @param start The start time (see Now()).
+ * @param dur The duration, in nanoseconds.
+ */
+void Tracer::Record(const char *name, MR_UInt64 start, MR_UInt64 dur)
+{
+	ThreadBuffer *buf = GetThreadBuffer();
+	if (!buf) return;
+
+	MR_UInt64 head = buf->head.load(std::memory_order_relaxed);
+	Event &evt = buf->events[static_cast<size_t>(head & (RING_SIZE - 1))];
+	evt.name = name;
+	evt.start = start;
+	evt.dur = dur;
+	buf->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Write the recent events from all threads as a Chrome trace.
+ *
+ * This may be called while other threads are recording; events which may
+ * have been overwritten while they were being copied are skipped.
+ *
+ * Each thread is identified by its trace thread number, not by the OS
+ * thread ID.  A buffer given back by an exited thread is only dumped up to
+ * the point where a new thread claimed it.
+ *
+ * @param os The output stream.
+ * @param seconds Only include events that ended within this many seconds.
+ * @return The number of events written.
+ */
+size_t Tracer::Dump(std::ostream &os, double seconds)
+{
+	// The owner of each buffer as of now; a new owner only writes past the
+	// head we see here.
+	struct Owner
+	{
+		unsigned int tid;
+		std::string name;
+		MR_UInt64 base;
+		MR_UInt64 head;
+	};
+	std::vector<std::shared_ptr<ThreadBuffer>> bufs;
+	std::vector<Owner> owners;
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		bufs = registry;
+		for (const auto &buf : bufs) {
+			owners.push_back(Owner{ buf->tid, buf->name, buf->base,
+				buf->head.load(std::memory_order_acquire) });
+		}
+	}
+
+	MR_UInt64 now = Now();
+	MR_UInt64 window = static_cast<MR_UInt64>(seconds * 1000000000.0);
+	MR_UInt64 cutoff = now > window ? now - window : 0;
+
+	size_t count = 0;
+	bool first = true;
+	auto sep = [&]() -> std::ostream& {
+		if (first) first = false;
+		else os << ",\n";
+		return os;
+	};
+
+	auto oldFlags = os.flags();
+	auto oldPrecision = os.precision();
+	os << std::fixed << std::setprecision(3);
+
+	os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	std::vector<Event> events;
+	for (size_t i = 0; i < bufs.size(); i++) {
+		auto &buf = *bufs[i];
+		const Owner &owner = owners[i];
+
+		std::string name = owner.name;
+		if (name.empty()) {
+			name = "thread " + boost::lexical_cast<std::string>(owner.tid);
+		}
+		sep() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+			"\"tid\":" << owner.tid << ",\"args\":{\"name\":";
+		OutputJsonString(os, name.c_str());
+		os << "}}";
+
+		MR_UInt64 head = owner.head;
+		MR_UInt64 tail = std::max(
+			head > RING_SIZE ? head - RING_SIZE : 0, owner.base);
+		events.clear();
+		for (MR_UInt64 idx = tail; idx < head; idx++) {
+			events.push_back(buf.events[static_cast<size_t>(idx & (RING_SIZE - 1))]);
+		}
+
+		// Anything the writer has wrapped around to since we started
+		// copying may be torn, including the slot for event newHead, which
+		// may be being written right now.
+		MR_UInt64 newHead = buf.head.load(std::memory_order_acquire);
+		MR_UInt64 safeTail = newHead + 1 > RING_SIZE ?
+			newHead + 1 - RING_SIZE : 0;
+		size_t skip = 0;
+		if (safeTail > tail) {
+			skip = static_cast<size_t>(
+				std::min(safeTail - tail, head - tail));
+		}
+
+		for (size_t j = skip; j < events.size(); j++) {
+			const Event &evt = events[j];
+			if (evt.start + evt.dur < cutoff) continue;
+
+			sep() << "{\"name\":";
+			OutputJsonString(os, evt.name);
+			os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << owner.tid <<
+				",\"ts\":" << (static_cast<double>(evt.start) / 1000.0) <<
+				",\"dur\":" << (static_cast<double>(evt.dur) / 1000.0) << '}';
+			count++;
+		}
+	}
+
+	os << "\n]}\n";
+
+	os.flags(oldFlags);
+	os.precision(oldPrecision);
+
+	return count;
+}
+
+}  // namespace Util
+}  // namespace HoverRace
@@ -0,0 +1,129 @@
+
+// Tracer.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include "MR_Types.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+#define HR_TRACE_CAT2(a, b) a##b
+#define HR_TRACE_CAT(a, b) HR_TRACE_CAT2(a, b)
+
+/**
+ * Trace the rest of the enclosing scope as a named zone.
+ * @param name The zone name; must be a string literal (or otherwise outlive
+ *             the trace buffers).
+ */
+#define HR_TRACE_ZONE(name) \
+	::HoverRace::Util::Tracer::Zone HR_TRACE_CAT(hrTraceZone, __LINE__)(name)
+
+namespace HoverRace {
+namespace Util {
+
+/**
+ * Records timed zones from all threads so individual frames can be inspected.
+ *
+ * Each thread writes to its own fixed-size ring buffer without locking, so
+ * only the most recent events are kept.  When a thread exits, its buffer is
+ * handed to the next thread that records an event.  The buffers can be
+ * dumped at any time in the Chrome trace event format (viewable in
+ * chrome://tracing or Perfetto), where each thread is identified by a trace
+ * thread number rather than its OS thread ID.
+ *
+ * Tracing is disabled by default; a disabled zone costs a single flag check.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare Tracer
+{
+public:
+	Tracer() = delete;
+
+public:
+	using clock_t = std::chrono::steady_clock;
+
+	/**
+	 * A completed zone.
+	 */
+	struct Event
+	{
+		const char *name;
+		MR_UInt64 start;  ///< Start time, in nanoseconds since the epoch.
+		MR_UInt64 dur;  ///< Duration, in nanoseconds.
+	};
+
+	/**
+	 * Records the lifetime of the zone object as an event.
+	 */
+	class Zone
+	{
+	public:
+		Zone() = delete;
+		Zone(const char *name) :
+			name(name), active(IsEnabled()), start(active ? Now() : 0) { }
+		~Zone()
+		{
+			if (active) Record(name, start, Now() - start);
+		}
+
+		Zone(const Zone&) = delete;
+		Zone &operator=(const Zone&) = delete;
+
+	private:
+		const char *name;
+		bool active;
+		MR_UInt64 start;
+	};
+
+public:
+	/**
+	 * Check if zones are currently being recorded.
+	 * @return @c true if enabled, @c false if not.
+	 */
+	static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+	static void SetEnabled(bool enabled);
+
+	static void SetThreadName(const std::string &name);
+
+	static MR_UInt64 Now();
+	static void Record(const char *name, MR_UInt64 start, MR_UInt64 dur);
+
+	static size_t Dump(std::ostream &os, double seconds);
+
+private:
+	static std::atomic<bool> enabled;
+};
+
+}  // namespace Util
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
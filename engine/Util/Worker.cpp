@@ -0,0 +1,115 @@
+// Worker.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "Tracer.h"
+
+#include "Worker.h"
+
+namespace HoverRace {
+namespace Util {
+
+Worker::Worker() :
+	running(false), pending(false), quit(false),
+	thread(&Worker::ThreadProc, this)
+{
+}
+
+Worker::~Worker()
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cond.wait(lock, [&]{ return !running; });
+		quit = true;
+	}
+	cond.notify_all();
+	thread.join();
+}
+
+/**
+ * Start a job in the background.
+ * If the previous job has not been waited for, this waits for it first.
+ * @param job The job.
+ */
+void Worker::Start(std::function<void()> job)
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = std::move(job);
+		running = true;
+		pending = true;
+	}
+	cond.notify_all();
+}
+
+/**
+ * Wait for the current job to finish.
+ * If the job threw an exception, it is rethrown here.
+ * Does nothing if there is no current job.
+ */
+void Worker::Wait()
+{
+	if (!pending) return;
+
+	std::exception_ptr jobError;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		cond.wait(lock, [&]{ return !running; });
+		pending = false;
+		std::swap(jobError, error);
+	}
+
+	if (jobError) {
+		std::rethrow_exception(jobError);
+	}
+}
+
+void Worker::ThreadProc()
+{
+	Tracer::SetThreadName("worker");
+
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;) {
+		cond.wait(lock, [&]{ return running || quit; });
+		if (quit) break;
+
+		auto curJob = std::move(job);
+		job = nullptr;
+		lock.unlock();
+
+		try {
+			HR_TRACE_ZONE("job");
+			curJob();
+		}
+		catch (...) {
+			lock.lock();
+			error = std::current_exception();
+			lock.unlock();
+		}
+
+		lock.lock();
+		running = false;
+		cond.notify_all();
+	}
+}
+
+}  // namespace Util
+}  // namespace HoverRace
@@ -0,0 +1,85 @@
+// Worker.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+namespace Util {
+
+/**
+ * A background thread that runs one job at a time.
+ *
+ * The thread is started once and kept for the lifetime of the worker,
+ * so starting a job is cheap enough to do every frame.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare Worker
+{
+public:
+	Worker();
+	~Worker();
+
+	Worker(const Worker&) = delete;
+	Worker &operator=(const Worker&) = delete;
+
+public:
+	void Start(std::function<void()> job);
+	void Wait();
+
+	/**
+	 * Check if a job has been started and not waited for.
+	 * @return @c true if busy.
+	 */
+	bool IsBusy() const { return pending; }
+
+private:
+	void ThreadProc();
+
+private:
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::function<void()> job;
+	std::exception_ptr error;
+	bool running;  ///< The thread is running the job.
+	bool pending;  ///< The job has not been waited for yet.
+	bool quit;
+	std::thread thread;
+};
+
+}  // namespace Util
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
@@ -64,6 +64,39 @@ class MR_DllDeclare Bitmap
 		virtual MR_UInt8 *GetBuffer(int pSubBitmap) const = 0;
 		virtual MR_UInt8 *GetColumnBuffer(int pSubBitmap, int pColumn) const = 0;
 		virtual MR_UInt8 **GetColumnBufferTable(int pSubBitmap) const = 0;
+
+		/**
+		 * Retrieve the tiled copy of a sub-bitmap.
+		 * In the tiled layout, the texels are stored in vertical strips
+		 * TILE_SIZE texels wide, row by row within each strip, so each
+		 * TILE_SIZE x TILE_SIZE tile is contiguous in memory.
+		 * Use GetTiledOffset() (or the column and row helpers) to locate a
+		 * texel.
+		 * @param pSubBitmap The sub-bitmap index.
+		 * @return The tiled buffer, or @c NULL if this bitmap has no tiled
+		 *         copy (the column buffers must be used instead).
+		 */
+		virtual MR_UInt8 *GetTiledBuffer(int) const { return NULL; }
+
+		// Tiled layout sampling helpers
+		static const int TILE_SHIFT = 3;
+		static const int TILE_SIZE = 1 << TILE_SHIFT;
+		static const int TILE_MASK = TILE_SIZE - 1;
+
+		/// Offset of the first texel of a column in a tiled sub-bitmap.
+		static int GetTiledColumnOffset(int pColumn, int pYRes)
+		{
+			return (pColumn & ~TILE_MASK) * pYRes + (pColumn & TILE_MASK);
+		}
+
+		/// Offset of a row from the first texel of a column in a tiled sub-bitmap.
+		static int GetTiledRowOffset(int pRow) { return pRow << TILE_SHIFT; }
+
+		/// Offset of a texel in a tiled sub-bitmap.
+		static int GetTiledOffset(int pColumn, int pRow, int pYRes)
+		{
+			return GetTiledColumnOffset(pColumn, pYRes) + GetTiledRowOffset(pRow);
+		}
 };
 
 }  // namespace VideoServices
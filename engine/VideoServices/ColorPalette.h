@@ -51,6 +51,15 @@ namespace ColorPalette {
 #define MR_BASIC_COLORS               100		  // Includes some extra space
 #define MR_BACK_COLORS                128
 
+// Named entries of the basic palette (see basicPalette in ColorTab.cpp)
+#define MR_BASIC_WHITE                (MR_RESERVED_COLORS_BEGINNING + 0)
+#define MR_BASIC_BLACK                (MR_RESERVED_COLORS_BEGINNING + 1)
+#define MR_BASIC_GREEN                (MR_RESERVED_COLORS_BEGINNING + 21)
+#define MR_BASIC_RED                  (MR_RESERVED_COLORS_BEGINNING + 25)
+#define MR_BASIC_BLUE                 (MR_RESERVED_COLORS_BEGINNING + 40)
+#define MR_BASIC_YELLOW               (MR_RESERVED_COLORS_BEGINNING + 54)
+#define MR_BASIC_ORANGE               (MR_RESERVED_COLORS_BEGINNING + 61)
+
 #define MR_NB_COLOR_INTENSITY       256
 #define MR_NORMAL_INTENSITY         128
 
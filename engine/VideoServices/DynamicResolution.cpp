@@ -0,0 +1,95 @@
+// DynamicResolution.cpp
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include <cmath>
+
+#include "../Util/Config.h"
+
+#include "DynamicResolution.h"
+
+using namespace HoverRace::Util;
+
+namespace HoverRace {
+namespace VideoServices {
+
+namespace {
+
+/// Fraction of the frame budget that the controller aims for.
+const double TARGET_LOAD = 0.85;
+
+/// Only react when the load leaves this band, to avoid hunting.
+const double MIN_LOAD = 0.6;
+const double MAX_LOAD = 0.95;
+
+/// Largest change in a single update.
+const double MAX_STEP_DOWN = 0.75;
+const double MAX_STEP_UP = 1.1;
+
+/// The scale is kept to multiples of this.
+const double SCALE_GRANULARITY = 1.0 / 32.0;
+
+}  // namespace
+
+DynamicResolution::DynamicResolution() :
+	scale(1.0)
+{
+}
+
+/**
+ * Adjust the scale for the next frames.
+ * @param frameTime The average time it took to render a frame at the
+ *                  current scale.
+ * @return The new scale (also available via GetScale()).
+ */
+double DynamicResolution::Update(Profiler::dur_t frameTime)
+{
+	const auto &vidCfg = Config::GetInstance()->video;
+
+	if (!vidCfg.dynamicRes) {
+		return (scale = 1.0);
+	}
+
+	double minScale = vidCfg.dynamicResMinScale;
+	double maxScale = std::max(minScale, vidCfg.dynamicResMaxScale);
+
+	double frameMs = std::chrono::duration<double, std::milli>(frameTime).count();
+	double budgetMs = 1000.0 / std::max(1, vidCfg.dynamicResTargetFps);
+
+	if (frameMs > 0) {
+		double load = frameMs / budgetMs;
+		if (load > MAX_LOAD || load < MIN_LOAD) {
+			// The render time is roughly proportional to the number of
+			// pixels, i.e. the square of the scale.
+			double step = std::sqrt(TARGET_LOAD / load);
+			step = std::max(MAX_STEP_DOWN, std::min(MAX_STEP_UP, step));
+
+			scale = std::floor(scale * step / SCALE_GRANULARITY + 0.5) *
+				SCALE_GRANULARITY;
+		}
+	}
+
+	if (scale < minScale) scale = minScale;
+	else if (scale > maxScale) scale = maxScale;
+
+	return scale;
+}
+
+}  // namespace VideoServices
+}  // namespace HoverRace
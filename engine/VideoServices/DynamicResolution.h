@@ -0,0 +1,62 @@
+// DynamicResolution.h
+//
+// Copyright (c) 2016 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#pragma once
+
+#include "../Util/Profiler.h"
+
+#if defined(_WIN32) && defined(HR_ENGINE_SHARED)
+#	ifdef MR_ENGINE
+#		define MR_DllDeclare   __declspec( dllexport )
+#	else
+#		define MR_DllDeclare   __declspec( dllimport )
+#	endif
+#else
+#	define MR_DllDeclare
+#endif
+
+namespace HoverRace {
+namespace VideoServices {
+
+/**
+ * Picks the render scale of the legacy 3D view from the measured frame time.
+ *
+ * The scale is lowered when rendering misses the frame budget (from the
+ * target frame rate in the video config) and raised again when there is
+ * time to spare, within the configured min and max scale.
+ * @author Michael Imamura
+ */
+class MR_DllDeclare DynamicResolution
+{
+public:
+	DynamicResolution();
+
+public:
+	double Update(Util::Profiler::dur_t frameTime);
+	double GetScale() const { return scale; }
+
+private:
+	double scale;
+};
+
+}  // namespace VideoServices
+}  // namespace HoverRace
+
+#undef MR_DllDeclare
@@ -0,0 +1,50 @@
+// OffscreenVideoBuffer.cpp
+//
+// Copyright (c) 2015 Michael Imamura.
+//
+// Licensed under GrokkSoft HoverRace SourceCode License v1.0(the "License");
+// you may not use this file except in compliance with the License.
+//
+// A copy of the license should have been attached to the package from which
+// you have taken this file. If you can not find the license you can not use
+// this file.
+//
+//
+// The author makes no representations about the suitability of
+// this software for any purpose.  It is provided "as is" "AS IS",
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied.
+//
+// See the License for the specific language governing permissions
+// and limitations under the License.
+
+#include "OffscreenVideoBuffer.h"
+
+namespace HoverRace {
+namespace VideoServices {
+
+/**
+ * Constructor.
+ * @param width The width of the buffer, in pixels.
+ * @param height The height of the buffer, in pixels.
+ */
+OffscreenVideoBuffer::OffscreenVideoBuffer(int width, int height) :
+	SUPER()
+{
+	SetSize(width, height);
+	CreatePalette();
+}
+
+/**
+ * Change the size of the buffer.
+ * The contents of the buffer are lost.
+ * @param width The new width, in pixels.
+ * @param height The new height, in pixels.
+ */
+void OffscreenVideoBuffer::Resize(int width, int height)
+{
+	SetSize(width, height);
+}
+
+}  // namespace VideoServices
+}  // namespace HoverRace
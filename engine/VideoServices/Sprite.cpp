@@ -88,6 +88,27 @@ void Sprite::Serialize(Parcel::ObjStream &pArchive)
 	}
 }
 
+/**
+ * Advance the stream past a serialized sprite without loading it.
+ * @param pArchive The archive to read from.
+ */
+void Sprite::Skip(Parcel::ObjStream &pArchive)
+{
+	using namespace Parcel;
+
+	int lNbItem, lItemHeight, lTotalHeight, lWidth;
+
+	pArchive >> lNbItem;
+	pArchive >> lItemHeight;
+	pArchive >> lTotalHeight;
+	pArchive >> lWidth;
+
+	if (lTotalHeight <= 0) throw ObjStreamExn("mTotalHeight must be > 0");
+	if (lWidth <= 0) throw ObjStreamExn("mWidth must be > 0");
+
+	pArchive.Skip(static_cast<size_t>(lWidth * lTotalHeight));
+}
+
 void Sprite::Blt(int pX, int pY, Viewport2D *pDest, eAlignment pHAlign, eAlignment pVAlign, int pItem, int pScaling) const
 {
 	ASSERT((pItem < mNbItem) && (pItem >= 0));
@@ -80,6 +80,7 @@ public:
 	int GetItemWidth() const;
 
 	void Serialize(Parcel::ObjStream &pArchive);
+	static void Skip(Parcel::ObjStream &pArchive);
 };
 
 // Helper class and functions
@@ -40,15 +40,27 @@ namespace VideoServices {
  */
 VideoBuffer::VideoBuffer(Display::Display &display) :
 	desktopWidth(0), desktopHeight(0), width(0), height(0), pitch(0),
-	fullscreen(false),
-	legacySurface(nullptr), vbuf(nullptr), zbuf(nullptr),
-	bgPalette()
+	fullscreen(false), renderScale(1.0), renderWidth(0), renderHeight(0),
+	legacySurface(nullptr), vbuf(nullptr), zbuf(nullptr), zGeneration(0),
+	bgPalette(), bgGeneration(0)
 {
 	// Be notified of window resizes so we can update the internal surface.
 	display.GetDisplayConfigChangedSignal().connect(
 		std::bind(&VideoBuffer::OnWindowResChange, this));
 }
 
+/**
+ * Constructor for a buffer that is not connected to any display.
+ * Subclasses are responsible for calling SetSize().
+ */
+VideoBuffer::VideoBuffer() :
+	desktopWidth(0), desktopHeight(0), width(0), height(0), pitch(0),
+	fullscreen(false), renderScale(1.0), renderWidth(0), renderHeight(0),
+	legacySurface(nullptr), vbuf(nullptr), zbuf(nullptr), zGeneration(0),
+	bgPalette(), bgGeneration(0)
+{
+}
+
 VideoBuffer::~VideoBuffer()
 {
 	delete[] zbuf;
@@ -77,8 +89,19 @@ void VideoBuffer::OnDesktopModeChange(int width, int height)
 void VideoBuffer::OnWindowResChange()
 {
 	const auto &vidCfg = Config::GetInstance()->video;
-	width = vidCfg.xRes;
-	height = vidCfg.yRes;
+	SetSize(vidCfg.xRes, vidCfg.yRes);
+}
+
+/**
+ * Reallocate the buffers for a new size.
+ * The contents of the buffers are lost.
+ * @param width The new width, in pixels.
+ * @param height The new height, in pixels.
+ */
+void VideoBuffer::SetSize(int width, int height)
+{
+	this->width = width;
+	this->height = height;
 	pitch = width;
 
 	int remainder = width % 4;
@@ -97,7 +120,73 @@ void VideoBuffer::OnWindowResChange()
 	AssignPalette();
 
 	delete[] zbuf;
-	zbuf = new MR_UInt16[width * height];
+	zbuf = new MR_UInt32[width * height];
+	ClearZ();
+
+	SetRenderScale(renderScale);
+}
+
+/**
+ * Set the fraction of the buffer that the legacy renderer draws into.
+ *
+ * With a scale below 1.0, the renderer draws into the region of
+ * GetRenderWidth() x GetRenderHeight() pixels in the top-left corner of the
+ * buffer, and the display stretches that region to the whole window when
+ * the frame is presented.
+ *
+ * @param scale The scale (clamped to the range 0.1 to 1.0).
+ */
+void VideoBuffer::SetRenderScale(double scale)
+{
+	if (scale > 1.0) scale = 1.0;
+	else if (scale < 0.1) scale = 0.1;
+
+	renderScale = scale;
+
+	if (scale == 1.0) {
+		renderWidth = width;
+		renderHeight = height;
+	}
+	else {
+		// Keep the lines 32-bit aligned, like the viewport margins.
+		renderWidth = static_cast<int>(width * scale) & ~3;
+		renderHeight = static_cast<int>(height * scale);
+
+		if (renderWidth < 4) renderWidth = std::min(4, width);
+		if (renderHeight < 1) renderHeight = std::min(1, height);
+	}
+}
+
+/**
+ * Reset the whole Z buffer.
+ */
+void VideoBuffer::ClearZ()
+{
+	if (zbuf) {
+		memset(zbuf, 0xff, sizeof(MR_UInt32) * width * height);
+	}
+	zGeneration = 0;
+}
+
+/**
+ * Start a new generation of Z buffer values.
+ *
+ * Each Z buffer entry holds the depth in the low 16 bits and the inverted
+ * generation in the high 16 bits, so anything written during a previous
+ * generation is farther than anything written during the new one.
+ * Starting a new generation is therefore as good as clearing the Z buffer,
+ * except that it costs nothing.  Once every 65536 generations, the
+ * generation wraps around and the Z buffer is really cleared.
+ *
+ * @return The generation bits to combine with each depth written during
+ *         the new generation.
+ */
+MR_UInt32 VideoBuffer::NextZGeneration()
+{
+	if (++zGeneration > 0xffff) {
+		ClearZ();
+	}
+	return Z_FIRST_GENERATION - (zGeneration << 16);
 }
 
 void VideoBuffer::CreatePalette()
@@ -147,6 +236,7 @@ void VideoBuffer::CreatePalette()
 void VideoBuffer::SetBackgroundPalette(std::unique_ptr<MR_UInt8[]> &palette)
 {
 	bgPalette = std::move(palette);
+	bgGeneration++;
 	CreatePalette();
 }
 
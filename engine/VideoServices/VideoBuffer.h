@@ -74,18 +74,23 @@ public:
 
 public:
 	VideoBuffer(Display::Display &display);
+protected:
+	VideoBuffer();
+public:
 	virtual ~VideoBuffer();
 
 	// Signals from ClientApp that certain settings have changed.
 	void OnDesktopModeChange(int width, int height);
 protected:
 	virtual void OnWindowResChange();
+	void SetSize(int width, int height);
 
 public:
 	const ColorPalette::paletteEntry_t *GetPalette() const { return palette; }
 	void AssignPalette();
 	void CreatePalette();
 	void SetBackgroundPalette(std::unique_ptr<MR_UInt8[]> &palette);
+	MR_UInt32 GetBackgroundGeneration() const { return bgGeneration; }
 	typedef boost::signals2::signal<void()> paletteChangedSignal_t;
 	paletteChangedSignal_t &GetPaletteChangedSignal() { return paletteChangedSignal; }
 
@@ -100,12 +105,23 @@ public:
 	int GetPitch() const { return pitch; }
 	int GetZPitch() const { return width; }
 
+	void SetRenderScale(double scale);
+	double GetRenderScale() const { return renderScale; }
+	int GetRenderWidth() const { return renderWidth; }
+	int GetRenderHeight() const { return renderHeight; }
+
 protected:
 	SDL_Surface *GetLegacySurface() const { return legacySurface; }
 
 public:
+	/// Generation bits of the values written right after ClearZ().
+	static const MR_UInt32 Z_FIRST_GENERATION = 0xFFFF0000u;
+
 	MR_UInt8 *GetBuffer() const { return vbuf; }
-	MR_UInt16 *GetZBuffer() const { return zbuf; }
+	MR_UInt32 *GetZBuffer() const { return zbuf; }
+
+	void ClearZ();
+	MR_UInt32 NextZGeneration();
 
 	void Clear(MR_UInt8 color = 0);
 
@@ -120,12 +136,16 @@ private:
 	int desktopWidth, desktopHeight;
 	int width, height, pitch;
 	bool fullscreen;
+	double renderScale;
+	int renderWidth, renderHeight;
 
 	SDL_Surface *legacySurface;
 	MR_UInt8 *vbuf;
-	MR_UInt16 *zbuf;
+	MR_UInt32 *zbuf;
+	MR_UInt32 zGeneration;
 
 	std::unique_ptr<MR_UInt8[]> bgPalette;
+	MR_UInt32 bgGeneration;  // Bumped each time a background is set
 
 	ColorPalette::paletteEntry_t palette[256];
 	paletteChangedSignal_t paletteChangedSignal;
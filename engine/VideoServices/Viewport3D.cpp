@@ -33,8 +33,14 @@ namespace VideoServices {
 Viewport3D::Viewport3D() :
 	mPosition(0, 0, 0), mOrientation(0),
 	mScroll(0), mVAngle(1),
-	mZBuffer(NULL), mBufferLine(NULL), mZBufferLine(NULL),
-	mBackgroundConst(NULL)
+	mZBuffer(NULL), mZBase(0), mZGenerations(TRUE), mTiledTextures(FALSE),
+	mActorBatching(FALSE), mPatchTested(0), mPatchCulled(0),
+	mBufferLine(NULL), mZBufferLine(NULL),
+	mBackgroundConst(NULL),
+	mBackgroundCache(FALSE), mBackgroundSource(NULL), mBackgroundGeneration(0), mBackgroundImage(NULL),
+	mBackgroundRows(NULL), mBackgroundStartingLine(-1), mBackgroundBottomLine(-1),
+	mWallCoverage(FALSE), mCoverage(NULL), mCoverageUsed(FALSE), mCoverageTested(0), mCoverageSkipped(0),
+	mOverdrawTracking(FALSE), mOverdraw(NULL)
 {
 }
 
@@ -43,6 +49,10 @@ Viewport3D::~Viewport3D()
 	delete[]mBufferLine;
 	delete[]mZBufferLine;
 	delete[]mBackgroundConst;
+	delete[]mBackgroundImage;
+	delete[]mBackgroundRows;
+	delete[]mCoverage;
+	delete[]mOverdraw;
 }
 
 void Viewport3D::OnMetricsChange(int pMetrics)
@@ -75,10 +85,10 @@ void Viewport3D::OnMetricsChange(int pMetrics)
 		delete[]mZBufferLine;
 
 		mBufferLine = new MR_UInt8 *[mYRes];
-		mZBufferLine = new MR_UInt16 *[mYRes];
+		mZBufferLine = new MR_UInt32 *[mYRes];
 
 		MR_UInt8 *lLineBuffer = mBuffer;
-		MR_UInt16 *lZLineBuffer = mZBuffer;
+		MR_UInt32 *lZLineBuffer = mZBuffer;
 
 		for(int lCounter = 0; lCounter < mYRes; lCounter++) {
 			mBufferLine[lCounter] = lLineBuffer;
@@ -87,6 +97,8 @@ void Viewport3D::OnMetricsChange(int pMetrics)
 			lLineBuffer += mLineLen;
 			lZLineBuffer += mZLineLen;
 		}
+
+		AllocCoverage();
 	}
 
 	ComputeBackgroundConst();
@@ -95,7 +107,7 @@ void Viewport3D::OnMetricsChange(int pMetrics)
 void Viewport3D::Setup(VideoBuffer * pBuffer, int pX0, int pY0, int pSizeX, int pSizeY, MR_Angle pApperture, int pMetrics)
 {
 	mZLineLen = pBuffer->GetZPitch();
-	MR_UInt16 *lNewZBuffer = pBuffer->GetZBuffer() + pX0 + mZLineLen * pY0;
+	MR_UInt32 *lNewZBuffer = pBuffer->GetZBuffer() + pX0 + mZLineLen * pY0;
 
 	if(lNewZBuffer != mZBuffer) {
 		mZBuffer = lNewZBuffer;
@@ -125,6 +137,11 @@ void Viewport3D::ComputeBackgroundConst()
 
 	mBackgroundConst = new BackColumn[mXRes];
 
+	// The cached rows depend on the constants
+	delete[]mBackgroundRows;
+	mBackgroundRows = NULL;
+	mBackgroundStartingLine = -1;
+
 	for(int lCounter = 0; lCounter < mXRes; lCounter++) {
 		mBackgroundConst[lCounter].mBitmapColumn =
 			static_cast<MR_Int32>(
@@ -272,6 +289,115 @@ BOOL Viewport3D::ComputePositionMatrix(PositionMatrix & pMatrix, const MR_3DCoor
 	return lReturnValue;
 }
 
+/**
+ * Check if a sphere is at least partly inside the view frustum.
+ *
+ * This is meant to reject objects before doing any per-vertex work, so it
+ * is conservative: a sphere near a corner of the frustum may be accepted
+ * even though it is off-screen.
+ *
+ * @param pCenter The center of the sphere, in world coordinates.
+ * @param pRay The ray of the sphere.
+ * @return @c TRUE if the sphere may be visible,
+ *         @c FALSE if it is certainly off-screen.
+ */
+BOOL Viewport3D::IsSphereVisible(const MR_3DCoordinate & pCenter, MR_Int32 pRay) const
+{
+	MR_3DCoordinate lCenter;
+
+	ApplyRotationMatrix(pCenter, lCenter);
+
+	// Near and far limits (same as ComputePositionMatrix)
+	if((lCenter.mX < mPlanDist - pRay) || (lCenter.mX > (MR_ZBUFFER_LIMIT * MR_ZBUFFER_UNIT) + pRay)) {
+		return FALSE;
+	}
+
+	const double lX = lCenter.mX;
+	const double lRay = pRay;
+
+	// Left and right planes: |Y| <= X * mPlanHW / mPlanDist
+	double lHSlope = static_cast<double>(mPlanHW) / mPlanDist;
+	if(fabs(static_cast<double>(lCenter.mY)) - lHSlope * lX > lRay * sqrt(1.0 + lHSlope * lHSlope)) {
+		return FALSE;
+	}
+
+	// Top and bottom planes, shifted by the vertical scroll
+	double lTopSlope = static_cast<double>(mPlanVW) * (mYRes + 2 * mScroll) / (static_cast<double>(mYRes) * mPlanDist);
+	double lBottomSlope = static_cast<double>(mPlanVW) * (mYRes - 2 * mScroll) / (static_cast<double>(mYRes) * mPlanDist);
+
+	if(lCenter.mZ - lTopSlope * lX > lRay * sqrt(1.0 + lTopSlope * lTopSlope)) {
+		return FALSE;
+	}
+	if(-lCenter.mZ - lBottomSlope * lX > lRay * sqrt(1.0 + lBottomSlope * lBottomSlope)) {
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Compute the range of screen columns covered by a vertical wall.
+ *
+ * Only the horizontal extent is considered, so this is a conservative test
+ * suitable for portal culling: the wall is clipped just in front of the
+ * camera (not at the projection plane) so that a portal the camera is
+ * standing in never gets rejected.
+ *
+ * @param pP0 The first end of the wall, in world coordinates.
+ * @param pP1 The other end of the wall, in world coordinates.
+ * @param[out] pLeft The first column covered by the wall.
+ * @param[out] pRight One past the last column covered by the wall.
+ * @return @c TRUE if the wall covers at least one column,
+ *         @c FALSE if it is entirely off-screen or behind the camera.
+ */
+BOOL Viewport3D::ComputeWallColumns(const MR_2DCoordinate & pP0, const MR_2DCoordinate & pP1, int & pLeft, int & pRight) const
+{
+	MR_2DCoordinate lRotated[2];
+
+	ApplyRotationMatrix(pP0, lRotated[0]);
+	ApplyRotationMatrix(pP1, lRotated[1]);
+
+	if(lRotated[0].mX < 1 && lRotated[1].mX < 1) {
+		// Behind the camera
+		return FALSE;
+	}
+
+	// Cut the part that is behind the camera
+	for(int lCounter = 0; lCounter < 2; lCounter++) {
+		MR_2DCoordinate &lCut = lRotated[lCounter];
+		const MR_2DCoordinate &lOther = lRotated[1 - lCounter];
+
+		if(lCut.mX < 1) {
+			lCut.mY += static_cast<MR_Int32>(
+				(static_cast<MR_Int64>(lOther.mY - lCut.mY) * (1 - lCut.mX)) /
+				(lOther.mX - lCut.mX));
+			lCut.mX = 1;
+		}
+	}
+
+	int lColumn[2];
+
+	for(int lCounter = 0; lCounter < 2; lCounter++) {
+		MR_Int64 lScreenX =
+			(-static_cast<MR_Int64>(lRotated[lCounter].mY) * mXRes_PlanDist) /
+			(static_cast<MR_Int64>(lRotated[lCounter].mX) * mPlanHW * 2) +
+			mXRes / 2;
+
+		if(lScreenX < -1) {
+			lScreenX = -1;
+		}
+		else if(lScreenX > mXRes + 1) {
+			lScreenX = mXRes + 1;
+		}
+		lColumn[lCounter] = static_cast<int>(lScreenX);
+	}
+
+	pLeft = std::max(0, std::min(lColumn[0], lColumn[1]));
+	pRight = std::min(mXRes, std::max(lColumn[0], lColumn[1]) + 1);
+
+	return (pLeft < pRight) ? TRUE : FALSE;
+}
+
 void Viewport3D::ApplyPositionMatrix(const PositionMatrix & pMatrix, const MR_3DCoordinate & pSrc, MR_3DCoordinate & pDest) const
 {
 	MR_2DCoordinate lPos;
@@ -288,11 +414,218 @@ void Viewport3D::ApplyPositionMatrix(const PositionMatrix & pMatrix, const MR_3D
 void Viewport3D::ClearZ()
 {
 	assert(mXRes >= 0);
-	MR_UInt16 *lZBuffer = mZBuffer;
 
-	for(int lCounter = 0; lCounter < mYRes; lCounter++) {
-		memset(lZBuffer, -1, static_cast<size_t>(2 * mXRes));
-		lZBuffer += mZLineLen;
+	if(mZGenerations) {
+		// Everything already in the buffer is now behind the new generation
+		mZBase = mVideoBuffer->NextZGeneration();
+	}
+	else {
+		MR_UInt32 *lZBuffer = mZBuffer;
+
+		for(int lCounter = 0; lCounter < mYRes; lCounter++) {
+			memset(lZBuffer, -1, static_cast<size_t>(mXRes) * sizeof(MR_UInt32));
+			lZBuffer += mZLineLen;
+		}
+		mZBase = VideoBuffer::Z_FIRST_GENERATION;
+	}
+
+	// The coverage only describes what is in the Z buffer, so it goes too
+	ResetCoverage();
+	mCoverageTested = 0;
+	mCoverageSkipped = 0;
+	mPatchTested = 0;
+	mPatchCulled = 0;
+
+	if(mOverdraw != NULL) {
+		memset(mOverdraw, 0, static_cast<size_t>(mXRes * mYRes));
+	}
+}
+
+/**
+ * Select how ClearZ works.
+ * With generations (the default), ClearZ only starts a new Z buffer
+ * generation (see VideoBuffer::NextZGeneration) instead of rewriting the
+ * whole Z buffer.  Without, the Z buffer is filled every time; this is only
+ * useful to compare the two.
+ * @param pEnabled @c TRUE to use generations.
+ */
+void Viewport3D::SetZGenerations(BOOL pEnabled)
+{
+	mZGenerations = pEnabled;
+}
+
+/**
+ * Select the texel layout used to draw walls and floors.
+ * With tiled textures, the walls and floors are sampled from the tiled
+ * copy of the bitmaps (see Bitmap::GetTiledBuffer), which keeps
+ * neighboring texels in the same cache lines no matter which direction the
+ * texture is walked in.  Bitmaps without a tiled copy always use the
+ * column buffers.  By default, only the column buffers are used, so the
+ * tiled copies are never built.
+ * @param pEnabled @c TRUE to use the tiled layout.
+ */
+void Viewport3D::SetTiledTextures(BOOL pEnabled)
+{
+	mTiledTextures = pEnabled;
+}
+
+/**
+ * Select how actor meshes are drawn.
+ * With batching, each frame of an actor is transformed in a single pass
+ * over its shared vertex list (see TransformVertices), and patches that
+ * are entirely off-screen or facing away from the camera are rejected
+ * before any triangle setup (see RenderTransformedPatch).
+ * Without (the default), each patch transforms its own nodes, as
+ * RenderPatch always did.
+ * @param pEnabled @c TRUE to batch.
+ */
+void Viewport3D::SetActorBatching(BOOL pEnabled)
+{
+	mActorBatching = pEnabled;
+}
+
+/**
+ * Enable or disable the background cache.
+ * With the cache, RenderBackground works from a row-major copy of the
+ * background and from the source row of every pixel, which are only
+ * computed again when the background, the viewport size, the aperture
+ * or the scroll changes.  Each frame is then a row by row copy.  The result
+ * is identical to the uncached rendering, which is the default.
+ * The copy is keyed on the bitmap and on the background generation of the
+ * video buffer, which changes whenever a new background palette is set.
+ * @param pEnabled @c TRUE to enable.
+ */
+void Viewport3D::SetBackgroundCache(BOOL pEnabled)
+{
+	mBackgroundCache = pEnabled;
+}
+
+/**
+ * Enable or disable the wall coverage buffer.
+ * When enabled, each screen column remembers the spans that have already
+ * been covered by walls and at what depth, so that wall columns that are
+ * completely hidden behind them are skipped instead of being Z-tested pixel
+ * by pixel.  The result is identical to the plain Z-tested rendering; it is
+ * only faster when walls are submitted roughly front-to-back.
+ * @param pEnabled @c TRUE to enable.
+ */
+void Viewport3D::SetWallCoverage(BOOL pEnabled)
+{
+	if(mWallCoverage != pEnabled) {
+		mWallCoverage = pEnabled;
+		AllocCoverage();
+	}
+}
+
+/**
+ * Enable or disable counting of the wall pixels written at each screen
+ * position (see RenderOverdraw).
+ * @param pEnabled @c TRUE to enable.
+ */
+void Viewport3D::SetOverdrawTracking(BOOL pEnabled)
+{
+	if(mOverdrawTracking != pEnabled) {
+		mOverdrawTracking = pEnabled;
+		AllocCoverage();
+	}
+}
+
+void Viewport3D::AllocCoverage()
+{
+	delete[]mCoverage;
+	mCoverage = NULL;
+
+	delete[]mOverdraw;
+	mOverdraw = NULL;
+
+	if(mXRes <= 0 || mYRes <= 0) {
+		return;
+	}
+
+	if(mWallCoverage) {
+		mCoverage = new CoverageColumn[mXRes];
+		mCoverageUsed = TRUE;
+		ResetCoverage();
+	}
+
+	if(mOverdrawTracking) {
+		mOverdraw = new MR_UInt8[mXRes * mYRes];
+		memset(mOverdraw, 0, static_cast<size_t>(mXRes * mYRes));
+	}
+}
+
+void Viewport3D::ResetCoverage()
+{
+	if(mCoverage != NULL && mCoverageUsed) {
+		for(int lCounter = 0; lCounter < mXRes; lCounter++) {
+			mCoverage[lCounter].mNbSpan = 0;
+		}
+	}
+	mCoverageUsed = FALSE;
+}
+
+#ifndef NDEBUG
+/**
+ * Check that an entry of the basic palette has roughly the given color.
+ * @param pIndex The palette index (including the reserved offset).
+ * @param pRed The expected red component (0.0 to 1.0).
+ * @param pGreen The expected green component (0.0 to 1.0).
+ * @param pBlue The expected blue component (0.0 to 1.0).
+ * @return @c true if every component is within 0.02 of the palette entry.
+ */
+static bool IsBasicColor(int pIndex, double pRed, double pGreen, double pBlue)
+{
+	const double *lEntry = ColorPalette::basicPalette[pIndex - MR_RESERVED_COLORS_BEGINNING];
+	return
+		fabs(lEntry[0] - pRed) < 0.02 &&
+		fabs(lEntry[1] - pGreen) < 0.02 &&
+		fabs(lEntry[2] - pBlue) < 0.02;
+}
+#endif
+
+/**
+ * Replace the rendered image by a heat map of the wall overdraw.
+ * Each pixel shows how many times a wall was written there since the last
+ * ClearZ: black for none, then blue, green, yellow, orange, red and white
+ * for eight or more.  Does nothing unless overdraw tracking is enabled.
+ */
+void Viewport3D::RenderOverdraw()
+{
+	static const MR_UInt8 lHeat[] = {
+		MR_BASIC_BLACK,
+		MR_BASIC_BLUE,
+		MR_BASIC_GREEN,
+		MR_BASIC_YELLOW,
+		MR_BASIC_ORANGE,
+		MR_BASIC_RED,
+		MR_BASIC_RED,
+		MR_BASIC_RED,
+		MR_BASIC_WHITE,
+	};
+	const int lNbHeat = sizeof(lHeat) / sizeof(lHeat[0]);
+
+	ASSERT(IsBasicColor(MR_BASIC_BLACK, 0.0, 0.0, 0.0));
+	ASSERT(IsBasicColor(MR_BASIC_BLUE, 0.0, 0.17, 0.76));
+	ASSERT(IsBasicColor(MR_BASIC_GREEN, 0.35, 0.8, 0.27));
+	ASSERT(IsBasicColor(MR_BASIC_YELLOW, 0.97, 0.97, 0.0));
+	ASSERT(IsBasicColor(MR_BASIC_ORANGE, 1.0, 0.53, 0.07));
+	ASSERT(IsBasicColor(MR_BASIC_RED, 0.99, 0.04, 0.04));
+	ASSERT(IsBasicColor(MR_BASIC_WHITE, 1.0, 1.0, 1.0));
+
+	if(mOverdraw == NULL) {
+		return;
+	}
+
+	const MR_UInt8 *lCount = mOverdraw;
+
+	for(int lY = 0; lY < mYRes; lY++) {
+		MR_UInt8 *lBuffer = mBufferLine[lY];
+
+		for(int lX = 0; lX < mXRes; lX++) {
+			int lLevel = *lCount++;
+
+			lBuffer[lX] = lHeat[(lLevel < lNbHeat) ? lLevel : (lNbHeat - 1)];
+		}
 	}
 }
 
@@ -42,6 +42,7 @@ namespace VideoServices {
 // define
 #define MR_BACK_X_RES 2048
 #define MR_BACK_Y_RES  256
+#define MR_COVERAGE_SPANS 4				  // Covered spans tracked per screen column
 
 // Helper class
 struct PositionMatrix
@@ -68,11 +69,17 @@ protected:
 	MR_Int32 mPlanHW;						  // Horizontal Half
 	MR_Int32 mPlanVW;						  // Vertical Half
 
-	MR_UInt16 *mZBuffer;
+	MR_UInt32 *mZBuffer;
 	int mZLineLen;
+	MR_UInt32 mZBase;						  // Generation bits of the current frame
+	BOOL mZGenerations;
+	BOOL mTiledTextures;					  // Sample walls and floors from the tiled layout
+	BOOL mActorBatching;					  // Transform actor frames once and cull their patches
+	int mPatchTested;
+	int mPatchCulled;
 
 	MR_UInt8 **mBufferLine;
-	MR_UInt16 **mZBufferLine;
+	MR_UInt32 **mZBufferLine;
 
 	// Usefull pre-defined constants
 	MR_Int32 mHVarPerDInc_16384;			  // Ray divergence by HPixel
@@ -85,15 +92,54 @@ protected:
 
 	BackColumn *mBackgroundConst;			  // Constants used to display each bitmap column
 
+	// Background cache
+	BOOL mBackgroundCache;
+	const MR_UInt8 *mBackgroundSource;		  // Bitmap that mBackgroundImage was copied from
+	MR_UInt32 mBackgroundGeneration;		  // Buffer background generation when it was copied
+	MR_UInt8 *mBackgroundImage;				  // Row-major copy of the background
+	MR_UInt8 *mBackgroundRows;				  // Source row of each pixel, mXRes by mBackgroundBottomLine
+	int mBackgroundStartingLine;			  // Horizon line of mBackgroundRows, -1 if not computed
+	int mBackgroundBottomLine;
+
+	// Wall coverage buffer
+	struct CoverageSpan
+	{
+		int mTop;								  // First covered line
+		int mBottom;							  // Last covered line + 1
+		MR_UInt16 mZ;							  // Farthest depth written in the span
+	};
+
+	struct CoverageColumn
+	{
+		int mNbSpan;
+		CoverageSpan mSpan[MR_COVERAGE_SPANS];
+	};
+
+	BOOL mWallCoverage;
+	CoverageColumn *mCoverage;				  // One per screen column
+	BOOL mCoverageUsed;						  // Some spans may be set
+	int mCoverageTested;
+	int mCoverageSkipped;
+
+	BOOL mOverdrawTracking;
+	MR_UInt8 *mOverdraw;					  // Wall pixel write count, mXRes by mYRes
+
 	MR_Int32 mRotationMatrix[3][3];
 
 	void ComputeRotationMatrix();
 	void ComputeBackgroundConst();
+	void RenderPatchTriangles(int pURes, int pVRes, const int * pNodeIndex, const Bitmap * pBitmap);
+	void ComputeBackgroundCache(const MR_UInt8 * pBitmap, int pStartingLine, int pBottomLine);
 
 	void ApplyRotationMatrix(const MR_3DCoordinate & pSrc, MR_3DCoordinate & pDest) const;
 	void ApplyRotationMatrix(const MR_2DCoordinate & pSrc, MR_2DCoordinate & pDest) const;
 	void ApplyPositionMatrix(const PositionMatrix & pMatrix, const MR_3DCoordinate & pSrc, MR_3DCoordinate & pDest) const;
 
+	void AllocCoverage();
+	void ResetCoverage();
+	BOOL IsColumnCovered(int pColumn, int pTop, int pBottom, MR_UInt16 pZ) const;
+	void AddColumnCoverage(int pColumn, int pTop, int pBottom, MR_UInt16 pZ);
+
 	MR_DllDeclare void OnMetricsChange(int pMetrics);
 
 public:
@@ -106,9 +152,36 @@ public:
 	MR_DllDeclare void SetupCameraPosition(const MR_3DCoordinate & pPosition, MR_Angle pOrientation, int pScroll);
 
 	MR_DllDeclare void ClearZ();
+	MR_DllDeclare void SetZGenerations(BOOL pEnabled);
+	BOOL GetZGenerations() const { return mZGenerations; }
+
+	MR_DllDeclare void SetTiledTextures(BOOL pEnabled);
+	BOOL GetTiledTextures() const { return mTiledTextures; }
+
+	// Batched actor rendering ( counters reset by ClearZ )
+	MR_DllDeclare void SetActorBatching(BOOL pEnabled);
+	BOOL GetActorBatching() const { return mActorBatching; }
+	int GetPatchTested() const { return mPatchTested; }
+	int GetPatchCulled() const { return mPatchCulled; }
 
 	MR_DllDeclare BOOL ComputePositionMatrix(PositionMatrix & pMatrix, const MR_3DCoordinate & pPosition, MR_Angle pOrientation, MR_Int32 pMaxObjRay);
 
+	MR_DllDeclare BOOL ComputeWallColumns(const MR_2DCoordinate & pP0, const MR_2DCoordinate & pP1, int & pLeft, int & pRight) const;
+	MR_DllDeclare BOOL IsSphereVisible(const MR_3DCoordinate & pCenter, MR_Int32 pRay) const;
+
+	// Wall overdraw reduction ( reset by ClearZ )
+	MR_DllDeclare void SetWallCoverage(BOOL pEnabled);
+	BOOL GetWallCoverage() const { return mWallCoverage; }
+	int GetCoverageTested() const { return mCoverageTested; }
+	int GetCoverageSkipped() const { return mCoverageSkipped; }
+
+	MR_DllDeclare void SetBackgroundCache(BOOL pEnabled);
+	BOOL GetBackgroundCache() const { return mBackgroundCache; }
+
+	MR_DllDeclare void SetOverdrawTracking(BOOL pEnabled);
+	BOOL GetOverdrawTracking() const { return mOverdrawTracking; }
+	MR_DllDeclare void RenderOverdraw();
+
 	// WireFrame services
 	MR_DllDeclare void DrawWFLine(const MR_3DCoordinate & pP0, const MR_3DCoordinate & pP1, MR_UInt8 pColor);
 
@@ -121,6 +194,9 @@ public:
 	MR_DllDeclare void RenderPatch(const Patch & pPatch, const PositionMatrix & pMatrix, const Bitmap * pBitmap);
 	MR_DllDeclare void RenderPatch(const Patch & pPatch, const PositionMatrix & pMatrix, MR_UInt8 pColor);
 
+	MR_DllDeclare void TransformVertices(const PositionMatrix & pMatrix, const MR_3DCoordinate * pVertexList, int pNbVertex);
+	MR_DllDeclare void RenderTransformedPatch(int pURes, int pVRes, const int * pNodeIndex, const Bitmap * pBitmap);
+
 	MR_DllDeclare void RenderBackground(const MR_UInt8 * pBitmap);
 };
 
@@ -20,6 +20,7 @@
 // and limitations under the License.
 //
 #include "Viewport3D.h"
+#include "VideoBuffer.h"
 
 // #pragma optimize( "atw", on )
 
@@ -38,23 +39,28 @@ struct MR_ColumnBltParam
 	int mYScreenEnd_4096;
 	int mBufferLen;
 	int mBufferStep;
-	MR_UInt16 **mZBuffer;
+	MR_UInt32 **mZBuffer;
 	int mZBufferStep;
-	MR_UInt16 mZ;
+	MR_UInt32 mZ;
 	MR_UInt8 *mBitmap;
 	int mPixelStep;
 	int mBitmapColMask;
+	int mBitmapRowShift;						  // Bitmap::TILE_SHIFT if mBitmap is tiled
 	MR_UInt8 mLightIntensity;
 	MR_UInt8 mColor;
+	MR_UInt8 *mOverdraw;						  // NULL if overdraw is not tracked
+	int mOverdrawStep;
 };
 
 struct MR_LineBltParam
 {
 	MR_UInt8 *mBuffer;
 	int mBltLen;
-	MR_UInt16 *mZBuffer;
-	MR_UInt16 mZ;
+	MR_UInt32 *mZBuffer;
+	MR_UInt32 mZ;
 	MR_UInt8 **mBitmap;
+	MR_UInt8 *mTiledBitmap;
+	int mBitmapYRes;
 	MR_UInt32 mBitmapColMask;
 	MR_UInt32 mBitmapRowMask;
 	MR_UInt32 mBitmapCol_4096;
@@ -73,8 +79,9 @@ struct MR_TriangleDrawInfo
 	int mXRes;
 	int mYRes;
 
-	MR_UInt16 **mZBuffer;
+	MR_UInt32 **mZBuffer;
 	int mZLineLen;
+	MR_UInt32 mZBase;
 
 	int mVertexList[3];
 	MR_Int32 mBitmapRow_4096[3];
@@ -99,9 +106,29 @@ static void BltColumn();
 
 static void BltPlainLineNoZCheck();
 static void BltLineNoZCheck();
+static void BltTiledLineNoZCheck();
 
 static void BltTriangle();
 
+/**
+ * Convert an interpolated triangle depth to a Z-buffer value.
+ * The depth is clamped to the 16 bits below the generation so that the
+ * depth test and the stored value always agree.
+ * @param pZ_4096 The depth, in 1/4096 units.
+ * @return The Z-buffer value for the current generation.
+ */
+static inline MR_UInt32 TriangleZ(int pZ_4096)
+{
+	int lDepth = pZ_4096 / (4096 * MR_ZBUFFER_UNIT);
+	if(lDepth < 0) {
+		lDepth = 0;
+	}
+	else if(lDepth > 0xFFFF) {
+		lDepth = 0xFFFF;
+	}
+	return gsTriangleBltParam.mZBase | static_cast<MR_UInt32>(lDepth);
+}
+
 // Local Macros
 
 //
@@ -282,6 +309,8 @@ void Viewport3D::RenderAlternateWallSurface(const MR_3DCoordinate & pUpperLeft,
 	gsColumnBltParam.mZBuffer = mZBufferLine;
 	gsColumnBltParam.mZBufferStep = mZLineLen;
 	gsColumnBltParam.mColor = pBitmap->GetPlainColor();
+	gsColumnBltParam.mOverdraw = mOverdraw;
+	gsColumnBltParam.mOverdrawStep = mXRes;
 
 	MR_Int32 lBitmapXRes_BitmapWidth = (lBitmapXRes * MR_PIXEL_FRACT) / pBitmap->GetWidth();
 	MR_Int32 lNbBitmapInHeight_4096 = ((pUpperLeft.mZ - pLowerRight.mZ) * 4096) / pBitmap->GetHeight();
@@ -333,9 +362,35 @@ void Viewport3D::RenderAlternateWallSurface(const MR_3DCoordinate & pUpperLeft,
 			gsColumnBltParam.mYScreenEnd_4096 = lYBottom_4096 + 2 * 4096;
 													//-(lDepth/256);
 			gsColumnBltParam.mLightIntensity = MR_NORMAL_INTENSITY;
-			gsColumnBltParam.mZ = (MR_UInt16) lDepth;
+			gsColumnBltParam.mZ = mZBase | (MR_UInt16) lDepth;
+
+			// Skip the column if nearer walls already hide all of it
+			BOOL lHidden = FALSE;
 
-			if(lSelectedBitmap == -1) {
+			if(mCoverage != NULL) {
+				// Same clipping as the Blt functions
+				int lLineTop = (lYTop_4096 < 0) ? 0 : lYTop_4096 / 4096;
+				int lLineBottom = gsColumnBltParam.mYScreenEnd_4096 / 4096;
+
+				if(lLineBottom > mYRes) {
+					lLineBottom = mYRes;
+				}
+
+				mCoverageTested++;
+
+				if(IsColumnCovered(lColumn, lLineTop, lLineBottom, (MR_UInt16) lDepth)) {
+					mCoverageSkipped++;
+					lHidden = TRUE;
+				}
+				else {
+					AddColumnCoverage(lColumn, lLineTop, lLineBottom, (MR_UInt16) lDepth);
+				}
+			}
+
+			if(lHidden) {
+				// Nothing to draw
+			}
+			else if(lSelectedBitmap == -1) {
 				BltPlainColumn();
 			}
 			else {
@@ -353,11 +408,16 @@ void Viewport3D::RenderAlternateWallSurface(const MR_3DCoordinate & pUpperLeft,
 
 				lBitmapColumn >>= pBitmap->GetXResShiftFactor(lSelectedBitmap);
 
-				if(pSerialStart == 0) {
-					gsColumnBltParam.mBitmap = pBitmap2->GetColumnBuffer(lSelectedBitmap, lBitmapColumn);
+				const Bitmap *lColumnBitmap = (pSerialStart == 0) ? pBitmap2 : pBitmap;
+				MR_UInt8 *lTiledBitmap = mTiledTextures ? lColumnBitmap->GetTiledBuffer(lSelectedBitmap) : NULL;
+
+				if(lTiledBitmap != NULL) {
+					gsColumnBltParam.mBitmap = lTiledBitmap + Bitmap::GetTiledColumnOffset(lBitmapColumn, lColumnBitmap->GetYRes(lSelectedBitmap));
+					gsColumnBltParam.mBitmapRowShift = Bitmap::TILE_SHIFT;
 				}
 				else {
-					gsColumnBltParam.mBitmap = pBitmap->GetColumnBuffer(lSelectedBitmap, lBitmapColumn);
+					gsColumnBltParam.mBitmap = lColumnBitmap->GetColumnBuffer(lSelectedBitmap, lBitmapColumn);
+					gsColumnBltParam.mBitmapRowShift = 0;
 				}
 
 				gsColumnBltParam.mPixelStep = (lNbBitmapInHeight_BitmapYRes * 64 / ((lYBottom_4096 - lYTop_4096) / 64)) >> pBitmap->GetYResShiftFactor(lSelectedBitmap);
@@ -379,12 +439,98 @@ void Viewport3D::RenderAlternateWallSurface(const MR_3DCoordinate & pUpperLeft,
 
 }
 
+/**
+ * Check if a wall column is hidden by the walls already drawn.
+ * Walls are opaque and the Z buffer only gets nearer once the floors are
+ * done, so the column can be skipped if a single covered span contains all
+ * its lines and everything in that span is nearer than the column.
+ * @param pColumn The screen column.
+ * @param pTop The first line of the wall column.
+ * @param pBottom The last line of the wall column + 1.
+ * @param pZ The depth of the wall column.
+ * @return @c TRUE if nothing of the column would pass the Z test.
+ */
+BOOL Viewport3D::IsColumnCovered(int pColumn, int pTop, int pBottom, MR_UInt16 pZ) const
+{
+	const CoverageColumn &lColumn = mCoverage[pColumn];
+
+	if(pTop >= pBottom) {
+		return TRUE;
+	}
+
+	for(int lCounter = 0; lCounter < lColumn.mNbSpan; lCounter++) {
+		const CoverageSpan &lSpan = lColumn.mSpan[lCounter];
+
+		if(lSpan.mTop > pTop) {
+			break;								  // Spans are sorted
+		}
+
+		if(lSpan.mBottom >= pBottom) {
+			return lSpan.mZ < pZ;
+		}
+	}
+	return FALSE;
+}
+
+/**
+ * Record that a wall column has been drawn.
+ * Touching spans are merged, keeping the farthest depth.  If the column is
+ * full, the span is simply forgotten; this only costs a missed skip later.
+ * @param pColumn The screen column.
+ * @param pTop The first line of the wall column.
+ * @param pBottom The last line of the wall column + 1.
+ * @param pZ The depth of the wall column.
+ */
+void Viewport3D::AddColumnCoverage(int pColumn, int pTop, int pBottom, MR_UInt16 pZ)
+{
+	CoverageColumn &lColumn = mCoverage[pColumn];
+	CoverageSpan lNew = { pTop, pBottom, pZ };
+	int lInsert = 0;
+	int lCounter = 0;
+	int lNbKept = 0;
+
+	if(pTop >= pBottom) {
+		return;
+	}
+
+	// Merge with the spans that touch the new one, compacting the others
+	for(; lCounter < lColumn.mNbSpan; lCounter++) {
+		const CoverageSpan &lSpan = lColumn.mSpan[lCounter];
+
+		if(lSpan.mBottom < lNew.mTop) {
+			lColumn.mSpan[lNbKept++] = lSpan;
+			lInsert = lNbKept;
+		}
+		else if(lSpan.mTop > lNew.mBottom) {
+			lColumn.mSpan[lNbKept++] = lSpan;
+		}
+		else {
+			lNew.mTop = std::min(lNew.mTop, lSpan.mTop);
+			lNew.mBottom = std::max(lNew.mBottom, lSpan.mBottom);
+			lNew.mZ = std::max(lNew.mZ, lSpan.mZ);
+		}
+	}
+
+	if(lNbKept == MR_COVERAGE_SPANS) {
+		return;
+	}
+
+	for(lCounter = lNbKept; lCounter > lInsert; lCounter--) {
+		lColumn.mSpan[lCounter] = lColumn.mSpan[lCounter - 1];
+	}
+	lColumn.mSpan[lInsert] = lNew;
+	lColumn.mNbSpan = lNbKept + 1;
+
+	mCoverageUsed = TRUE;
+}
+
 // Local functions implementation
 
 void BltPlainColumn()
 {
 	MR_UInt8 *lBuffer;
-	MR_UInt16 *lZBuffer;
+	MR_UInt32 *lZBuffer;
+	MR_UInt8 *lOverdraw = gsColumnBltParam.mOverdraw;
 	int lNbPoints;
 	MR_UInt8 lColor = gsColumnBltParam.mColor;
 
@@ -400,6 +546,10 @@ void BltPlainColumn()
 		lNbPoints = -gsColumnBltParam.mYScreenStart_4096 / 4096;
 	}
 
+	if(lOverdraw != NULL) {
+		lOverdraw += ((lNbPoints < 0) ? -lNbPoints : 0) * gsColumnBltParam.mOverdrawStep + gsColumnBltParam.mColumn;
+	}
+
 	if(gsColumnBltParam.mYScreenEnd_4096 / 4096 < gsColumnBltParam.mBufferLen) {
 		lNbPoints += gsColumnBltParam.mYScreenEnd_4096 / 4096;
 	}
@@ -411,10 +561,18 @@ void BltPlainColumn()
 		if(*lZBuffer >= gsColumnBltParam.mZ) {
 			*lBuffer = lColor;
 			*lZBuffer = gsColumnBltParam.mZ;
+
+			if(lOverdraw != NULL && *lOverdraw != 255) {
+				(*lOverdraw)++;
+			}
 		}
 
 		lBuffer += gsColumnBltParam.mBufferStep;
 		lZBuffer += gsColumnBltParam.mZBufferStep;
+
+		if(lOverdraw != NULL) {
+			lOverdraw += gsColumnBltParam.mOverdrawStep;
+		}
 	}
 }
 
@@ -422,7 +580,8 @@ void BltColumn()
 {
 
 	MR_UInt8 *lBuffer;
-	MR_UInt16 *lZBuffer;
+	MR_UInt32 *lZBuffer;
+	MR_UInt8 *lOverdraw = gsColumnBltParam.mOverdraw;
 	int lBitmapOffset;
 	int lNbPoints;
 
@@ -441,6 +600,10 @@ void BltColumn()
 
 	}
 
+	if(lOverdraw != NULL) {
+		lOverdraw += ((lNbPoints < 0) ? -lNbPoints : 0) * gsColumnBltParam.mOverdrawStep + gsColumnBltParam.mColumn;
+	}
+
 	if(gsColumnBltParam.mYScreenEnd_4096 / 4096 < gsColumnBltParam.mBufferLen) {
 		lNbPoints += gsColumnBltParam.mYScreenEnd_4096 / 4096;
 	}
@@ -450,13 +613,22 @@ void BltColumn()
 
 	for(int lCounter = 0; lCounter < lNbPoints; lCounter++) {
 		if(*lZBuffer >= gsColumnBltParam.mZ) {
-			*lBuffer = gsColumnBltParam.mBitmap[(lBitmapOffset / MR_PIXEL_FRACT) & (gsColumnBltParam.mBitmapColMask)];
+			// Same as Bitmap::GetTiledRowOffset when the bitmap is tiled.
+			*lBuffer = gsColumnBltParam.mBitmap[((lBitmapOffset / MR_PIXEL_FRACT) & (gsColumnBltParam.mBitmapColMask)) << gsColumnBltParam.mBitmapRowShift];
 			*lZBuffer = gsColumnBltParam.mZ;
+
+			if(lOverdraw != NULL && *lOverdraw != 255) {
+				(*lOverdraw)++;
+			}
 		}
 
 		lBuffer += gsColumnBltParam.mBufferStep;
 		lZBuffer += gsColumnBltParam.mZBufferStep;
 
+		if(lOverdraw != NULL) {
+			lOverdraw += gsColumnBltParam.mOverdrawStep;
+		}
+
 		lBitmapOffset += gsColumnBltParam.mPixelStep;
 	}
 }
@@ -467,6 +639,11 @@ void BltColumn()
 
 void Viewport3D::RenderHorizontalSurface(int pNbVertex, const MR_2DCoordinate * pVertexList, MR_Int32 pLevel, BOOL pTop, const Bitmap * pBitmap)
 {
+	// Floors overwrite the Z buffer without testing it, so anything the
+	// coverage buffer knows about the walls is no longer true
+	if(mCoverageUsed) {
+		ResetCoverage();
+	}
 
 	// Algorithme
 	// - Verify that we are on the visible side of the plane
@@ -848,7 +1025,7 @@ void Viewport3D::RenderHorizontalSurface(int pNbVertex, const MR_2DCoordinate *
 				MR_Int32 lBitmapRow0_4096 = -MulDiv(mPosition.mY, 4096 * pBitmap->GetMaxYRes(), pBitmap->GetHeight());
 
 				MR_UInt8 *lLineBuffer = mBufferLine[lCurrentLine];
-				MR_UInt16 *lZLineBuffer = mZBufferLine[lCurrentLine];
+				MR_UInt32 *lZLineBuffer = mZBufferLine[lCurrentLine];
 
 				MR_Int32 lPreviousDepth_8 = -1;
 
@@ -941,7 +1118,7 @@ void Viewport3D::RenderHorizontalSurface(int pNbVertex, const MR_2DCoordinate *
 							gsLineBltParam.mBuffer = lLineBuffer + lLeft;
 							gsLineBltParam.mBltLen = lRight - lLeft;
 							gsLineBltParam.mZBuffer = lZLineBuffer + lLeft;
-							gsLineBltParam.mZ = static_cast<MR_UInt16>(lDepth_8 / (8 * MR_ZBUFFER_UNIT));
+							gsLineBltParam.mZ = mZBase | static_cast<MR_UInt16>(lDepth_8 / (8 * MR_ZBUFFER_UNIT));
 
 							gsLineBltParam.mLightIntensity = MR_NORMAL_INTENSITY;
 
@@ -957,6 +1134,8 @@ void Viewport3D::RenderHorizontalSurface(int pNbVertex, const MR_2DCoordinate *
 								int lRowShift = pBitmap->GetYResShiftFactor(lSelectedBitmap);
 
 								gsLineBltParam.mBitmap = pBitmap->GetColumnBufferTable(lSelectedBitmap);
+								gsLineBltParam.mTiledBitmap = mTiledTextures ? pBitmap->GetTiledBuffer(lSelectedBitmap) : NULL;
+								gsLineBltParam.mBitmapYRes = pBitmap->GetYRes(lSelectedBitmap);
 								gsLineBltParam.mBitmapColMask =
 									static_cast<MR_UInt32>(pBitmap->GetXRes(lSelectedBitmap) - 1);
 								gsLineBltParam.mBitmapRowMask =
@@ -969,7 +1148,12 @@ void Viewport3D::RenderHorizontalSurface(int pNbVertex, const MR_2DCoordinate *
 								gsLineBltParam.mBitmapCol_4096 = scaleX * gsLineBltParam.mBitmapColInc_4096 + static_cast<MR_UInt32>(((lBitmapVColVariation_16384 * lDepth_8 / (4 * 8)) + lBitmapCol0_4096) >> lColShift);
 								gsLineBltParam.mBitmapRow_4096 = scaleX * gsLineBltParam.mBitmapRowInc_4096 + static_cast<MR_UInt32>(((lBitmapVRowVariation_16384 * lDepth_8 / (4 * 8)) + lBitmapRow0_4096) >> lRowShift);
 
-								BltLineNoZCheck();
+								if(gsLineBltParam.mTiledBitmap != NULL) {
+									BltTiledLineNoZCheck();
+								}
+								else {
+									BltLineNoZCheck();
+								}
 							}
 
 						}
@@ -1025,7 +1209,7 @@ void BltLineNoZCheck()
 {
 
 	MR_UInt8 *lBuffer = gsLineBltParam.mBuffer;
-	MR_UInt16 *lZBuffer = gsLineBltParam.mZBuffer;
+	MR_UInt32 *lZBuffer = gsLineBltParam.mZBuffer;
 
 	MR_UInt32 lColumn_4096 = gsLineBltParam.mBitmapCol_4096;
 	MR_UInt32 lRow_4096 = gsLineBltParam.mBitmapRow_4096;
@@ -1041,6 +1225,30 @@ void BltLineNoZCheck()
 	}
 }
 
+void BltTiledLineNoZCheck()
+{
+
+	MR_UInt8 *lBuffer = gsLineBltParam.mBuffer;
+	MR_UInt32 *lZBuffer = gsLineBltParam.mZBuffer;
+	const MR_UInt8 *lBitmap = gsLineBltParam.mTiledBitmap;
+	const int lYRes = gsLineBltParam.mBitmapYRes;
+
+	MR_UInt32 lColumn_4096 = gsLineBltParam.mBitmapCol_4096;
+	MR_UInt32 lRow_4096 = gsLineBltParam.mBitmapRow_4096;
+
+	for(int lCounter = 0; lCounter < gsLineBltParam.mBltLen; lCounter++) {
+
+		*(lBuffer++) = lBitmap[Bitmap::GetTiledOffset(
+			static_cast<int>((lColumn_4096 / 4096) & gsLineBltParam.mBitmapColMask),
+			static_cast<int>((lRow_4096 / 4096) & gsLineBltParam.mBitmapRowMask),
+			lYRes)];
+		*(lZBuffer++) = gsLineBltParam.mZ;
+
+		lColumn_4096 += gsLineBltParam.mBitmapColInc_4096;
+		lRow_4096 += gsLineBltParam.mBitmapRowInc_4096;
+	}
+}
+
 //
 // Patch section
 //
@@ -1055,23 +1263,65 @@ void BltLineNoZCheck()
 #define ON_FRONT   16
 #define ON_BACK    32
 
+// Transformed vertices, shared by all the patches of the frame being drawn.
+// They are kept as separate arrays so that the transform loops only walk
+// contiguous integers and can be vectorized by the compiler.
+static std::vector<MR_Int32> gsVertexBuffer;
+static int gsNbVertexAlloc = 0;
+static MR_Int32 *gsVertexDepth = NULL;		  // Camera X (distance to the camera plane)
+static MR_Int32 *gsVertexY = NULL;
+static MR_Int32 *gsVertexZ = NULL;
+static MR_Int32 *gsScreenXPatch = NULL;
+static MR_Int32 *gsScreenYPatch = NULL;
+static MR_Int32 *gsScreenVisibility = NULL;	  // ON_SCREEN, ON_FRONT or ON_BACK
+static MR_Int32 *gsScreenOutcode = NULL;	  // ON_LEFT, ON_RIGHT, ON_TOP and ON_BOTTOM bits
+
 static MR_3DCoordinate gsRotatedPatch[MAX_PATCH_RES * MAX_PATCH_RES];
-static int gsScreenXPatch[MAX_PATCH_RES * MAX_PATCH_RES];
-static int gsScreenYPatch[MAX_PATCH_RES * MAX_PATCH_RES];
-static int gsScreenVisibility[MAX_PATCH_RES * MAX_PATCH_RES];
+static int gsIdentityIndex[MAX_PATCH_RES * MAX_PATCH_RES];
 
-void Viewport3D::RenderPatch(const Patch & pPatch, const PositionMatrix & pMatrix, const Bitmap * pBitmap)
+static void AllocVertexBuffer(int pNbVertex)
 {
+	if(pNbVertex > gsNbVertexAlloc) {
+		gsNbVertexAlloc = std::max(pNbVertex, MAX_PATCH_RES * MAX_PATCH_RES);
+		gsVertexBuffer.resize(static_cast<size_t>(gsNbVertexAlloc) * 7);
+
+		MR_Int32 *lBuffer = gsVertexBuffer.data();
+		gsVertexDepth = lBuffer;
+		gsVertexY = gsVertexDepth + gsNbVertexAlloc;
+		gsVertexZ = gsVertexY + gsNbVertexAlloc;
+		gsScreenXPatch = gsVertexZ + gsNbVertexAlloc;
+		gsScreenYPatch = gsScreenXPatch + gsNbVertexAlloc;
+		gsScreenVisibility = gsScreenYPatch + gsNbVertexAlloc;
+		gsScreenOutcode = gsScreenVisibility + gsNbVertexAlloc;
+	}
+}
 
-	int lCounter;
+void Viewport3D::RenderPatch(const Patch & pPatch, const PositionMatrix & pMatrix, const Bitmap * pBitmap)
+{
 	int lURes = pPatch.GetURes();
 	int lVRes = pPatch.GetVRes();
 
+	ASSERT(lURes * lVRes <= MAX_PATCH_RES * MAX_PATCH_RES);
+
+	if(gsIdentityIndex[1] == 0) {
+		for(int lCounter = 0; lCounter < MAX_PATCH_RES * MAX_PATCH_RES; lCounter++) {
+			gsIdentityIndex[lCounter] = lCounter;
+		}
+	}
+
+	if(mActorBatching) {
+		TransformVertices(pMatrix, pPatch.GetNodeList(), lURes * lVRes);
+		RenderTransformedPatch(lURes, lVRes, gsIdentityIndex, pBitmap);
+		return;
+	}
+
 	int lNbNodes = lURes * lVRes;
 
 	const MR_3DCoordinate *lNodeList = pPatch.GetNodeList();
 
-	for(lCounter = 0; lCounter < lNbNodes; lCounter++) {
+	AllocVertexBuffer(lNbNodes);
+
+	for(int lCounter = 0; lCounter < lNbNodes; lCounter++) {
 		// Rotate each vertex of the patch
 
 		ApplyPositionMatrix(pMatrix, lNodeList[lCounter], gsRotatedPatch[lCounter]);
@@ -1091,6 +1341,184 @@ void Viewport3D::RenderPatch(const Patch & pPatch, const PositionMatrix & pMatri
 		}
 	}
 
+	RenderPatchTriangles(lURes, lVRes, gsIdentityIndex, pBitmap);
+}
+
+/**
+ * Transform a list of vertices to the camera and screen space.
+ * The result is kept until the next call and is used by
+ * RenderTransformedPatch, so all the patches of an actor frame can share
+ * the same transformed vertices instead of each transforming its own nodes.
+ * @param pMatrix The position of the object.
+ * @param pVertexList The vertices, in object space.
+ * @param pNbVertex The number of vertices.
+ */
+void Viewport3D::TransformVertices(const PositionMatrix & pMatrix, const MR_3DCoordinate * pVertexList, int pNbVertex)
+{
+	int lCounter;
+
+	AllocVertexBuffer(pNbVertex);
+
+	// The arithmetic is the same as ApplyPositionMatrix, one step at a time
+	// over the whole list
+	const MR_Int32 lObj00 = pMatrix.mRotation[0][0];
+	const MR_Int32 lObj01 = pMatrix.mRotation[0][1];
+	const MR_Int32 lObj10 = pMatrix.mRotation[1][0];
+	const MR_Int32 lObj11 = pMatrix.mRotation[1][1];
+	const MR_Int32 lDispX = pMatrix.mDisplacement.mX - mPosition.mX;
+	const MR_Int32 lDispY = pMatrix.mDisplacement.mY - mPosition.mY;
+	const MR_Int32 lDispZ = pMatrix.mDisplacement.mZ - mPosition.mZ;
+
+	MR_Int32 *lDepth = gsVertexDepth;
+	MR_Int32 *lY = gsVertexY;
+	MR_Int32 *lZ = gsVertexZ;
+
+	for(lCounter = 0; lCounter < pNbVertex; lCounter++) {
+		lDepth[lCounter] = (MR_Int32) Int64ShraMod32(Int32x32To64(pVertexList[lCounter].mX, lObj00) + Int32x32To64(pVertexList[lCounter].mY, lObj01), MR_TRIGO_SHIFT) + lDispX;
+		lY[lCounter] = (MR_Int32) Int64ShraMod32(Int32x32To64(pVertexList[lCounter].mX, lObj10) + Int32x32To64(pVertexList[lCounter].mY, lObj11), MR_TRIGO_SHIFT) + lDispY;
+		lZ[lCounter] = pVertexList[lCounter].mZ + lDispZ;
+	}
+
+	const MR_Int32 lCam00 = mRotationMatrix[0][0];
+	const MR_Int32 lCam01 = mRotationMatrix[0][1];
+	const MR_Int32 lCam10 = mRotationMatrix[1][0];
+	const MR_Int32 lCam11 = mRotationMatrix[1][1];
+
+	for(lCounter = 0; lCounter < pNbVertex; lCounter++) {
+		MR_Int32 lX = lDepth[lCounter];
+
+		lDepth[lCounter] = (MR_Int32) Int64ShraMod32(Int32x32To64(lX, lCam00) + Int32x32To64(lY[lCounter], lCam01), MR_TRIGO_SHIFT);
+		lY[lCounter] = (MR_Int32) Int64ShraMod32(Int32x32To64(lX, lCam10) + Int32x32To64(lY[lCounter], lCam11), MR_TRIGO_SHIFT);
+	}
+
+	// Compute the screen coordinate of the vertices
+	for(lCounter = 0; lCounter < pNbVertex; lCounter++) {
+		if(lDepth[lCounter] < mPlanDist / 2) {
+			gsScreenVisibility[lCounter] = ON_FRONT;
+			gsScreenOutcode[lCounter] = 0;
+		}
+		else if(lDepth[lCounter] / MR_ZBUFFER_UNIT > MR_ZBUFFER_LIMIT) {
+			gsScreenVisibility[lCounter] = ON_BACK;
+			gsScreenOutcode[lCounter] = 0;
+		}
+		else {
+			int lScreenX = MulDiv(-lY[lCounter], mXRes_PlanDist, lDepth[lCounter] * mPlanHW * 2) + mXRes / 2;
+			int lScreenY = -MulDiv(lZ[lCounter], mYRes_PlanDist, lDepth[lCounter] * mPlanVW * 2) + mYRes / 2 + mScroll;
+
+			gsScreenXPatch[lCounter] = lScreenX;
+			gsScreenYPatch[lCounter] = lScreenY;
+			gsScreenVisibility[lCounter] = ON_SCREEN;
+			gsScreenOutcode[lCounter] =
+				((lScreenX < 0) ? ON_LEFT : 0) |
+				((lScreenX > mXRes) ? ON_RIGHT : 0) |
+				((lScreenY < 0) ? ON_TOP : 0) |
+				((lScreenY > mYRes) ? ON_BOTTOM : 0);
+		}
+	}
+}
+
+/**
+ * Check if a triangle of transformed vertices is surely facing away.
+ * Only the triangles that BltTriangle would reject because of their
+ * orientation are reported; nearly degenerate triangles are left to it.
+ */
+static BOOL IsTriangleBackFacing(int pV0, int pV1, int pV2)
+{
+	MR_Int64 lDX1 = gsScreenXPatch[pV1] - gsScreenXPatch[pV0];
+	MR_Int64 lDY1 = gsScreenYPatch[pV1] - gsScreenYPatch[pV0];
+	MR_Int64 lDX2 = gsScreenXPatch[pV2] - gsScreenXPatch[pV0];
+	MR_Int64 lDY2 = gsScreenYPatch[pV2] - gsScreenYPatch[pV0];
+
+	MR_Int64 lCross = lDX1 * lDY2 - lDY1 * lDX2;
+
+	// The slopes compared by BltTriangle are rounded to 1/4096 and their
+	// edges can be up to twice as tall as these two, so keep a margin
+	MR_Int64 lDY = std::max(std::max(lDY1 < 0 ? -lDY1 : lDY1, lDY2 < 0 ? -lDY2 : lDY2), static_cast<MR_Int64>(1));
+	return (lCross * 4096 < -8 * lDY * lDY) ? TRUE : FALSE;
+}
+
+/**
+ * Render a patch whose nodes have been transformed by TransformVertices.
+ * When actor batching is enabled, the whole patch is rejected first if
+ * all its visible nodes are outside the same edge of the screen, or if
+ * all its drawable triangles face away from the camera.
+ * @param pURes The number of nodes along U.
+ * @param pVRes The number of nodes along V.
+ * @param pNodeIndex For each node of the patch, its index in the
+ *                   transformed vertex list.
+ * @param pBitmap The texture.
+ */
+void Viewport3D::RenderTransformedPatch(int pURes, int pVRes, const int * pNodeIndex, const Bitmap * pBitmap)
+{
+	int lCounter;
+	int lNbNodes = pURes * pVRes;
+
+	if(mActorBatching) {
+		mPatchTested++;
+
+		// Off-screen test
+		int lOutcode = ON_LEFT | ON_RIGHT | ON_TOP | ON_BOTTOM;
+		BOOL lAnyOnScreen = FALSE;
+
+		for(lCounter = 0; lCounter < lNbNodes; lCounter++) {
+			int lNode = pNodeIndex[lCounter];
+
+			if(gsScreenVisibility[lNode] == ON_SCREEN) {
+				lOutcode &= gsScreenOutcode[lNode];
+				lAnyOnScreen = TRUE;
+			}
+		}
+
+		// Back-facing test
+		BOOL lFrontFacing = FALSE;
+
+		if(lAnyOnScreen && lOutcode == 0) {
+			lCounter = 0;
+
+			for(int lV = 0; lV < (pVRes - 1) && !lFrontFacing; lV++) {
+				for(int lU = 0; lU < (pURes - 1); lU++) {
+					int lN0 = pNodeIndex[lCounter];
+					int lN1 = pNodeIndex[lCounter + 1];
+					int lN2 = pNodeIndex[lCounter + pURes];
+					int lN3 = pNodeIndex[lCounter + pURes + 1];
+
+					if((gsScreenVisibility[lN1] == ON_SCREEN) && (gsScreenVisibility[lN2] == ON_SCREEN)) {
+						if((gsScreenVisibility[lN0] == ON_SCREEN) && !IsTriangleBackFacing(lN0, lN1, lN2)) {
+							lFrontFacing = TRUE;
+							break;
+						}
+						if((gsScreenVisibility[lN3] == ON_SCREEN) && !IsTriangleBackFacing(lN1, lN3, lN2)) {
+							lFrontFacing = TRUE;
+							break;
+						}
+					}
+					lCounter++;
+				}
+				lCounter++;
+			}
+		}
+
+		if(!lFrontFacing) {
+			mPatchCulled++;
+			return;
+		}
+	}
+
+	RenderPatchTriangles(pURes, pVRes, pNodeIndex, pBitmap);
+}
+
+/**
+ * Draw the triangles of a patch whose nodes have been projected.
+ * @param pURes The number of nodes along U.
+ * @param pVRes The number of nodes along V.
+ * @param pNodeIndex For each node of the patch, its index in the
+ *                   projected vertex list.
+ * @param pBitmap The texture.
+ */
+void Viewport3D::RenderPatchTriangles(int pURes, int pVRes, const int * pNodeIndex, const Bitmap * pBitmap)
+{
+	int lCounter;
+
 	// render each triangle of the patch
 	int lBitmapXRes = pBitmap->GetMaxXRes();
 	int lBitmapYRes = pBitmap->GetMaxYRes();
@@ -1113,27 +1541,33 @@ void Viewport3D::RenderPatch(const Patch & pPatch, const PositionMatrix & pMatri
 	gsTriangleBltParam.mYRes = mYRes;
 
 	gsTriangleBltParam.mZBuffer = mZBufferLine;
+	gsTriangleBltParam.mZBase = mZBase;
 	gsTriangleBltParam.mZLineLen = mZLineLen;
 
-	MR_Int32 lBitmapRowInc_4096 = lBitmapXRes * 4096 / (lVRes - 1);
-	MR_Int32 lBitmapColInc_4096 = lBitmapYRes * 4096 / (lURes - 1);
+	MR_Int32 lBitmapRowInc_4096 = lBitmapXRes * 4096 / (pVRes - 1);
+	MR_Int32 lBitmapColInc_4096 = lBitmapYRes * 4096 / (pURes - 1);
 
 	MR_Int32 lBitmapRow_4096_0 = 0;
 	MR_Int32 lBitmapRow_4096_1 = lBitmapRowInc_4096;
 
 	lCounter = 0;
 
-	for(int lV = 0; lV < (lVRes - 1); lV++) {
+	for(int lV = 0; lV < (pVRes - 1); lV++) {
 
 		MR_Int32 lBitmapCol_4096_0 = 0;
 		MR_Int32 lBitmapCol_4096_1 = lBitmapColInc_4096;
 
-		for(int lU = 0; lU < (lURes - 1); lU++) {
-			if((gsScreenVisibility[lCounter + 1] == ON_SCREEN) && (gsScreenVisibility[lCounter + lURes] == ON_SCREEN)) {
-				if(gsScreenVisibility[lCounter] == ON_SCREEN) {
-					gsTriangleBltParam.mVertexList[0] = lCounter;
-					gsTriangleBltParam.mVertexList[1] = lCounter + 1;
-					gsTriangleBltParam.mVertexList[2] = lCounter + lURes;
+		for(int lU = 0; lU < (pURes - 1); lU++) {
+			int lN0 = pNodeIndex[lCounter];
+			int lN1 = pNodeIndex[lCounter + 1];
+			int lN2 = pNodeIndex[lCounter + pURes];
+			int lN3 = pNodeIndex[lCounter + pURes + 1];
+
+			if((gsScreenVisibility[lN1] == ON_SCREEN) && (gsScreenVisibility[lN2] == ON_SCREEN)) {
+				if(gsScreenVisibility[lN0] == ON_SCREEN) {
+					gsTriangleBltParam.mVertexList[0] = lN0;
+					gsTriangleBltParam.mVertexList[1] = lN1;
+					gsTriangleBltParam.mVertexList[2] = lN2;
 
 					gsTriangleBltParam.mBitmapCol_4096[0] = lBitmapCol_4096_0;
 					gsTriangleBltParam.mBitmapCol_4096[1] = lBitmapCol_4096_1;
@@ -1147,10 +1581,10 @@ void Viewport3D::RenderPatch(const Patch & pPatch, const PositionMatrix & pMatri
 
 				}
 
-				if(gsScreenVisibility[lCounter + lURes + 1] == ON_SCREEN) {
-					gsTriangleBltParam.mVertexList[0] = lCounter + 1;
-					gsTriangleBltParam.mVertexList[1] = lCounter + lURes + 1;
-					gsTriangleBltParam.mVertexList[2] = lCounter + lURes;
+				if(gsScreenVisibility[lN3] == ON_SCREEN) {
+					gsTriangleBltParam.mVertexList[0] = lN1;
+					gsTriangleBltParam.mVertexList[1] = lN3;
+					gsTriangleBltParam.mVertexList[2] = lN2;
 
 					gsTriangleBltParam.mBitmapCol_4096[0] = lBitmapCol_4096_1;
 					gsTriangleBltParam.mBitmapCol_4096[1] = lBitmapCol_4096_1;
@@ -1359,7 +1793,7 @@ void BltTriangle()
 		+ (gsTriangleBltParam.mBitmapRow_4096[lBottom] - gsTriangleBltParam.mBitmapRow_4096[lTop])
 		* (lMiddleLine - lTopLine) / (lBottomLine - lTopLine);
 
-	int lZOnMiddle = gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX * 4096 + (gsRotatedPatch[gsTriangleBltParam.mVertexList[lBottom]].mX - gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX) * 4096 * (lMiddleLine - lTopLine) / (lBottomLine - lTopLine);
+	int lZOnMiddle = gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]] * 4096 + (gsVertexDepth[gsTriangleBltParam.mVertexList[lBottom]] - gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]]) * 4096 * (lMiddleLine - lTopLine) / (lBottomLine - lTopLine);
 
 	int lXOnMiddle = gsScreenXPatch[gsTriangleBltParam.mVertexList[lTop]] * 4096 + (gsScreenXPatch[gsTriangleBltParam.mVertexList[lBottom]] - gsScreenXPatch[gsTriangleBltParam.mVertexList[lTop]]) * 4096 * (lMiddleLine - lTopLine) / (lBottomLine - lTopLine);
 
@@ -1372,12 +1806,12 @@ void BltTriangle()
 
 	lDU_PerPixel_4096 = (gsTriangleBltParam.mBitmapCol_4096[lMiddle] - lUOnMiddle) * 4 / (lOnMiddleLen / 1024);
 	lDV_PerPixel_4096 = (gsTriangleBltParam.mBitmapRow_4096[lMiddle] - lVOnMiddle) * 4 / (lOnMiddleLen / 1024);
-	lDZ_PerPixel_4096 = (gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX * 4096 - lZOnMiddle) * 64 / (lOnMiddleLen / 64);
+	lDZ_PerPixel_4096 = (gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]] * 4096 - lZOnMiddle) * 64 / (lOnMiddleLen / 64);
 
 	if(lMiddleShouldBeOnRight) {
 		lDU_PerLine_4096 = (gsTriangleBltParam.mBitmapCol_4096[lBottom] - gsTriangleBltParam.mBitmapCol_4096[lTop]) / (lBottomLine - lTopLine);
 		lDV_PerLine_4096 = (gsTriangleBltParam.mBitmapRow_4096[lBottom] - gsTriangleBltParam.mBitmapRow_4096[lTop]) / (lBottomLine - lTopLine);
-		lDZ_PerLine_4096 = (gsRotatedPatch[gsTriangleBltParam.mVertexList[lBottom]].mX - gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX) * 4096 / (lBottomLine - lTopLine);
+		lDZ_PerLine_4096 = (gsVertexDepth[gsTriangleBltParam.mVertexList[lBottom]] - gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]]) * 4096 / (lBottomLine - lTopLine);
 	}
 	else {
 		// Can not be calculated now
@@ -1386,7 +1820,7 @@ void BltTriangle()
 	// Draw each line of the model
 	int lCurrentLine;
 	MR_UInt8 *lLineBuffer;
-	MR_UInt16 *lLineZBuffer;
+	MR_UInt32 *lLineZBuffer;
 
 	int lXLeft_4096;
 	int lXRight_4096;
@@ -1415,12 +1849,12 @@ void BltTriangle()
 
 				lU_4096 = gsTriangleBltParam.mBitmapCol_4096[lTop];
 				lV_4096 = gsTriangleBltParam.mBitmapRow_4096[lTop];
-				lZ_4096 = gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX * 4096;
+				lZ_4096 = gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]] * 4096;
 
 				if(!lMiddleShouldBeOnRight) {
 					lDU_PerLine_4096 = (gsTriangleBltParam.mBitmapCol_4096[lMiddle] - gsTriangleBltParam.mBitmapCol_4096[lTop]) / (lMiddleLine - lTopLine);
 					lDV_PerLine_4096 = (gsTriangleBltParam.mBitmapRow_4096[lMiddle] - gsTriangleBltParam.mBitmapRow_4096[lTop]) / (lMiddleLine - lTopLine);
-					lDZ_PerLine_4096 = (gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX - gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX) * 4096 / (lMiddleLine - lTopLine);
+					lDZ_PerLine_4096 = (gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]] - gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]]) * 4096 / (lMiddleLine - lTopLine);
 				}
 
 				if(lCurrentLine < 0) {
@@ -1460,10 +1894,11 @@ void BltTriangle()
 						}
 
 						while(lXLeft < lXRight) {
-							if(lLineZBuffer[lXLeft] >= lLocalZ_4096 / (4096 * MR_ZBUFFER_UNIT)) {
+							const MR_UInt32 lZ = TriangleZ(lLocalZ_4096);
+							if(lLineZBuffer[lXLeft] >= lZ) {
 								MR_UInt32 scaledU = static_cast<MR_UInt32>(lLocalU_4096 / 4096);
 								MR_UInt32 scaledV = static_cast<MR_UInt32>(lLocalV_4096 / 4096);
-								lLineZBuffer[lXLeft] = static_cast<MR_UInt16>(lLocalZ_4096 / (4096 * MR_ZBUFFER_UNIT));
+								lLineZBuffer[lXLeft] = lZ;
 								lLineBuffer[lXLeft] = gsTriangleBltParam.mBitmap[scaledU & gsTriangleBltParam.mBitmapColMask]
 									[scaledV & gsTriangleBltParam.mBitmapRowMask];
 							}
@@ -1496,11 +1931,11 @@ void BltTriangle()
 					if(!lMiddleShouldBeOnRight) {
 						lU_4096 = gsTriangleBltParam.mBitmapCol_4096[lMiddle];
 						lV_4096 = gsTriangleBltParam.mBitmapRow_4096[lMiddle];
-						lZ_4096 = gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX * 4096;
+						lZ_4096 = gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]] * 4096;
 
 						lDU_PerLine_4096 = (gsTriangleBltParam.mBitmapCol_4096[lBottom] - gsTriangleBltParam.mBitmapCol_4096[lMiddle]) / (lBottomLine - lMiddleLine);
 						lDV_PerLine_4096 = (gsTriangleBltParam.mBitmapRow_4096[lBottom] - gsTriangleBltParam.mBitmapRow_4096[lMiddle]) / (lBottomLine - lMiddleLine);
-						lDZ_PerLine_4096 = (gsRotatedPatch[gsTriangleBltParam.mVertexList[lBottom]].mX - gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX) * 4096 / (lBottomLine - lMiddleLine);
+						lDZ_PerLine_4096 = (gsVertexDepth[gsTriangleBltParam.mVertexList[lBottom]] - gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]]) * 4096 / (lBottomLine - lMiddleLine);
 					}
 
 					if(lMiddleShouldBeOnRight) {
@@ -1523,17 +1958,17 @@ void BltTriangle()
 					if(lMiddleShouldBeOnRight) {
 						lU_4096 = gsTriangleBltParam.mBitmapCol_4096[lTop];
 						lV_4096 = gsTriangleBltParam.mBitmapRow_4096[lTop];
-						lZ_4096 = gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX * 4096;
+						lZ_4096 = gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]] * 4096;
 
 					}
 					else {
 						lU_4096 = gsTriangleBltParam.mBitmapCol_4096[lMiddle];
 						lV_4096 = gsTriangleBltParam.mBitmapRow_4096[lMiddle];
-						lZ_4096 = gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX * 4096;
+						lZ_4096 = gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]] * 4096;
 
 						lDU_PerLine_4096 = (gsTriangleBltParam.mBitmapCol_4096[lBottom] - gsTriangleBltParam.mBitmapCol_4096[lMiddle]) / (lBottomLine - lMiddleLine);
 						lDV_PerLine_4096 = (gsTriangleBltParam.mBitmapRow_4096[lBottom] - gsTriangleBltParam.mBitmapRow_4096[lMiddle]) / (lBottomLine - lMiddleLine);
-						lDZ_PerLine_4096 = (gsRotatedPatch[gsTriangleBltParam.mVertexList[lBottom]].mX - gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX) * 4096 / (lBottomLine - lMiddleLine);
+						lDZ_PerLine_4096 = (gsVertexDepth[gsTriangleBltParam.mVertexList[lBottom]] - gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]]) * 4096 / (lBottomLine - lMiddleLine);
 					}
 
 					if(lMiddleShouldBeOnRight) {
@@ -1558,7 +1993,7 @@ void BltTriangle()
 			if(lMiddleShouldBeOnRight) {
 				lU_4096 = gsTriangleBltParam.mBitmapCol_4096[lTop];
 				lV_4096 = gsTriangleBltParam.mBitmapRow_4096[lTop];
-				lZ_4096 = gsRotatedPatch[gsTriangleBltParam.mVertexList[lTop]].mX * 4096;
+				lZ_4096 = gsVertexDepth[gsTriangleBltParam.mVertexList[lTop]] * 4096;
 
 				lU_4096 += -lTopLine * lDU_PerLine_4096;
 				lV_4096 += -lTopLine * lDV_PerLine_4096;
@@ -1568,11 +2003,11 @@ void BltTriangle()
 			else {
 				lU_4096 = gsTriangleBltParam.mBitmapCol_4096[lMiddle];
 				lV_4096 = gsTriangleBltParam.mBitmapRow_4096[lMiddle];
-				lZ_4096 = gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX * 4096;
+				lZ_4096 = gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]] * 4096;
 
 				lDU_PerLine_4096 = (gsTriangleBltParam.mBitmapCol_4096[lBottom] - gsTriangleBltParam.mBitmapCol_4096[lMiddle]) / (lBottomLine - lMiddleLine);
 				lDV_PerLine_4096 = (gsTriangleBltParam.mBitmapRow_4096[lBottom] - gsTriangleBltParam.mBitmapRow_4096[lMiddle]) / (lBottomLine - lMiddleLine);
-				lDZ_PerLine_4096 = (gsRotatedPatch[gsTriangleBltParam.mVertexList[lBottom]].mX - gsRotatedPatch[gsTriangleBltParam.mVertexList[lMiddle]].mX) * 4096 / (lBottomLine - lMiddleLine);
+				lDZ_PerLine_4096 = (gsVertexDepth[gsTriangleBltParam.mVertexList[lBottom]] - gsVertexDepth[gsTriangleBltParam.mVertexList[lMiddle]]) * 4096 / (lBottomLine - lMiddleLine);
 
 				lU_4096 += -lMiddleLine * lDU_PerLine_4096;
 				lV_4096 += -lMiddleLine * lDV_PerLine_4096;
@@ -1626,10 +2061,11 @@ void BltTriangle()
 				}
 
 				while(lXLeft < lXRight) {
-					if(lLineZBuffer[lXLeft] >= lLocalZ_4096 / (4096 * MR_ZBUFFER_UNIT)) {
+					const MR_UInt32 lZ = TriangleZ(lLocalZ_4096);
+					if(lLineZBuffer[lXLeft] >= lZ) {
 						MR_UInt32 scaledU = static_cast<MR_UInt32>(lLocalU_4096 / 4096);
 						MR_UInt32 scaledV = static_cast<MR_UInt32>(lLocalV_4096 / 4096);
-						lLineZBuffer[lXLeft] = static_cast<MR_UInt16>(lLocalZ_4096 / (4096 * MR_ZBUFFER_UNIT));
+						lLineZBuffer[lXLeft] = lZ;
 						lLineBuffer[lXLeft] = gsTriangleBltParam.mBitmap[scaledU & gsTriangleBltParam.mBitmapColMask]
 							[scaledV & gsTriangleBltParam.mBitmapRowMask];
 					}
@@ -1678,6 +2114,28 @@ void Viewport3D::RenderBackground(const MR_UInt8 * pBitmap)
 		return;
 	}
 
+	if(mBackgroundCache) {
+		if((pBitmap != mBackgroundSource) || (mBackgroundGeneration != mVideoBuffer->GetBackgroundGeneration()) || (lStartingLine != mBackgroundStartingLine) || (lBottomLine != mBackgroundBottomLine)) {
+			ComputeBackgroundCache(pBitmap, lStartingLine, lBottomLine);
+		}
+
+		// Only the horizontal position depends on the orientation
+		int lBitmapColumnBase = MR_BACK_X_RES + ((MR_PI / 2 - mOrientation) * MR_BACK_X_RES / MR_2PI);
+
+		int lRowCount = (lBottomLine > lStartingLine) ? lBottomLine : (lStartingLine + 1);
+
+		for(int lRow = 0; lRow < lRowCount; lRow++) {
+			MR_UInt8 *lDest = mBufferLine[lRow];
+			const MR_UInt8 *lSrcRow = mBackgroundRows + lRow * mXRes;
+
+			for(int lColumn = 0; lColumn < mXRes; lColumn++) {
+				int lBitmapColumn = (lBitmapColumnBase + mBackgroundConst[lColumn].mBitmapColumn) & (MR_BACK_X_RES - 1);
+				lDest[lColumn] = mBackgroundImage[lSrcRow[lColumn] * MR_BACK_X_RES + lBitmapColumn];
+			}
+		}
+		return;
+	}
+
 	for(int lColumn = 0; lColumn < mXRes; lColumn++) {
 		int lRow;
 		int lBitmapColumn = (MR_BACK_X_RES + ((MR_PI / 2 - mOrientation) * MR_BACK_X_RES / MR_2PI) + mBackgroundConst[lColumn].mBitmapColumn) & (MR_BACK_X_RES - 1);
@@ -1707,5 +2165,63 @@ void Viewport3D::RenderBackground(const MR_UInt8 * pBitmap)
 	}
 }
 
+/**
+ * Prepare the background cache used by RenderBackground.
+ * The background bitmap is stored column by column, and each screen column
+ * is scaled differently, so the cache keeps a row-major copy of the bitmap
+ * and the bitmap row sampled by each pixel, computed the same way as the
+ * uncached rendering.
+ * @param pBitmap The background bitmap.
+ * @param pStartingLine The horizon line.
+ * @param pBottomLine The first line below the background.
+ */
+void Viewport3D::ComputeBackgroundCache(const MR_UInt8 * pBitmap, int pStartingLine, int pBottomLine)
+{
+	MR_UInt32 lGeneration = mVideoBuffer->GetBackgroundGeneration();
+
+	if((pBitmap != mBackgroundSource) || (lGeneration != mBackgroundGeneration)) {
+		if(mBackgroundImage == NULL) {
+			mBackgroundImage = new MR_UInt8[MR_BACK_X_RES * MR_BACK_Y_RES];
+		}
+
+		for(int lColumn = 0; lColumn < MR_BACK_X_RES; lColumn++) {
+			for(int lRow = 0; lRow < MR_BACK_Y_RES; lRow++) {
+				mBackgroundImage[lRow * MR_BACK_X_RES + lColumn] = pBitmap[lColumn * MR_BACK_Y_RES + lRow];
+			}
+		}
+		mBackgroundSource = pBitmap;
+		mBackgroundGeneration = lGeneration;
+	}
+
+	if((pStartingLine != mBackgroundStartingLine) || (pBottomLine != mBackgroundBottomLine) || (mBackgroundRows == NULL)) {
+		// The horizon line may be below the bottom line when looking up
+		int lRowCount = (pBottomLine > pStartingLine) ? pBottomLine : (pStartingLine + 1);
+
+		delete[]mBackgroundRows;
+		mBackgroundRows = new MR_UInt8[mXRes * lRowCount];
+
+		for(int lColumn = 0; lColumn < mXRes; lColumn++) {
+			int lRow;
+			MR_Int32 lSrcIndex_1024 = MR_BACK_Y_RES * 1024 / 9;
+			MR_Int32 lSrcInc_1024 = mBackgroundConst[lColumn].mLineIncrement_1024;
+
+			for(lRow = pStartingLine; lRow >= 0; lRow--) {
+				mBackgroundRows[lRow * mXRes + lColumn] = static_cast<MR_UInt8>((lSrcIndex_1024 / 1024) > (MR_BACK_Y_RES - 1) ? (MR_BACK_Y_RES - 1) : (lSrcIndex_1024 / 1024));
+				lSrcIndex_1024 += lSrcInc_1024;
+			}
+
+			lSrcIndex_1024 = (MR_BACK_Y_RES * 1024 / 9) - lSrcInc_1024;
+
+			for(lRow = pStartingLine + 1; lRow < pBottomLine; lRow++) {
+				mBackgroundRows[lRow * mXRes + lColumn] = static_cast<MR_UInt8>((lSrcIndex_1024 / 1024) < 0 ? 0 : (lSrcIndex_1024 / 1024));
+				lSrcIndex_1024 -= lSrcInc_1024;
+			}
+		}
+
+		mBackgroundStartingLine = pStartingLine;
+		mBackgroundBottomLine = pBottomLine;
+	}
+}
+
 }  // namespace VideoServices
 }  // namespace HoverRace